@@ -19,6 +19,8 @@
 #include "debuglog.h"
 #include "debugmsg.h"
 
+#include "utilities/stringinterner.h"
+
 using VecChar = std::vector<char>;
 using VecStr  = std::vector<std::string>;
 using ID      = std::unordered_map<std::string, int>;
@@ -34,7 +36,7 @@ extern int memory;                      // not used; for setting memory allocati
 extern int fixedkey[257];               // AA installation key
 
 // update patcher
-extern std::unordered_map<std::wstring, std::wstring> behaviorPath; // hkx file name, file path
+extern std::unordered_map<nemesis::InternedKey, std::wstring> behaviorPath; // hkx file name, file path
 
 // behavior generator
 extern std::unordered_map<std::string, bool>
@@ -43,13 +45,14 @@ extern std::unordered_map<std::wstring, std::wstring>
     behaviorProjectPath; // project, project's path; project that has been installed
 extern std::unordered_map<std::string, VecStr>
     behaviorJoints; // lower lvl behavior file, higher lvl behavior file
-extern std::unordered_map<std::string, VecStr>
+extern std::unordered_map<nemesis::InternedKey, VecStr>
     behaviorProject; // character hkx file name, list of project hkx file name; link the project
-extern std::unordered_map<std::string, std::set<std::string>>
+extern std::unordered_map<nemesis::InternedKey, std::set<std::string>>
     usedAnim; // behavior name, animation path; animation used in behavior file
-extern std::unordered_map<std::string, std::set<std::string>>
+extern std::unordered_map<nemesis::InternedKey, std::set<std::string>>
     registeredAnim; // characters hkx file name, animation name, bool; is registered in that behavior file?
-extern std::unordered_map<std::string, std::unordered_map<std::string, std::vector<std::set<std::string>>>>
+extern std::unordered_map<nemesis::InternedKey,
+                          std::unordered_map<nemesis::InternedKey, std::vector<std::set<std::string>>>>
     animModMatch; // characters hkx file name, animation file, animation paths & mod name; match conflicting mod (duplicated anim file)
 
 // Alternate Animation data
@@ -61,7 +64,7 @@ extern std::unordered_map<std::string, VecStr>
 extern std::unordered_map<std::string, VecStr> AAEvent; // AA animation, list of animEvent
 extern std::unordered_map<std::string, VecStr>
     AAHasEvent; // original animation name, AA with event; which original animation associated with AA has new event name?
-extern std::unordered_map<std::string, std::string> AAGroup; // AA file name, animation group name
+extern std::unordered_map<nemesis::InternedKey, std::string> AAGroup; // AA file name, animation group name
 extern std::unordered_map<std::string, std::unordered_map<std::string, int>>
     AAGroupCount; // AA prefix, animation group name, count; animation group picked count
 extern std::set<std::string> groupNameList; // list of animation group name; for scripting
@@ -12,6 +12,26 @@ extern bool gcfg_debug_output_to_stdio;  // enable output of debug info to stdio
 typedef std::vector<std::string> VecStr;
 typedef std::vector<std::wstring> VecWstr;
 
+// lowest level compiled in, DEBUG_LOG calls below it are removed together with their arguments
+#ifndef DEBUG_LOG_LEVEL
+#define DEBUG_LOG_LEVEL 0
+#endif
+
+enum class LogLevel
+{
+    trace,
+    debug,
+    info
+};
+
+#define DEBUG_LOG(level, ...)                                                                                \
+    do                                                                                                       \
+    {                                                                                                        \
+        if constexpr (static_cast<int>(LogLevel::level) >= DEBUG_LOG_LEVEL) DebugLogging(__VA_ARGS__);       \
+    } while (false)
+
+// lines are queued and written to the log file by a background thread
+// DebugOutput blocks until every line queued so far is on disk
 void DebugOutput();
 void DebugLogging(std::string line, bool noEndLine = true);
 void DebugLogging(std::wstring line, bool noEndLine = true);
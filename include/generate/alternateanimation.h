@@ -2,6 +2,8 @@
 #define ALTERNATEANIMATION_H_
 
 #include <filesystem>
+#include <string>
+#include <string_view>
 
 class NemesisInfo;
 
@@ -10,7 +12,7 @@ extern std::unordered_map<std::string, int> AAgroup_Counter;
 void AAInitialize(std::string AAList);
 bool AAInstallation(const NemesisInfo* nemesisInfo);
 
-unsigned int CRC32Convert(std::string line);
-unsigned int CRC32Convert(std::wstring line);
+unsigned int CRC32Convert(std::string_view line);
+unsigned int CRC32Convert(const std::wstring& line);
 
 #endif
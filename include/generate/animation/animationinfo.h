@@ -34,6 +34,7 @@ struct AnimationInfo
     std::unordered_map<std::string, int> optionPickedCount;
     std::unordered_map<std::string, std::unordered_map<std::string, VecStr>> groupAddition;
     std::unordered_map<int, VecStr> AnimObject;
+    std::shared_ptr<nemesis::OptionIndex> optionIndex = std::make_shared<nemesis::OptionIndex>();
 
     AnimationInfo()
     {}
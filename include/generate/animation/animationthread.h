@@ -10,6 +10,11 @@ typedef std::unordered_map<std::string, int> ID;
 
 class NewAnimation;
 
+namespace nemesis
+{
+    class NodeIDJournal;
+}
+
 struct single;
 struct group;
 struct master;
@@ -31,16 +36,15 @@ public:
     bool core, ignoreGroup, hasGroup;
     bool skip = false;
     bool& isCoreDone;
+    nemesis::NodeIDJournal* idJournal = nullptr;
     std::shared_ptr<NewAnimation> dummyAnimation;
-    std::unordered_map<int, int>& functionState;
     ImportContainer& exportID;
-    ID &eventid, variableid;
+    ID &eventid, &variableid;
     NewAnimLock& atomicLock;
     std::vector<int> stateID, stateMultiplier;
     std::shared_ptr<single> singleFunctionIDs;
     std::shared_ptr<group> subFunctionIDs;
     std::shared_ptr<master> groupFunctionIDs;
-    std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo;
     std::shared_ptr<VecStr> allEditLines;
 
     NewAnimArgs(std::string n_modID,
@@ -50,7 +54,6 @@ public:
                 std::shared_ptr<NewAnimation> n_newAnimation,
                 std::shared_ptr<VecStr> n_allEditLines,
                 bool& n_isCoreDone,
-                std::unordered_map<int, int>& n_functionState,
                 ImportContainer& n_exportID,
                 ID& n_eventid,
                 ID& n_variableid,
@@ -63,15 +66,12 @@ public:
                 std::shared_ptr<single> n_singleFunctionIDs,
                 std::shared_ptr<group> n_subFunctionIDs,
                 std::shared_ptr<master> n_groupFunctionIDs,
-                bool n_ignoreGroup,
-                std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& n_groupAnimInfo)
+                bool n_ignoreGroup)
         : isCoreDone(n_isCoreDone)
-        , functionState(n_functionState)
         , exportID(n_exportID)
         , eventid(n_eventid)
         , variableid(n_variableid)
         , atomicLock(n_atomicLock)
-        , groupAnimInfo(n_groupAnimInfo)
     {
         allEditLines      = n_allEditLines;
         modID             = n_modID;
@@ -96,10 +96,11 @@ struct newGroupArgs
 public:
     std::string templateCode, lowerBehaviorFile, ZeroEvent, ZeroVariable, filename;
     int* lastID, groupCount;
+    nemesis::NodeIDJournal* idJournal = nullptr;
     std::vector<int> stateID;
     std::shared_ptr<GroupTemplate> groupTemp;
     ImportContainer& exportID;
-    ID &eventid, variableid;
+    ID &eventid, &variableid;
     NewAnimLock& atomicLock;
     std::shared_ptr<master> groupFunctionIDs;
     std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo;
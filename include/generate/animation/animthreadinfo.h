@@ -2,6 +2,7 @@
 
 #include "Global.h"
 
+#include "generate/animation/optionset.h"
 #include "generate/animation/templateprocessing.h"
 
 using SSMap = std::unordered_map<std::string, std::string>;
@@ -9,6 +10,11 @@ using ImportContainer = std::unordered_map<std::string, SSMap>;
 
 class NewAnimation;
 
+namespace nemesis
+{
+    class NodeIDJournal;
+}
+
 struct group;
 struct NewAnimLock;
 struct GroupTemplate;
@@ -60,8 +66,8 @@ struct AnimThreadInfo
     size_t& elementLine;
     size_t stateCount = 0;
 
-    ID& eventid;
-    ID& variableid;
+    const ID& eventid;
+    const ID& variableid;
 
     std::vector<int>& fixedStateID;
     std::vector<int>& stateCountMultiplier;
@@ -77,11 +83,17 @@ struct AnimThreadInfo
     NewAnimation* curAnim;
     GroupTemplate* curGroup;
 
+    nemesis::NodeIDJournal* idJournal = nullptr;
+
     std::shared_ptr<group> groupFunction;
     std::shared_ptr<master> masterFunction;
 
     std::shared_ptr<VecStr> generatedlines;
 
+    // groupOptionPicked and masterOptionPicked as bitsets, built by the owner of the option maps
+    const std::vector<nemesis::OptionSet>& groupOptionBits;
+    const std::vector<std::vector<nemesis::OptionSet>>& masterOptionBits;
+
     AnimThreadInfo(const std::string& _filepath,
                    const std::string& _filename,
                    const std::string& _mainAnimEvent,
@@ -98,8 +110,8 @@ struct AnimThreadInfo
                    int& _counter,
                    size_t& _elementLine,
                    int _furnitureCount,
-                   ID& _eventid,
-                   ID& _variableid,
+                   const ID& _eventid,
+                   const ID& _variableid,
                    std::vector<int>& _fixedStateID,
                    std::vector<int>& _stateCountMultiplier,
                    int _order,
@@ -111,8 +123,20 @@ struct AnimThreadInfo
                    const std::unordered_map<std::string, std::unordered_map<std::string, VecStr>>& _groupAddition,
                    const std::vector<std::unordered_map<std::string, bool>>& _groupOptionPicked,
                    const std::vector<std::vector<std::unordered_map<std::string, bool>>>& _masterOptionPicked,
+                   const std::vector<nemesis::OptionSet>& _groupOptionBits,
+                   const std::vector<std::vector<nemesis::OptionSet>>& _masterOptionBits,
                    std::shared_ptr<group> _groupFunction,
                    std::shared_ptr<VecStr> _generatedlines,
                    NewAnimation* _curAnim,
                    NewAnimLock* _animLock);
+
+    const nemesis::OptionSet& groupOptionSet(size_t animMulti) const
+    {
+        return groupOptionBits[animMulti];
+    }
+
+    const nemesis::OptionSet& masterOptionSet(size_t groupMulti, size_t animMulti) const
+    {
+        return masterOptionBits[groupMulti][animMulti];
+    }
 };
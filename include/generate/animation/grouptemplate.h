@@ -24,8 +24,9 @@ struct master;
 
 struct JointTemplate
 {
-    ID eventid;
-    ID variableid;
+    // maps of the behavior being generated, only valid while its function lines are being built
+    const ID* eventid    = nullptr;
+    const ID* variableid = nullptr;
 
     std::string zeroEvent;
     std::string zeroVariable;
@@ -34,8 +35,8 @@ struct JointTemplate
                             std::string filename,
                             std::string masterFormat,
                             int linecount,
-                            ID eventid,
-                            ID variableid,
+                            const ID& eventid,
+                            const ID& variableid,
                             int groupMulti          = -1,
                             int optionMulti         = -1,
                             int animMulti           = -1,
@@ -46,8 +47,8 @@ struct JointTemplate
                             std::string filename,
                             int curFunctionID,
                             int linecount,
-                            ID eventid,
-                            ID variableid,
+                            const ID& eventid,
+                            const ID& variableid,
                             int groupMulti,
                             int optionMulti         = -1,
                             int animMulti           = -1,
@@ -63,21 +64,12 @@ private:
     ImportContainer* newImport;
     std::string filename, format;
     int* nextFunctionID;
+    nemesis::NodeIDJournal* idJournal = nullptr;
     SSMap IDExist;
     std::shared_ptr<master> subFunctionIDs;
     std::shared_ptr<AnimTemplate> grouptemplate;
     proc* process;
 
-    void OutputGroupBackup(std::shared_ptr<VecStr> functionline,
-                           std::string format,
-                           std::string masterFormat,
-                           std::string behaviorFile,
-                           int groupCount,
-                           VecStr templatelines,
-                           std::unordered_map<int, bool>& IsConditionOpened,
-                           std::vector<std::vector<std::unordered_map<std::string, bool>>> masterOptionPicked,
-                           std::vector<int> fixedStateID);
-
 public:
     std::vector<std::vector<std::shared_ptr<AnimationInfo>>> groupAnimInfo;
 
@@ -87,11 +79,11 @@ public:
                           std::string formatname,
                           std::vector<int>& stateID,
                           std::shared_ptr<master> newSubFunctionIDs,
-                          std::vector<std::vector<std::shared_ptr<AnimationInfo>>> newGroupAnimInfo,
+                          const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& newGroupAnimInfo,
                           int* nFunctionID,
                           ImportContainer& import,
-                          ID eventid,
-                          ID variableID,
+                          const ID& eventid,
+                          const ID& variableID,
                           std::string masterFormat,
                           NewAnimLock& atomicLock,
                           int groupCount = 0);
@@ -106,13 +98,14 @@ public:
                     std::string filename,
                     std::string masterFormat,
                     int linecount,
-                    ID eventid,
-                    ID variableid,
+                    const ID& eventid,
+                    const ID& variableid,
                     int groupMulti          = -1,
                     int optionMulti         = -1,
                     int animMulti           = -1,
                     std::string multiOption = "");
     std::string newID();
+    void setIDJournal(nemesis::NodeIDJournal* journal);
     void setZeroEvent(std::string eventname);
     void setZeroVariable(std::string variablename);
 };
@@ -134,11 +127,11 @@ public:
     groupExistingFunctionProcess(int curFunctionID,
                                  VecStr existingFunctionLines,
                                  std::shared_ptr<master> newSubFunctionIDs,
-                                 std::vector<std::vector<std::shared_ptr<AnimationInfo>>> newGroupAnimInfo,
+                                 const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& newGroupAnimInfo,
                                  std::string format,
                                  ImportContainer& import,
-                                 ID newEventID,
-                                 ID newVariableID,
+                                 const ID& newEventID,
+                                 const ID& newVariableID,
                                  int& nFunctionID,
                                  bool hasMaster,
                                  bool hasGroup,
@@ -149,8 +142,8 @@ public:
                     std::string filename,
                     int curFunctionID,
                     int linecount,
-                    ID eventid,
-                    ID variableid,
+                    const ID& eventid,
+                    const ID& variableid,
                     int groupMulti,
                     int optionMulti         = -1,
                     int animMulti           = -1,
@@ -165,7 +158,7 @@ VecStr GetOptionInfo(std::string line,
                      std::string format,
                      std::string filename,
                      int numline,
-                     std::vector<std::vector<std::shared_ptr<AnimationInfo>>> groupAnimInfo,
+                     const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo,
                      bool allowNoFixAnim,
                      bool isCondition,
                      int groupMulti          = -1,
@@ -177,7 +170,7 @@ void nonGroupOptionInfo(VecStr& optionInfo,
                         std::string format,
                         std::string filename,
                         int numline,
-                        std::vector<std::vector<std::shared_ptr<AnimationInfo>>> groupAnimInfo,
+                        const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo,
                         bool allowNoFixAnim,
                         bool isCondition,
                         int groupMulti,
@@ -189,7 +182,7 @@ void optionLimiter(VecStr optionInfo,
                    std::string format,
                    std::string filename,
                    int numline,
-                   std::vector<std::vector<std::shared_ptr<AnimationInfo>>> groupAnimInfo,
+                   const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo,
                    int open,
                    bool isCondition,
                    int curGroup,
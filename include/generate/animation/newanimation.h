@@ -17,6 +17,7 @@
 #include "generate/AnimationUtility.h"
 
 #include "generate/animation/animthreadinfo.h"
+#include "generate/animation/nodeidledger.h"
 #include "generate/animation/animationthread.h"
 #include "generate/animation/registeranimation.h"
 #include "generate/animation/singletemplate.h"
@@ -58,6 +59,7 @@ private:
     SSMap mixOptRegis;
     ImportContainer* newImport;
     NewAnimLock* atomicLock;
+    nemesis::NodeIDJournal* idJournal = nullptr;
     ImportContainer addition;
 
     bool isLastOrder  = false;
@@ -74,21 +76,22 @@ private:
     double duration = 0;
 
     const std::vector<std::unordered_map<std::string, bool>> groupOptionPicked;
+    std::vector<nemesis::OptionSet> groupOptionBits; // groupOptionPicked as bitsets
     std::unordered_map<int, VecStr> AnimObject;
     std::unordered_map<std::string, bool> optionPicked;
     std::unordered_map<std::string, int> optionPickedCount;
     std::unordered_map<std::string, VecStr> addOn;
     std::unordered_map<std::string, VecStr> linkedOption;
     std::unordered_map<std::string, VecStr> mixOptRever;
-    std::unordered_map<std::string, VecStr> rawtemplate;
+    std::shared_ptr<const std::unordered_map<std::string, VecStr>> rawtemplate;
     //std::unordered_map<std::string, std::map<std::string, VecStr, alphanum_less>> asdlines;
     //std::unordered_map<std::string, std::unordered_map<std::string, VecStr>> animdatalines;
     std::unordered_map<std::string, std::unordered_map<std::string, VecStr>> groupAddition;
     std::vector<std::shared_ptr<AnimationInfo>> groupAnimInfo;
 
     std::shared_ptr<std::unordered_map<std::string, AnimTemplate>> animtemplate;
-    std::unordered_map<std::string, std::unordered_map<std::string, AnimTemplate>> animdatatemplate;
-    std::unordered_map<std::string, std::map<std::string, AnimTemplate, alphanum_less>> asdtemplate;
+    std::shared_ptr<std::unordered_map<std::string, std::unordered_map<std::string, AnimTemplate>>> animdatatemplate;
+    std::shared_ptr<std::unordered_map<std::string, std::map<std::string, AnimTemplate, alphanum_less>>> asdtemplate;
 
 public:
     std::shared_ptr<single> subFunctionIDs;
@@ -149,11 +152,6 @@ private:
                     bool hasGroup,
                     int optionMulti = -1,
                     int animMulti   = -1);
-    void AnimDataLineProcess(VecStr originallines,
-                             VecStr& newlines,
-                             std::string format,
-                             std::vector<int> ASD = {0});
-
     void AnimDataLineProcess(AnimTemplate* originaltemplate,
                              std::shared_ptr<VecStr> newlines,
                              std::string format,
@@ -200,7 +198,7 @@ private:
 public:
     NewAnimation(std::shared_ptr<std::unordered_map<std::string, AnimTemplate>> animlines,
                  std::string formatname,
-                 std::unordered_map<std::string, VecStr> furnituretemplate,
+                 std::shared_ptr<const std::unordered_map<std::string, VecStr>> furnituretemplate,
                  int furniturecount,
                  std::string filepath,
                  AnimationInfo& behaviorOption);
@@ -216,6 +214,9 @@ public:
 
     std::string newID();
 
+    // replace the placeholders a journal left in the IDs this animation keeps for its next behavior file
+    void resolveIDs(const nemesis::NodeIDLedger& ledger);
+
     void GetNewAnimationLine(std::shared_ptr<NewAnimArgs> args);
     void GetAnimSetData(
         std::unordered_map<std::string, std::map<std::string, VecStr, alphanum_less>>& newASDLines);
@@ -223,11 +224,13 @@ public:
     void existingASDProcess(VecStr ASDLines, std::map<int, VecStr>& extract, std::vector<int> ASD = {0});
 
     //void addAnimData(std::unordered_map<std::string, std::unordered_map<std::string, VecStr>> animdata);
-    void addAnimData(std::unordered_map<std::string, std::unordered_map<std::string, AnimTemplate>> animdata);
+    void addAnimData(
+        std::shared_ptr<std::unordered_map<std::string, std::unordered_map<std::string, AnimTemplate>>> animdata);
 
     //void addAnimSetData(std::unordered_map<std::string, std::map<std::string, VecStr, alphanum_less>> animsetdata);
     void addAnimSetData(
-        std::unordered_map<std::string, std::map<std::string, AnimTemplate, alphanum_less>> animsetdata);
+        std::shared_ptr<std::unordered_map<std::string, std::map<std::string, AnimTemplate, alphanum_less>>>
+            animsetdata);
 
     void storeAnimObject(VecStr animobjects, std::string listFilename, int lineCount);
     void addGroupAnimInfo(std::vector<std::shared_ptr<AnimationInfo>> animInfo);
@@ -0,0 +1,75 @@
+#ifndef NODEIDLEDGER_H_
+#define NODEIDLEDGER_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+typedef std::vector<std::string> VecStr;
+typedef std::unordered_map<std::string, std::string> SSMap;
+typedef std::unordered_map<std::string, SSMap> ImportContainer;
+
+struct master;
+
+namespace nemesis
+{
+    class NodeIDLedger;
+
+    // node IDs requested by one template job, kept in the order the job asked for them
+    class NodeIDJournal
+    {
+        friend class NodeIDLedger;
+
+        NodeIDLedger* ledger;
+        std::vector<size_t> touched;
+
+        NodeIDJournal(NodeIDLedger* _ledger);
+
+    public:
+        // placeholder ID, replaced by the real node ID once the ledger is resolved
+        std::string newID();
+
+        // record the use of an ID that another job of the same batch may have handed out
+        void touch(const std::string& strID);
+    };
+
+    // Node IDs of a batch of template jobs that may run in any order or concurrently.
+    // Jobs only hand out placeholders. Once the batch is joined, placeholders are numbered in job order
+    // so the output is the same as running every job one after another on a single thread
+    class NodeIDLedger
+    {
+        friend class NodeIDJournal;
+
+        std::atomic<size_t> counter = 0;
+        std::vector<std::unique_ptr<NodeIDJournal>> journals;
+        VecStr resolved;
+
+        std::string placeholder(size_t index) const;
+
+    public:
+        static constexpr char mark = '\x1F';
+
+        // Hand out lastID as a node ID and move on to the next one. Every node ID of a behavior file
+        // is numbered here, either by resolve or, outside of a batch, straight by the caller
+        static std::string take(int& lastID);
+
+        // nodeID as it is written in a behavior file, without handing it out
+        static std::string toID(int nodeID);
+
+        // must be called in job order, before the jobs are dispatched
+        NodeIDJournal* addJob();
+
+        // assign the real node IDs, continuing from lastID
+        void resolve(int& lastID);
+
+        void patch(std::string& line) const;
+        void patch(VecStr& lines) const;
+        void patch(master& functionIDs) const;
+        void patch(SSMap& IDExist) const;
+        void patch(ImportContainer& exportID) const;
+    };
+}
+
+#endif
@@ -46,8 +46,8 @@ struct NodePackedParameters
     std::shared_ptr<master> subFunctionIDs;
     ImportContainer& import;
     int linecount;
-    ID eventid;
-    ID variableid;
+    const ID& eventid;
+    const ID& variableid;
     std::string zeroEvent;
     std::string zeroVariable;
     int groupMulti;
@@ -72,8 +72,8 @@ struct NodePackedParameters
                          std::shared_ptr<master> _subFunctionIDs,
                          ImportContainer& _import,
                          int _linecount,
-                         ID _eventid,
-                         ID _variableid,
+                         const ID& _eventid,
+                         const ID& _variableid,
                          std::string _zeroEvent,
                          std::string _zeroVariable,
                          int _groupMulti,
@@ -142,8 +142,8 @@ struct NodeJoint
                     std::string& strID,
                     SSMap& IDExist,
                     ImportContainer& import,
-                    ID eventid,
-                    ID variableid,
+                    const ID& eventid,
+                    const ID& variableid,
                     std::string zeroEvent,
                     std::string zeroVariable,
                     unsigned __int64& openRange,
@@ -171,8 +171,8 @@ struct NodeJoint
                         std::string& strID,
                         SSMap& IDExist,
                         ImportContainer& import,
-                        ID eventid,
-                        ID variableid,
+                        const ID& eventid,
+                        const ID& variableid,
                         std::string zeroEvent,
                         std::string zeroVariable,
                         unsigned __int64 openRange,
@@ -194,8 +194,8 @@ struct NodeJoint
                                 std::string& strID,
                                 SSMap& IDExist,
                                 ImportContainer& import,
-                                ID eventid,
-                                ID variableid,
+                                const ID& eventid,
+                                const ID& variableid,
                                 std::string zeroEvent,
                                 std::string zeroVariable,
                                 unsigned __int64 openRange,
@@ -1,10 +1,13 @@
 #ifndef OPTIONLIST_H_
 #define OPTIONLIST_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "generate/animation/optionset.h"
+
 typedef std::vector<std::string> VecStr;
 
 struct OptionList
@@ -48,6 +51,9 @@ struct OptionList
     std::vector<VecStr> eleVarGroupL;
     VecStr eleVarGroupLLine;
 
+    // bit numbers of the option names tested by conditions of this template code, shared by every copy
+    std::shared_ptr<nemesis::OptionIndex> optionIndex = std::make_shared<nemesis::OptionIndex>();
+
     OptionList(std::string filepath, std::string format);
     OptionList();
     void setDebug(bool isDebug);
@@ -0,0 +1,49 @@
+#ifndef OPTIONSET_H_
+#define OPTIONSET_H_
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nemesis
+{
+    // Option names of one template code. Every distinct name gets a small, dense bit number, which
+    // stays valid for the life of the index. Names are case sensitive, as in the option maps
+    class OptionIndex
+    {
+        std::shared_mutex mutex;
+
+        // names are never removed, so the views in the index stay valid
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, uint32_t> index;
+
+    public:
+        uint32_t bit(std::string_view name);
+    };
+
+    // options picked by an animation, one bit per option index entry
+    class OptionSet
+    {
+        std::vector<uint64_t> words;
+
+    public:
+        OptionSet() = default;
+
+        // every key of picked is set, whatever its value, same as find() on the map
+        OptionSet(const std::unordered_map<std::string, bool>& picked, OptionIndex& index);
+
+        void set(uint32_t bit);
+
+        bool test(uint32_t bit) const
+        {
+            size_t word = bit >> 6;
+            return word < words.size() && (words[word] >> (bit & 63) & 1) != 0;
+        }
+    };
+}
+
+#endif
@@ -45,7 +45,7 @@ public:
            const std::string& filepath,
            int stateID);
     bool HasError();
-    VecStr GetPairedLine(int id, AOConvert AnimObjectNames, ID eventid, const ID& variableid);
+    VecStr GetPairedLine(int id, AOConvert AnimObjectNames, const ID& eventid, const ID& variableid);
     AOConvert GetAnimObjectName();
     VecStr GetEventID();
     VecStr GetVariableID();
@@ -23,6 +23,7 @@ public:
     std::string modID;
     std::string version;
     std::filesystem::path behaviorFile;
+    uint64_t contentHash = 0; // hash of the animation list file
     std::unordered_map<std::string, var> AnimVar;
     std::unordered_map<std::string, int> templateType;
     std::unordered_map<std::string, std::vector<int>> last;
@@ -0,0 +1,28 @@
+#ifndef TEMPLATEBUNDLE_H_
+#define TEMPLATEBUNDLE_H_
+
+#include <cstdint>
+#include <filesystem>
+
+struct TemplateInfo;
+
+namespace nemesis
+{
+    // relative path, size and write time of every entry under the template folder, no file is opened
+    uint64_t template_fingerprint(const std::filesystem::path& directory);
+
+    // state of this run the option lists are checked against while they are parsed: the behavior files known
+    // from the update and the debug setting. folded into seed
+    uint64_t option_check_fingerprint(uint64_t seed);
+
+    // Parsed behavior templates of the last run that walked the template folder.
+    // The bundle is only taken while it was written by this version with the same fingerprint
+    bool load_template_bundle(TemplateInfo& info,
+                              uint64_t fingerprint,
+                              const std::filesystem::path& filename = "cache\\template_bundle");
+    void save_template_bundle(const TemplateInfo& info,
+                              uint64_t fingerprint,
+                              const std::filesystem::path& filename = "cache\\template_bundle");
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <map>
 #include <unordered_set>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "utilities/alphanum.hpp"
 #include "generate/animation/optionlist.h"
@@ -32,6 +34,8 @@ struct TemplateInfo
         coreTemplate; // animation code, core behavior; animation code that uses core behavior
     std::unordered_map<std::string, std::string>
         coreBehaviorCode; // core behavior, proxy animation code; get the proxy animation code using the file name
+    std::vector<std::pair<std::string, std::string>>
+        coreJoints; // animation code, behavior; core behavior takes the joints of the behavior, in template order
 
     // AnimData
     std::unordered_map<std::string,
@@ -45,6 +49,10 @@ struct TemplateInfo
         existingAnimDataHeader; // animation code, character, list of header; header from the master branch that is/are used in the generation of animation
 
     TemplateInfo();
+
+private:
+    void ReadTemplates();
+    void JoinCore(const std::string& code, const std::string& behavior);
 };
 
 #endif
@@ -76,7 +76,48 @@ struct MasterAnimSetData
 extern void
 combineExtraction(VecStr& storeline, std::map<int, VecStr> extract, std::string project, std::string header);
 
-ASDFormat::position ASDPosition(VecStr animData,
+// Position every line of one header gets as the target line, found in one forward walk over the header
+struct ASDLineTrace
+{
+    std::vector<int> type;        // -1 until the walk leaves the line, -2 if the walk found no position
+    std::vector<bool> afterError; // the walk had hit a format error before it left the line
+    int errorLine = 0;            // line reported by the first format error, -1 for the target line
+    bool failed   = false;
+
+    ASDLineTrace(size_t size = 0);
+
+    void leave(int line, double curType);
+    void fail(int line);
+    void finish(int curType);
+};
+
+// Position of lines in one animationsetdata header. The condition markers and the line positions are each
+// built in a single pass on the first request and reused by every later one, so animData must not change
+// while this is in use
+class ASDLinePosition
+{
+    const VecStr& animData;
+    std::string project;
+    std::string header;
+    std::string modcode;
+
+    bool built        = false;
+    bool traced       = false;
+    int functionstart = -1;
+    std::unordered_map<int, ASDFunct> marker;
+    ASDLineTrace trace;
+
+    void buildMarker();
+    void buildTrace();
+    ASDFormat::position search(int linecount, bool muteError);
+
+public:
+    ASDLinePosition(const VecStr& _animData, std::string _project, std::string _header, std::string _modcode);
+
+    ASDFormat::position at(int linecount, bool muteError);
+};
+
+ASDFormat::position ASDPosition(const VecStr& animData,
                                 std::string character,
                                 std::string header,
                                 std::string modcode,
@@ -87,11 +128,12 @@ ASDFormat::position ASDConvert(int position, bool muteError);
 int PositionLineCondition(int& i,
                           double curID,
                           int linecount,
-                          VecStr animDataSet,
+                          const VecStr& animDataSet,
                           std::unordered_map<int, ASDFunct>& marker,
                           std::string modcode,
                           std::string header,
                           bool last,
-                          bool muteError);
+                          bool muteError,
+                          ASDLineTrace* trace = nullptr);
 
 #endif
\ No newline at end of file
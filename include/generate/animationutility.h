@@ -16,8 +16,9 @@ typedef std::unordered_map<std::string, int> ID;
 
 struct AnimationUtility
 {
-    ID eventid;
-    ID variableid;
+    // owned by the caller, utilities are copied freely so they only point at the maps
+    const ID* eventid;
+    const ID* variableid;
     std::vector<int> fixedStateID;
     std::vector<int> stateCountMultiplier;
     bool hasGroup   = false;
@@ -30,11 +31,10 @@ struct AnimationUtility
     std::shared_ptr<NodePackedParameters> nodeProcess;
     bool isExisting = false;
 
-    AnimationUtility()
-    {}
+    AnimationUtility();
     AnimationUtility(std::string condition,
-                     ID eventid,
-                     ID variableid,
+                     const ID& eventid,
+                     const ID& variableid,
                      std::vector<int> stateID,
                      std::vector<int> stateCountMultiplier,
                      bool hasGroup,
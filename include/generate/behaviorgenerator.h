@@ -1,8 +1,14 @@
 #ifndef BEHAVIORGENERATOR_H_
 #define BEHAVIORGENERATOR_H_
 
-#include <string>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "Global.h"
 
@@ -32,4 +38,43 @@ private:
     std::string xmlDecompile(fpath hkxfile, fpath xmlfile, const HkxCompileCount& hkxcount) const;
 };
 
-#endif
\ No newline at end of file
+// Conversion stage of the behavior generation. Generators hand over their finished xml and carry on
+// while a fixed number of converter threads run hkxcmd. Threads are started with the first conversion
+class HkxConversionQueue
+{
+    using fpath = std::filesystem::path;
+
+    struct Job
+    {
+        fpath xmlfile;
+        fpath hkxfile;
+        std::function<void(bool)> done; // called on the converter thread with the result of hkxcmdProcess
+    };
+
+    const HkxCompiler& compiler;
+    size_t threadCount;
+    std::vector<std::thread> converters;
+    std::deque<Job> jobs;
+    std::mutex jobMutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    size_t running = 0;
+    bool stopping  = false;
+
+    void run();
+
+public:
+    // 0 converter threads means one per core
+    HkxConversionQueue(const HkxCompiler& _compiler, size_t _threadCount = 0);
+    ~HkxConversionQueue();
+
+    void push(fpath xmlfile, fpath hkxfile, std::function<void(bool)> done);
+
+    // block until every conversion pushed so far has finished and its callback returned
+    void wait();
+
+    // wait and stop the converter threads, the next push starts them again
+    void stop();
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include "ui/ProgressUp.h"
 
 #include "generate/behaviorgenerator.h"
+#include "generate/generationcache.h"
 
 typedef std::unordered_set<std::string> USetStr;
 typedef std::unordered_set<std::wstring> USetWstr;
@@ -89,13 +90,22 @@ private:
     // timer
     std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
 
+    void hashGenerationInputs(const TemplateInfo* BehaviorTemplate,
+                              const std::vector<std::unique_ptr<registerAnimation>>& animationList);
+
 public:
     std::atomic_flag postBehaviorFlag{};
     std::unordered_map<std::wstring, USetWstr> postBhvrRefBy;
 
+    // outputs of the last run that can be reused
+    nemesis::GenerationCache generationCache;
+
     // nemesis ini
     const NemesisInfo* nemesisInfo;
     const HkxCompiler hkxCompiler = HkxCompiler();
+
+    // conversion stage of the running generation, null outside of it
+    HkxConversionQueue* hkxConversion = nullptr;
 };
 
 #endif
@@ -2,6 +2,7 @@
 #define BEHAVIORSUBPROCESS_H_
 
 #include <memory>
+#include <string_view>
 
 #include <QtCore/QObject>
 
@@ -15,6 +16,23 @@ struct var;
 class NemesisInfo;
 struct TemplateInfo;
 
+// progress of one behavior, in the order the full generation reaches them
+// the progress bar counts every step once for each behavior, whichever path it takes
+enum class BehaviorStep
+{
+    Start,
+    Extracted,
+    Catalyst,
+    Imported,
+    Animations,
+    Extensions,
+    Exported,
+    Prepared,
+    Written,
+    Compiled,
+    Count
+};
+
 class BehaviorSub : public QObject
 {
     Q_OBJECT
@@ -52,6 +70,9 @@ public:
 
     bool isCharacter;
 
+    // milestones reported for every behavior file
+    static constexpr int milestoneCount = int(BehaviorStep::Count);
+
 public slots:
     void BehaviorCompilation();
     void AnimDataCompilation();
@@ -78,6 +99,9 @@ private:
     const NemesisInfo* nemesisInfo;
 
     void (BehaviorSub::*tryAddAnim)() = &BehaviorSub::checkAnimation;
+
+    // hash of everything the generated behavior depends on, content is the temp behavior file
+    uint64_t generationKey(const std::string& lowerBehaviorFile, std::string_view content) const;
 };
 
 #endif
@@ -0,0 +1,63 @@
+#ifndef GENERATIONCACHE_H_
+#define GENERATIONCACHE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+typedef std::vector<std::string> VecStr;
+
+namespace nemesis
+{
+    constexpr uint64_t hash_seed = 14695981039346656037ull;
+
+    // FNV-1a over 8-byte words, the length is mixed in first so consecutive calls cannot collide by
+    // shifting bytes from one piece to the next
+    uint64_t hash_content(std::string_view data, uint64_t seed = hash_seed);
+    uint64_t hash_content(uint64_t value, uint64_t seed);
+
+    // every regular file under the directory, in path order
+    uint64_t hash_directory(const std::filesystem::path& directory, uint64_t seed = hash_seed);
+
+    // 0 when the file cannot be read
+    uint64_t hash_file(const std::filesystem::path& filepath);
+
+    // Hash of the generation inputs of each output behavior from the last successful run.
+    // An output is only reused when its key matches and the hkx on disk is still the one that was written.
+    // Lines that the clip/animation data tracking needs are kept with the entry and replayed on reuse
+    class GenerationCache
+    {
+        struct Entry
+        {
+            uint64_t key;
+            uint64_t output;
+            VecStr replay;
+        };
+
+        std::filesystem::path filename;
+        std::unordered_map<std::wstring, Entry> entries;
+        std::unordered_map<std::string, uint64_t> inputs;
+        mutable std::mutex entryMutex;
+
+    public:
+        GenerationCache(std::filesystem::path _filename = "cache\\generation");
+
+        void load();
+        void save() const;
+
+        // inputs shared by many outputs, hashed once per run before the behaviors are dispatched
+        void setInput(const std::string& name, uint64_t hash);
+        uint64_t getInput(const std::string& name) const;
+
+        // output is the hkx path without extension
+        bool find(const std::wstring& output, uint64_t key, VecStr& replay) const;
+        void update(const std::wstring& output, uint64_t key, VecStr replay);
+        void erase(const std::wstring& output);
+    };
+}
+
+#endif
@@ -24,7 +24,7 @@ bool isEdited(TemplateInfo* BehaviorTemplate,
 bool newAnimSkip(std::vector<std::shared_ptr<NewAnimation>> newAnim, std::string modID);
 void checkBehaviorJoint(std::filesystem::path filename,
                         std::filesystem::path projectdir,
-                        std::string& line,
+                        std::string_view line,
                         BehaviorStart* process,
                         bool& isBehavior);
 bool GetStateCount(
@@ -52,12 +52,15 @@ std::vector<std::unique_ptr<registerAnimation>> openFile(TemplateInfo* behaviort
                                                          const NemesisInfo* nemesisInfo);
 void checkClipAnimData(std::filesystem::path filename,
                        std::filesystem::path projectdir,
-                       std::string& line,
+                       std::string_view line,
                        VecStr& characterFiles,
                        std::string& clipName,
                        bool& isClip,
                        BehaviorStart* process,
                        bool& isBehavior);
+
+// lines that can change the state of checkClipAnimData, the rest are ignored by it
+bool isClipAnimDataLine(std::string_view line);
 void checkAllFiles(std::filesystem::path filepath);
 void checkAllStoredHKX();
 
@@ -20,6 +20,7 @@ class NemesisInfo
     uint modNameWidth  = 380;
     uint authorWidth   = 75;
     uint priorityWidth = 47;
+    uint hkxConverters = 0;
 
     void setup();
 
@@ -41,6 +42,9 @@ public:
     const uint& GetAuthorWidth() const;
     const uint& GetPriorityWidth() const;
 
+    // number of hkxcmd conversions run at once, 0 means one per core
+    const uint& GetHkxConverters() const;
+
     void setFirst(bool _first);
     void setWidth(uint _width);
     void setHeight(uint _height);
@@ -0,0 +1,52 @@
+#ifndef UPDATEINDEX_H_
+#define UPDATEINDEX_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+typedef std::vector<std::string> VecStr;
+
+namespace nemesis
+{
+    // Outputs the last successful update wrote to temp_behaviors, with the hash of what went into each of them.
+    // An output whose inputs hash the same and whose file is still the one that was written is neither merged
+    // nor written again. What the update learns while writing it is kept with the entry and replayed instead
+    class UpdateIndex
+    {
+    public:
+        struct Output
+        {
+            uint64_t key     = 0;
+            uint64_t written = 0;
+            unsigned long long crc = 0;
+            VecStr joints;                     // behaviors referenced by the output, in file order
+            std::vector<std::wstring> sources; // mod files merged into the output
+        };
+
+    private:
+        std::filesystem::path filename;
+        std::unordered_map<std::string, Output> last;
+        std::unordered_map<std::string, Output> current;
+        std::unordered_set<std::string> kept;
+
+    public:
+        UpdateIndex(std::filesystem::path _filename = "cache\\update_index");
+
+        void load();
+        void save() const;
+
+        // output is the lower case file name in temp_behaviors without extension
+        bool keep(const std::string& output, const std::filesystem::path& filepath, uint64_t key);
+        bool isKept(const std::string& output) const;
+        const Output* find(const std::string& output) const;
+
+        void update(const std::string& output, const std::filesystem::path& filepath, Output entry);
+        void setSources(const std::string& output, std::vector<std::wstring> sources);
+    };
+}
+
+#endif
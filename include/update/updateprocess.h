@@ -5,6 +5,8 @@
 
 #include "ui/ProgressUp.h"
 
+#include "update/updateindex.h"
+
 #include "update/animdata/animdatacond.h"
 
 #include "generate/behaviortype.h"
@@ -79,8 +81,11 @@ public:
                    const std::string& node,
                    const std::string& behavior,
                    std::unordered_map<std::string, std::shared_ptr<arguPack>>& pack);
+    void IndexOutputs(const std::string& directory);
     void JoiningEdits(std::string directory);
     void CombiningFiles();
+    void IndexSources();
+    void RemoveStaleOutputs(const std::wstring& compilingfolder);
     void unregisterProcess();
 
 public slots:
@@ -148,6 +153,10 @@ private:
         modFileList; // modcode, behavior, node files
     std::atomic_flag fileCountLock{};
 
+    nemesis::UpdateIndex updateIndex;
+    std::unordered_map<std::string, uint64_t> vanillaHash; // output, content hash of its vanilla file
+    std::unordered_map<std::string, uint64_t> outputKey;   // output, hash of everything merged into it
+
     // global container locker
 #if MULTITHREADED_UPDATE
     std::atomic_flag behaviorPathLock       {};
@@ -0,0 +1,35 @@
+#ifndef VANILLASNAPSHOT_H_
+#define VANILLASNAPSHOT_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utilities/alphanum.hpp"
+
+namespace nemesis
+{
+    typedef std::map<std::string, std::vector<std::string>, alphanum_less> VanillaNodes;
+    typedef std::map<std::string, std::unordered_map<std::string, bool>> VanillaChildState;
+    typedef std::unordered_map<std::string, std::string> VanillaIDMap;
+
+    // Result of VanillaDisassemble on a vanilla behavior, kept under cache\vanilla_snapshot as a string pool
+    // and a node table. It is only taken while the xml still hashes the same. Nothing is filled on a miss
+    bool load_vanilla_snapshot(const std::filesystem::path& behaviorFile,
+                               uint64_t fileHash,
+                               VanillaNodes& nodes,
+                               VanillaChildState& childrenState,
+                               VanillaIDMap& stateID,
+                               VanillaIDMap& parent);
+    void save_vanilla_snapshot(const std::filesystem::path& behaviorFile,
+                               uint64_t fileHash,
+                               const VanillaNodes& nodes,
+                               const VanillaChildState& childrenState,
+                               const VanillaIDMap& stateID,
+                               const VanillaIDMap& parent);
+}
+
+#endif
@@ -36,9 +36,28 @@ namespace nemesis
             const Condt&, const AnimThreadInfo&, const AddOnInfo&, const std::string&, int, int&, int&);
 
 	private:
+		// selector of an option condition, parsed once so evaluation does not compare strings
+		enum class Pick
+		{
+			All,
+			Order,
+			First,
+			Next,
+			Back,
+			Last,
+			Number,
+			Other
+		};
+
 		int hiddenOrder;
 		bool last = false;
 
+		Pick groupPick = Pick::All;
+		Pick animPick  = Pick::All;
+		int groupNum   = 0;
+		int animNum    = 0;
+		uint32_t optionBit = 0;
+
 		const proc* prcs;
 		std::string fmt;
 		std::string bhvfile;
@@ -98,6 +117,8 @@ namespace nemesis
                          int& groupMulti);
 
 	private:
+        static Pick parsePick(const std::string& selector, int& number);
+
         bool specialIsTrueA(AnimThreadInfo& animthrinfo);
         bool specialIsTrueB(AnimThreadInfo& animthrinfo);
 
@@ -105,7 +126,7 @@ namespace nemesis
 			OptionList& optionlist);
 		void singleCondition(std::string condition, std::string format, std::string behaviorFile, std::string multiOption, int numline, bool isGroup, bool isMaster,
 			OptionList& optionlist);
-		void conditionProcess(std::string condition, std::string format, std::string behaviorFile, std::string multiOption, int numline, bool isGroup, bool isMaster);
+		void conditionProcess(std::string condition, std::string format, std::string behaviorFile, std::string multiOption, int numline, bool isGroup, bool isMaster, OptionList& optionlist);
 	};
 
 	struct MultiChoice
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 
 using uint = unsigned int;
 
@@ -12,27 +14,37 @@ namespace nemesis
         CRC32();
         ~CRC32();
 
-        bool FileCRC(const char* sFileName, uint* iOutCRC);
-        bool FileCRC(const char* sFileName, uint* iOutCRC, size_t iBufferSize);
-        uint FileCRC(const char* sFileName);
-        uint FileCRC(const char* sFileName, size_t iBufferSize);
+        // tables are built once and shared, every member is safe to call from several threads
+        static const CRC32& instance();
 
-        void FullCRC(const unsigned char* sData, size_t iLength, uint* iOutCRC);
-        void FullCRC(const char* sData, size_t iLength, uint* iOutCRC);
-        void FullCRC(const std::string& sData, uint* iOutCRC);
-        uint FullCRC(const unsigned char* sData, size_t iDataLength);
-        uint FullCRC(const char* sData, size_t iDataLength);
-        uint FullCRC(const std::string& sData);
+        bool FileCRC(const char* sFileName, uint* iOutCRC) const;
+        bool FileCRC(const char* sFileName, uint* iOutCRC, size_t iBufferSize) const;
+        uint FileCRC(const char* sFileName) const;
+        uint FileCRC(const char* sFileName, size_t iBufferSize) const;
 
-        void PartialCRC(uint* iCRC, const unsigned char* sData, size_t iDataLength);
+        void FullCRC(const unsigned char* sData, size_t iLength, uint* iOutCRC) const;
+        void FullCRC(const char* sData, size_t iLength, uint* iOutCRC) const;
+        void FullCRC(std::string_view sData, uint* iOutCRC) const;
+        uint FullCRC(const unsigned char* sData, size_t iDataLength) const;
+        uint FullCRC(const char* sData, size_t iDataLength) const;
+        uint FullCRC(std::string_view sData) const;
+
+        void PartialCRC(uint* iCRC, const unsigned char* sData, size_t iDataLength) const;
+        void PartialCRC(uint* iCRC, std::string_view sData) const;
 
     private:
-        uint Reflect(uint iReflect, const char cChar);
+        using Table = std::array<std::array<uint, 256>, 8>;
+
+        static uint Reflect(uint iReflect, const char cChar);
+        static Table BuildTable(uint iPolynomial);
 
         //0x04C11DB7 is the official polynomial used by PKZip, WinZip and Ethernet.
-        uint iPolynomial = 0x04C11DB7;
-        uint initial     = 0;
-        uint finalxor    = 0;
-        uint iTable[256];
+        const uint iPolynomial = 0x04C11DB7;
+        const uint initial     = 0;
+        const uint finalxor    = 0;
+
+        // iTable[0] is the classic byte table, iTable[k] advances a byte through k more zero bytes
+        // so eight bytes can be folded in per step (slicing-by-8)
+        const Table iTable;
     };
-}
\ No newline at end of file
+}
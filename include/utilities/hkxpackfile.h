@@ -0,0 +1,95 @@
+#ifndef HKXPACKFILE_H_
+#define HKXPACKFILE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nemesis
+{
+    struct HkxSkeleton
+    {
+        std::string name;
+        int bones; // parentIndices count
+    };
+
+    // What Nemesis needs to know about a binary hkx without decompiling it
+    struct HkxFacts
+    {
+        // false when the file is missing or is not a little endian packfile, every other field is then empty
+        bool packfile = false;
+
+        uint8_t pointerSize = 0; // 4 for LE, 8 for SSE
+        int fileVersion     = 0;
+        std::string contentsVersion;
+        std::string rootClass;
+
+        // every hkaSkeleton, in the order they are stored
+        std::vector<HkxSkeleton> skeletons;
+
+        // nullptr when the file has no skeleton of that name
+        const HkxSkeleton* findSkeleton(std::string_view name) const;
+    };
+
+    // Reader of the packfile header, the section table and the virtual fixups, which give the class of
+    // every object in the data section. Object members are only read where the layout is fixed
+    class HkxPackfile
+    {
+        struct Section
+        {
+            std::string tag;
+            uint32_t start;
+            uint32_t localFixups;
+            uint32_t globalFixups;
+            uint32_t virtualFixups;
+            uint32_t exports;
+            uint32_t imports;
+            uint32_t end;
+        };
+
+        struct Object
+        {
+            uint32_t offset; // from the start of the section
+            std::string_view classname;
+        };
+
+        struct Fixup
+        {
+            uint32_t source; // pointer location, from the start of the section
+            uint32_t target; // pointed data, in the same section
+        };
+
+        std::string_view data;
+        std::vector<Section> sections;
+        std::vector<std::vector<Object>> objects; // per section, sorted by offset
+        std::vector<std::vector<Fixup>> localFixups; // per section, sorted by source
+        HkxFacts facts;
+
+        bool readHeader();
+        bool readSections(size_t tableStart);
+        bool readObjects();
+        bool readLocalFixups();
+        void readSkeletons();
+
+        bool readInt(size_t pos, int32_t& value) const;
+        std::string_view readName(size_t pos) const;
+        std::string_view readPointedName(size_t section, uint32_t source) const;
+
+    public:
+        // data must outlive the reader
+        HkxPackfile(std::string_view _data);
+
+        const HkxFacts& getFacts() const;
+    };
+
+    // facts of hkxfile, kept per path, size and last write time for the life of the process
+    std::shared_ptr<const HkxFacts> hkx_facts(const std::filesystem::path& hkxfile);
+
+    // drops the facts kept so far, for after a scan that only needed them once
+    void clear_hkx_facts();
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef LINEARENA_H_
+#define LINEARENA_H_
+
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace nemesis
+{
+    // Bump allocator for lines that are written once and read until the owner is done with them.
+    // Lines are never freed on their own, the whole arena is released at once
+    class LineArena
+    {
+        static constexpr size_t blockSize = 256 * 1024;
+
+        std::vector<std::unique_ptr<char[]>> blocks;
+        std::vector<std::unique_ptr<char[]>> large;
+        char* cur   = nullptr;
+        size_t left = 0;
+        size_t used = 0;
+
+        char* allocate(size_t length);
+
+    public:
+        LineArena() = default;
+        LineArena(const LineArena&) = delete;
+        LineArena& operator=(const LineArena&) = delete;
+
+        std::string_view store(std::string_view line);
+        std::string_view concat(std::initializer_list<std::string_view> pieces);
+
+        size_t bytes() const;
+        size_t blockCount() const;
+        void clear();
+    };
+
+    // list of lines whose text lives in a LineArena
+    class ArenaLines
+    {
+        LineArena& arena;
+        std::vector<std::string_view> lines;
+
+    public:
+        using const_iterator = std::vector<std::string_view>::const_iterator;
+
+        ArenaLines(LineArena& _arena);
+
+        void push_back(std::string_view line);
+        void push_back(std::initializer_list<std::string_view> pieces);
+
+        template <class Iterator>
+        void append(Iterator first, Iterator last)
+        {
+            for (; first != last; ++first)
+            {
+                push_back(std::string_view(*first));
+            }
+        }
+
+        // other must use the same arena
+        void append(const ArenaLines& other);
+
+        void reserve(size_t count);
+        void clear();
+
+        std::string_view back() const;
+        size_t size() const;
+        bool empty() const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+    };
+}
+
+#endif
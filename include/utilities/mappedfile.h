@@ -0,0 +1,52 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace nemesis
+{
+    // read-only view over the whole content of a file
+    // the file is mapped into memory where the platform allows it, otherwise it is read into a private buffer
+    class MappedFile
+    {
+        const char* data = nullptr;
+        size_t length    = 0;
+        bool opened      = false;
+        std::string buffer;
+
+#ifdef _WIN32
+        void* fileHandle    = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        bool mapped = false;
+#endif
+
+        bool map(const std::filesystem::path& filepath);
+        bool read(const std::filesystem::path& filepath);
+
+    public:
+        MappedFile() = default;
+        MappedFile(const std::filesystem::path& filepath);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::filesystem::path& filepath);
+        void close();
+
+        bool is_open() const;
+        std::string_view view() const;
+    };
+
+    // number of lines in buffer, a last line without line feed included
+    size_t line_count(std::string_view buffer);
+
+    // cut the next line out of buffer, line feed and trailing carriage returns excluded
+    // return false once buffer is exhausted
+    bool next_line(std::string_view& buffer, std::string_view& line);
+}
+
+#endif
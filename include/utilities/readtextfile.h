@@ -1,110 +1,78 @@
 #ifndef READTEXTFILE_H_
 #define READTEXTFILE_H_
 
-#include <QtCore\QFile.h>
 #include <filesystem>
+#include <string>
+#include <string_view>
 
+#include "utilities/algorithm.h"
+#include "utilities/mappedfile.h"
+
+// line reader over the mapped file, lines are split at line feed with trailing carriage returns removed
 struct FileReader
 {
-    QFile file;
+    std::filesystem::path filepath;
+    nemesis::MappedFile file;
+    std::string_view remaining;
 
     FileReader(const char* filename)
+        : filepath(filename)
     {
-        file.setFileName(QString::fromStdString(filename));
     }
 
     FileReader(std::filesystem::path filename)
+        : filepath(std::move(filename))
     {
-        file.setFileName(QString::fromStdWString(filename.wstring()));
     }
 
     std::filesystem::path GetFilePath() const
     {
-        return std::filesystem::path(file.fileName().toStdWString());
+        return filepath;
     }
 
     bool GetFile()
     {
-        return file.open(QIODevice::ReadOnly);
-    }
-
-    bool GetLines(std::string& line)
-    {
-        while (!file.atEnd())
-        {
-            QString qline = file.readLine();
-            line          = qline.toStdString();
+        if (!file.open(filepath)) return false;
 
-            while (line.length() > 0 && (line.back() == '\n' || line.back() == '\r'))
-            {
-                line.pop_back();
-            }
+        remaining = file.view();
 
-            return true;
-        }
+        // UTF-8 byte order mark is not part of the first line
+        if (remaining.substr(0, 3) == "\xEF\xBB\xBF") remaining.remove_prefix(3);
 
-        return false;
+        return true;
     }
 
-    // disable std::string_view& line version
-    // clangd issues warning that templine pointer is backed by object that will be soon destroyed.
-    // gcc is silent so maybe it extends life of object?
-    
-    // bool GetLines(std::string_view& line)
-    // {
-    //     while (!file.atEnd())
-    //     {
-    //         QString qline        = file.readLine();
-    //         const char* templine = qline.toStdString().c_str();
-    //         line                 = std::string_view(templine);
-
-    //         while (line.length() > 0 && (line.back() == '\n' || line.back() == '\r'))
-    //         {
-    //             line = std::string_view(templine, line.length() - 1);
-    //         }
-
-    //         return true;
-    //     }
-
-    //     return false;
-    // }
+    // number of lines left to read
+    size_t LineCount() const
+    {
+        return nemesis::line_count(remaining);
+    }
 
-    bool GetLines(std::wstring& line)
+    // line stays valid as long as the reader is alive
+    bool GetLines(std::string_view& line)
     {
-        while (!file.atEnd())
-        {
-            QString qline = file.readLine();
-            line          = qline.toStdWString();
+        return nemesis::next_line(remaining, line);
+    }
 
-            while (line.length() > 0 && (line.back() == '\n' || line.back() == '\r'))
-            {
-                line.pop_back();
-            }
+    bool GetLines(std::string& line)
+    {
+        std::string_view view;
 
-            return true;
-        }
+        if (!nemesis::next_line(remaining, view)) return false;
 
-        return false;
+        line.assign(view.data(), view.length());
+        return true;
     }
 
-    // bool GetLines(std::wstring_view& line)
-    // {
-    //     while (!file.atEnd())
-    //     {
-    //         QString qline           = file.readLine();
-    //         const wchar_t* templine = qline.toStdWString().c_str();
-    //         line                    = std::wstring_view(templine);
-
-    //         while (line.length() > 0 && (line.back() == '\n' || line.back() == '\r'))
-    //         {
-    //             line = std::wstring_view(templine, line.length() - 1);
-    //         }
+    bool GetLines(std::wstring& line)
+    {
+        std::string_view view;
 
-    //         return true;
-    //     }
+        if (!nemesis::next_line(remaining, view)) return false;
 
-    //     return false;
-    // }
+        line = nemesis::transform_to<std::wstring>(std::string(view));
+        return true;
+    }
 };
 
 #endif
@@ -2,6 +2,7 @@
 
 #include <boost/regex.hpp>
 #include <optional>
+#include <string_view>
 
 #include "Global.h"
 
@@ -80,6 +81,74 @@ namespace nemesis
 
     std::string regex_replace(const std::string& line, const nemesis::regex& rgx, const std::string& replace);
 
+    // =====================================================//
+    //                 PRECOMPILED PATTERNS                 //
+    // =====================================================//
+
+    // Constant patterns matched on every line of template, behavior and node files.
+    // Each is compiled once on first use and shared by every thread, matching only reads the compiled state
+#define NEMESIS_PRECOMPILED_PATTERNS(X)                                                                        \
+    X(leading_tabs, "^([\t]+).*$")                                                                             \
+    X(tab_text, "[\t]+([^\t]+).*")                                                                             \
+    X(tab_comment, "[^\t]+([\t]+<!-- [^ ]+ -->).*")                                                            \
+    X(middle_word, "[^ ]+[ ]([^ ]+)[ ][^ ]+")                                                                  \
+    X(first_word, "[^A-Za-z\\s]*([A-Za-z\\s]+).*")                                                             \
+    X(first_token, "[<\\s]*([^<\\s]+).*")                                                                      \
+    X(first_decimal, "[^0-9]*([0-9]+(\\.([0-9]+)?)?).*")                                                       \
+    X(decimal, "([0-9]+(\\.[0-9]+)?)")                                                                         \
+    X(mod_edit_only, "^[\t]+<!-- \\*([\\w]+)\\* -->")                                                          \
+    X(hkobject_header, "<hkobject name=\"#(.*)\" class=\"([a-zA-Z]+)\" signature=\".*\">")                     \
+    X(hkparam_numelements, "<hkparam name=\"(.+?)\" numelements=\"(.+?)\">")                                   \
+    X(hkparam_numelements_open, "<hkparam name=\"(.+?)\" numelements=\"")                                      \
+    X(hkparam_numelements_value, "(.*<hkparam name\\=\".+\" numelements\\=\").+(\">.*)")                       \
+    X(hkparam_relative_to_end, "<hkparam name\\=\"relativeToEndOfClip\">(.+?)<\\/hkparam>")                    \
+    X(hkparam_local_time, "<hkparam name\\=\"localTime\">(.+?)<\\/hkparam>")                                   \
+    X(hkparam_animation_name, "<hkparam name\\=\"animationName\">(.+?)<\\/hkparam>")                           \
+    X(hkparam_behavior_name, "<hkparam name\\=\"behaviorName\">(.+?)<\\/hkparam>")                             \
+    X(template_state_id, ".*<hkparam name=\"stateId\">[$]\\(S([0-9]*)(.*)\\)[$]</hkparam>.*")                  \
+    X(event_id_tag, ".*[$](eventID[[].*[]])[$].*")                                                             \
+    X(variable_id_tag, ".*[$](variableID[[].*[]])[$].*")                                                       \
+    X(state_id_tag, ".*[$](stateID[[].*[]][[][0-9]+[]][[].*[]][[][0-9]+[]])[$].*")                             \
+    X(state_id_parts, ".*[$]stateID[[](.*)[]][[]([0-9]+)[]][[].*[]][[][0-9]+[]][$].*")                         \
+    X(event_id_name, ".*eventID[[](.*?)[]].*")                                                                 \
+    X(variable_id_name, ".*variableID[[](.*)[]].*")                                                            \
+    X(condition_start, ".*<!-- CONDITION START \\^(.+?)\\^ -->.*")                                             \
+    X(condition, ".*<!-- CONDITION \\^(.+?)\\^ -->.*")                                                         \
+    X(condition_order, "\\^([A-Za-z]+)\\^")                                                                    \
+    X(foreach_or_new, ".*<!-- (?:FOREACH|NEW) \\^(.+?)\\^ -->.*")                                              \
+    X(new_order, ".*<!-- NEW ORDER (.+?) -->.*")                                                               \
+    X(comment, "[\\s]+<!-- (.+?) -->[\\s]*?")                                                                  \
+    X(main_anim_event, "(\\{main_anim_event\\})")                                                              \
+    X(last_state, "LastState([0-9]*)")                                                                         \
+    X(mc, "\\$MC\\$")                                                                                          \
+    X(mid, "MID\\$([0-9]+)")                                                                                   \
+    X(anim_data_id, "[a-zA-Z]+[$]([0-9]+)")
+
+    enum class pattern
+    {
+#define NEMESIS_PATTERN_NAME(name, str) name,
+        NEMESIS_PRECOMPILED_PATTERNS(NEMESIS_PATTERN_NAME)
+#undef NEMESIS_PATTERN_NAME
+        count
+    };
+
+    const nemesis::regex& precompiled(pattern name);
+
+    // =====================================================//
+    //                    DIGIT SCANNERS                    //
+    // =====================================================//
+
+    // digits of the first number in line, or line itself when it has no digit
+    // same result as regex_replace(line, nemesis::regex("[^0-9]*([0-9]+).*"), "\\1")
+    std::string first_number(const std::string& line);
+
+    // digits found right after the last prefix that is followed by digits and suffix
+    // same result as ".*<prefix>([0-9]+)<suffix>.*", number is left untouched when there is no match
+    bool number_between(const std::string& line,
+                        std::string_view prefix,
+                        std::string_view suffix,
+                        std::string& number);
+
     // =====================================================//
     //                    WIDE CHARACTERS                   //
     // =====================================================//
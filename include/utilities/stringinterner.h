@@ -0,0 +1,85 @@
+#ifndef STRINGINTERNER_H_
+#define STRINGINTERNER_H_
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace nemesis
+{
+    // Process wide table of case folded names. Every distinct name gets a small id, which stays valid
+    // along with its text for the life of the process. Narrow and wide spellings of a name share the id
+    namespace interner
+    {
+        uint32_t intern(std::string_view name);
+        uint32_t intern(std::wstring_view name);
+
+        // id of name if it has been interned already, nothing is added when it has not
+        bool find(std::string_view name, uint32_t& id);
+        bool find(std::wstring_view name, uint32_t& id);
+
+        // folded text of id
+        const std::string& name(uint32_t id);
+        const std::wstring& wname(uint32_t id);
+
+        size_t size();
+    }
+
+    // Key of the global file tables. Lookups fold and intern the name, then hash and compare the id only
+    class InternedKey
+    {
+        uint32_t id;
+
+        InternedKey() = default;
+
+    public:
+        InternedKey(const char* name);
+        InternedKey(const wchar_t* name);
+        InternedKey(const std::string& name);
+        InternedKey(const std::wstring& name);
+        InternedKey(std::string_view name);
+        InternedKey(std::wstring_view name);
+
+        // key of name without interning it, empty when no table can have it as a key
+        static std::optional<InternedKey> lookup(std::string_view name);
+        static std::optional<InternedKey> lookup(std::wstring_view name);
+
+        uint32_t getID() const;
+        const std::string& str() const;
+        const std::wstring& wstr() const;
+
+        bool operator==(const InternedKey& other) const;
+        bool operator!=(const InternedKey& other) const;
+        bool operator<(const InternedKey& other) const; // by folded text
+    };
+
+    // table.find and table.count for a name that may not be a key, probing does not intern the name
+    template <class Table, class Name>
+    auto find_key(Table& table, const Name& name) -> decltype(table.end())
+    {
+        auto key = InternedKey::lookup(name);
+        return key ? table.find(*key) : table.end();
+    }
+
+    template <class Table, class Name>
+    size_t count_key(const Table& table, const Name& name)
+    {
+        return find_key(table, name) != table.end() ? 1 : 0;
+    }
+}
+
+namespace std
+{
+    template <>
+    struct hash<nemesis::InternedKey>
+    {
+        size_t operator()(const nemesis::InternedKey& key) const noexcept
+        {
+            return hash<uint32_t>()(key.getID());
+        }
+    };
+}
+
+#endif
@@ -1,69 +1,229 @@
 #ifndef THREAD_POOL_H_
 #define THREAD_POOL_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <functional>
-#include <future>
 #include <memory>
 #include <mutex>
-#include <stdexcept>
+#include <new>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <queue>
 
 namespace nemesis
 {
     using uint = unsigned int;
 
-    class ThreadPool
+    // move-only callable, small captures are stored inline without touching the heap
+    class Task
     {
+        static constexpr size_t inlineSize = 6 * sizeof(void*);
+
+        struct Ops
+        {
+            void (*call)(void* storage);
+            void (*move)(void* dst, void* src);
+            void (*destroy)(void* storage);
+        };
+
+        template <class F>
+        static constexpr bool isInline = sizeof(F) <= inlineSize
+                                         && alignof(F) <= alignof(std::max_align_t)
+                                         && std::is_nothrow_move_constructible_v<F>;
+
+        template <class F>
+        static const Ops* getOps()
+        {
+            if constexpr (isInline<F>)
+            {
+                static const Ops ops = {
+                    [](void* storage) { (*static_cast<F*>(storage))(); },
+                    [](void* dst, void* src) {
+                        new (dst) F(std::move(*static_cast<F*>(src)));
+                        static_cast<F*>(src)->~F();
+                    },
+                    [](void* storage) { static_cast<F*>(storage)->~F(); }};
+                return &ops;
+            }
+            else
+            {
+                static const Ops ops = {
+                    [](void* storage) { (**static_cast<F**>(storage))(); },
+                    [](void* dst, void* src) { *static_cast<F**>(dst) = *static_cast<F**>(src); },
+                    [](void* storage) { delete *static_cast<F**>(storage); }};
+                return &ops;
+            }
+        }
+
+        alignas(std::max_align_t) unsigned char storage[inlineSize];
+        const Ops* ops = nullptr;
+
     public:
-        ThreadPool(uint threads = std::thread::hardware_concurrency());
+        Task() = default;
 
-        template <class F, class... Args>
-        decltype(auto) enqueue(F&& f, Args&&... args);
+        template <class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& func)
+        {
+            using Func = std::decay_t<F>;
+
+            if constexpr (isInline<Func>)
+            {
+                new (storage) Func(std::forward<F>(func));
+            }
+            else
+            {
+                *reinterpret_cast<Func**>(storage) = new Func(std::forward<F>(func));
+            }
+
+            ops = getOps<Func>();
+        }
 
-        void join_all();
-        void stop();
+        Task(Task&& other) noexcept
+        {
+            if (!other.ops) return;
 
-        ~ThreadPool();
+            other.ops->move(storage, other.storage);
+            ops       = other.ops;
+            other.ops = nullptr;
+        }
 
-    private:
-        std::vector<std::thread> workers;
-        std::queue<std::function<void()>> tasks;
-        void newWorker();
-
-        std::condition_variable condition;
-        std::mutex queue_mutex;
-        bool abort = false;
-        bool sync = false;
-        bool error = false;
-    };
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this == &other) return *this;
 
-    // add new work item to the pool
-    template <class F, class... Args>
-    decltype(auto) ThreadPool::enqueue(F&& f, Args&&... args)
-    {
-        using return_type = std::invoke_result_t<F, Args...>;
+            reset();
+
+            if (other.ops)
+            {
+                other.ops->move(storage, other.storage);
+                ops       = other.ops;
+                other.ops = nullptr;
+            }
 
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+            return *this;
+        }
 
-        std::future<return_type> res = task->get_future();
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
 
+        ~Task()
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+            reset();
+        }
 
-            if (error) return res;
+        void reset()
+        {
+            if (!ops) return;
+
+            ops->destroy(storage);
+            ops = nullptr;
+        }
 
-            // don't allow enqueueing after stopping the pool
-            if (abort) throw std::runtime_error("enqueue on stopped ThreadPool");
+        void operator()()
+        {
+            ops->call(storage);
+        }
 
-            tasks.emplace([task]() { (*task)(); });
+        explicit operator bool() const
+        {
+            return ops != nullptr;
         }
+    };
 
-        condition.notify_one();
-        return res;
+    class TaskGroup;
+
+    // Process-wide pool of workers. Every worker owns a deque: it pushes and pops its own tasks at the back,
+    // idle workers steal from the front of the others. Threads that are not workers hand their tasks over
+    // through a shared queue.
+    // A thread waiting on a group keeps running the queued tasks of that group, so tasks can spawn and wait
+    // on nested groups without tying up a thread each, and without picking up unrelated work that would
+    // keep the waiter busy long after its group is done
+    class TaskScheduler
+    {
+        struct Job
+        {
+            Task task;
+            TaskGroup* group;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex lock;
+            std::deque<Job> jobs;
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> queues; // one per worker, the last one is shared
+        std::vector<std::thread> workers;
+        size_t workerCount;
+
+        std::mutex sleepMutex;
+        std::condition_variable wake; // idle workers, signaled when a task is queued
+        std::condition_variable done; // threads in wait_for, signaled when a group is done or gets a new task
+        std::atomic<size_t> queued = 0;
+        bool stopping              = false;
+
+        TaskScheduler(uint threads);
+
+        bool runOne(size_t self, const TaskGroup* only);
+        bool take(size_t index, bool back, const TaskGroup* only, Job& job);
+        void execute(Job& job);
+        void workerLoop(size_t index);
+
+    public:
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        static TaskScheduler& get();
+
+        void spawn(TaskGroup& group, Task task);
+
+        // block until every task of the group, including tasks it spawned into the group, is done
+        // first exception thrown by a task of the group is rethrown here
+        void wait_for(TaskGroup& group);
+
+        size_t size() const;
+    };
+
+    // set of tasks that can be waited on as a whole
+    // unlike the old thread pool, queued tasks are never dropped and the group can be waited on repeatedly
+    class TaskGroup
+    {
+        friend class TaskScheduler;
+
+        std::atomic<size_t> pending = 0;
+        std::atomic<size_t> queued  = 0; // tasks of the group still sitting in a queue
+        std::mutex failureMutex;
+        std::exception_ptr failure;
+
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        ~TaskGroup();
+
+        template <class F, class... Args>
+        void run(F&& f, Args&&... args);
+
+        void wait();
+    };
+
+    template <class F, class... Args>
+    void TaskGroup::run(F&& f, Args&&... args)
+    {
+        TaskScheduler::get().spawn(
+            *this,
+            Task([func = std::forward<F>(f), params = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+                std::apply(func, params);
+            }));
     }
 }
 
@@ -7,6 +7,7 @@
 #include <istream>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "utilities/atomiclock.h"
 #include "debuglog.h"
@@ -27,6 +28,9 @@ public:
 
     bool is_open() const;
 
+    // flush and release the file before the writer goes out of scope
+    void close();
+
     void LockFreeWrite(const char* line);
     void LockFreeWrite(const wchar_t* line);
     void LockFreeWrite(const std::string& line);
@@ -58,4 +62,29 @@ public:
     }
 };
 
+// Buffered writer that keeps the CRC32 of everything passed through it, so the text does not have to be
+// collected in memory to be checksummed. The buffer is written out once it is full and on destruction
+class CRCWriter
+{
+private:
+    FileWriter& writer;
+    std::string buffer;
+    size_t capacity;
+    unsigned int crc = 0;
+
+public:
+    CRCWriter(FileWriter& _writer, size_t _capacity = 1048576);
+    ~CRCWriter();
+
+    // checksum and write
+    CRCWriter& operator<<(std::string_view input);
+
+    // checksum only
+    void Checksum(std::string_view input);
+
+    void Flush();
+
+    unsigned int GetCRC() const;
+};
+
 #endif
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <filesystem>
 
 #include "Global.h"
@@ -21,18 +22,18 @@ int fixedkey[257];
 
 chrono::steady_clock::time_point time1;
 
-unordered_map<wstring, wstring> behaviorPath;
+unordered_map<nemesis::InternedKey, wstring> behaviorPath;
 
 unordered_map<string, bool> activatedBehavior;
 unordered_map<wstring, wstring> behaviorProjectPath;
 unordered_map<string, VecStr> behaviorJoints;
-unordered_map<string, VecStr> behaviorProject;
-unordered_map<string, set<string>> usedAnim;
-unordered_map<string, set<string>> registeredAnim;
+unordered_map<nemesis::InternedKey, VecStr> behaviorProject;
+unordered_map<nemesis::InternedKey, set<string>> usedAnim;
+unordered_map<nemesis::InternedKey, set<string>> registeredAnim;
 unordered_map<string, unordered_map<string, VecStr>> animList;
-unordered_map<string, unordered_map<string, vector<set<string>>>> animModMatch;
+unordered_map<nemesis::InternedKey, unordered_map<nemesis::InternedKey, vector<set<string>>>> animModMatch;
 
-unordered_map<string, string> AAGroup;
+unordered_map<nemesis::InternedKey, string> AAGroup;
 unordered_map<string, VecStr> AAEvent;
 unordered_map<string, VecStr> AAHasEvent;
 unordered_map<string, VecStr> groupAA;
@@ -55,14 +56,12 @@ void read_directory(const sf::path& name, VecStr& fv)
 		}
 	}
 
-	for (unsigned int i = 0; i < fv.size(); ++i)
-	{
-		if (nemesis::to_lower_copy(fv[i]).find("folder_managed_by_vortex") != NOT_FOUND)
-		{
-			fv.erase(fv.begin() + i);
-			--i;
-		}
-	}
+	fv.erase(remove_if(fv.begin(),
+	                   fv.end(),
+	                   [](const string& filename) {
+		                   return nemesis::to_lower_copy(filename).find("folder_managed_by_vortex") != NOT_FOUND;
+	                   }),
+	         fv.end());
 }
 
 void read_directory(const sf::path& name, vector<wstring>& fv)
@@ -79,60 +78,30 @@ void read_directory(const sf::path& name, vector<wstring>& fv)
 		}
 	}
 
-	for (unsigned int i = 0; i < fv.size(); ++i)
-	{
-		if (nemesis::to_lower_copy(fv[i]).find(L"folder_managed_by_vortex") != NOT_FOUND)
-		{
-			fv.erase(fv.begin() + i);
-			--i;
-		}
-	}
+	fv.erase(remove_if(fv.begin(),
+	                   fv.end(),
+	                   [](const wstring& filename) {
+		                   return nemesis::to_lower_copy(filename).find(L"folder_managed_by_vortex") != NOT_FOUND;
+	                   }),
+	         fv.end());
 }
 
 size_t fileLineCount(sf::path filepath)
 {
-	int linecount = 0;
-	string line;
-	FileReader input(filepath.c_str());
-
-	if (input.GetFile())
-	{
-		string line;
+	FileReader input(filepath);
 
-		while (input.GetLines(line))
-		{
-			++linecount;
-		}
-	}
-	else
-	{
-		ErrorMessage(1002, filepath);
-	}
+	if (!input.GetFile()) ErrorMessage(1002, filepath);
 
-	return linecount;
+	return input.LineCount();
 }
 
 size_t fileLineCount(const char* filepath)
 {
-	int linecount = 0;
-	string line;
 	FileReader input(filepath);
 
-	if (input.GetFile())
-	{
-		string line;
+	if (!input.GetFile()) ErrorMessage(1002, filepath);
 
-		while (input.GetLines(line))
-		{
-			++linecount;
-		}
-	}
-	else
-	{
-		ErrorMessage(1002, filepath);
-	}
-
-	return linecount;
+	return input.LineCount();
 }
 
 int sameWordCount(string line, string word)
@@ -187,18 +156,18 @@ bool GetFunctionLines(sf::path filename, VecStr& functionlines, bool emptylast)
 
 	if (sf::is_directory(filename)) ErrorMessage(3001, filename.string());
 
-    functionlines.reserve(fileLineCount(filename));
-    FileReader BehaviorFormat(filename.wstring());
+    FileReader BehaviorFormat(filename);
 
     if (!BehaviorFormat.GetFile()) ErrorMessage(3002, filename.string());
 
-    wstring line;
+    functionlines.reserve(BehaviorFormat.LineCount());
+    string_view line;
 
     while (BehaviorFormat.GetLines(line))
     {
         if (error) throw nemesis::exception();
 
-        functionlines.push_back(nemesis::transform_to<string>(line));
+        functionlines.emplace_back(line);
     }
 
 	if (functionlines.size() == 0) return false;
@@ -227,11 +196,11 @@ bool GetFunctionLines(sf::path filename, vector<wstring>& functionlines, bool em
 
 	if (sf::is_directory(filename)) ErrorMessage(3001, filename.string());
 
-    functionlines.reserve(fileLineCount(filename));
-    FileReader BehaviorFormat(filename.wstring());
+    FileReader BehaviorFormat(filename);
 
     if (!BehaviorFormat.GetFile()) ErrorMessage(3002, filename.string());
 
+    functionlines.reserve(BehaviorFormat.LineCount());
     wstring line;
 
     while (BehaviorFormat.GetLines(line))
@@ -307,5 +276,5 @@ bool hasAlpha(const wstring& line)
 void addUsedAnim(string behaviorFile, string animPath)
 {
 	Lockless lock(atomLock);
-	usedAnim[nemesis::to_lower_copy(behaviorFile)].insert(nemesis::to_lower_copy(animPath));
+	usedAnim[behaviorFile].insert(nemesis::to_lower_copy(animPath));
 }
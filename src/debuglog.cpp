@@ -2,11 +2,16 @@
 #include "debuglog.h"
 
 #include "utilities/algorithm.h"
-#include "utilities/atomiclock.h"
 #include <algorithm>
-#include <exception>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
 #include <iostream>
-#include <stdexcept>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 bool gcfg_debug_output_to_stdio = false;
 
@@ -14,108 +19,263 @@ using namespace std;
 
 VecStr updatelog;
 VecStr patchlog;
-std::atomic_flag atomlock{};
-;
-string filename = "CriticalLog.txt";
 
-
-std::string currentTime()
+namespace
 {
-    time_t rawtime;
-    struct tm* timeinfo;
-    char buffer[80];
+    constexpr size_t ringSize              = 4096; // must be a power of two
+    constexpr chrono::milliseconds interval = chrono::milliseconds(100);
 
-    time(&rawtime);
-    timeinfo = localtime(&rawtime);
+    // Multi-producer ring of formatted lines drained by a single writer thread that keeps the log file open.
+    // A producer claims a ticket, waits for its slot to be free in case the ring is full, fills it and
+    // publishes it through the slot sequence. Nothing is dropped
+    class LogWriter
+    {
+        struct Slot
+        {
+            atomic<size_t> sequence;
+            string line;
+        };
 
-    strftime(buffer, sizeof(buffer), "%d-%m-%Y %H:%M:%S", timeinfo);
-    return buffer;
-}
+        unique_ptr<Slot[]> ring;
+        atomic<size_t> head    = 0;
+        atomic<size_t> tail    = 0;
+        atomic<size_t> flushed = 0;
 
-std::wstring currentTimeW()
-{
-    return nemesis::transform_to<wstring>(currentTime());
-}
+        mutex sleepMutex;
+        condition_variable wake;
+        condition_variable done;
+        bool flushWanted = false;
+        bool stopping    = false;
 
-void DebugOutput()
-{
-    //filename.clear();
-}
+        mutex fileMutex;
+        FILE* file      = nullptr;
+        string filename = "CriticalLog.txt";
 
-void DebugLogging(string line, bool noEndLine)
-{
-    int64_t size = count(line.begin(), line.end(), '\n');
+        thread writer;
 
-    if (noEndLine)
-    {
-        for (int64_t i = 0; i < size; ++i)
+        bool ready() const
         {
-            line.replace(line.find("\n"), 1, " | ");
+            size_t pos = tail.load(memory_order_relaxed);
+            return ring[pos & (ringSize - 1)].sequence.load(memory_order_acquire) == pos + 1;
         }
-    }
 
-    try
-    {
-        Lockless_s lock(atomlock);
+        bool drain()
+        {
+            lock_guard<mutex> lock(fileMutex);
+            bool any = false;
 
-        if(gcfg_debug_output_to_stdio)
-            std::cout << "DEBUG:[" + currentTime() + "] " + line << std::endl;
+            while (ready())
+            {
+                size_t pos = tail.load(memory_order_relaxed);
+                Slot& slot = ring[pos & (ringSize - 1)];
 
-        ofstream relog(filename, ios_base::app);
-        relog << "[" + currentTime() + "] " + line + "\n";
-        relog.close();
-    }
-    catch (std::exception &e)
-    {
-        if(gcfg_debug_output_to_stdio)
-            std::cout << "DEBUG: exception generated in DebugLogging!!! log files may be incomplete. Exception: " << e.what() << std::endl;
-        throw(std::runtime_error(e.what()));
-    }
+                if (!file) file = fopen(filename.c_str(), "a");
 
-}
+                if (file) fputs(slot.line.c_str(), file);
 
-void DebugLogging(wstring line, bool noEndLine)
-{
-    int64_t size = count(line.begin(), line.end(), L'\n');
+                if (gcfg_debug_output_to_stdio) cout << "DEBUG:" << slot.line << std::flush;
 
-    if (noEndLine)
-    {
-        for (int64_t i = 0; i < size; ++i)
+                slot.line.clear();
+                slot.sequence.store(pos + ringSize, memory_order_release);
+                tail.store(pos + 1, memory_order_release);
+                any = true;
+            }
+
+            return any;
+        }
+
+        void commit()
         {
-            line.replace(line.find(L"\n"), 1, L" | ");
+            {
+                lock_guard<mutex> lock(fileMutex);
+
+                if (file) fflush(file);
+            }
+
+            {
+                lock_guard<mutex> lock(sleepMutex);
+                flushed.store(tail.load(memory_order_acquire), memory_order_release);
+            }
+
+            done.notify_all();
+        }
+
+        void run()
+        {
+            auto lastFlush = chrono::steady_clock::now();
+            bool dirty     = false;
+
+            while (true)
+            {
+                dirty |= drain();
+
+                bool wanted;
+                bool stop;
+
+                {
+                    unique_lock<mutex> lock(sleepMutex);
+                    wanted      = flushWanted;
+                    stop        = stopping;
+                    flushWanted = false;
+                }
+
+                if (dirty && (wanted || stop || chrono::steady_clock::now() - lastFlush >= interval))
+                {
+                    commit();
+                    lastFlush = chrono::steady_clock::now();
+                    dirty     = false;
+                }
+                else if (wanted)
+                {
+                    commit();
+                }
+
+                if (stop && !ready() && tail.load() == head.load()) return;
+
+                unique_lock<mutex> lock(sleepMutex);
+                wake.wait_for(lock, interval, [&] { return flushWanted || stopping; });
+            }
+        }
+
+    public:
+        LogWriter()
+            : ring(new Slot[ringSize])
+        {
+            for (size_t i = 0; i < ringSize; ++i)
+            {
+                ring[i].sequence.store(i, memory_order_relaxed);
+            }
+
+            writer = thread(&LogWriter::run, this);
         }
-    }
 
-    try
+        ~LogWriter()
+        {
+            {
+                lock_guard<mutex> lock(sleepMutex);
+                stopping = true;
+            }
+
+            wake.notify_one();
+            writer.join();
+
+            if (file) fclose(file);
+        }
+
+        static LogWriter& get()
+        {
+            static LogWriter logger;
+            return logger;
+        }
+
+        void push(string&& line)
+        {
+            size_t pos = head.fetch_add(1, memory_order_relaxed);
+            Slot& slot = ring[pos & (ringSize - 1)];
+
+            // ring is full, hurry the writer along until our slot is free
+            while (slot.sequence.load(memory_order_acquire) != pos)
+            {
+                wake.notify_one();
+                this_thread::yield();
+            }
+
+            slot.line = move(line);
+            slot.sequence.store(pos + 1, memory_order_release);
+
+            if (pos - tail.load(memory_order_relaxed) >= ringSize / 2) wake.notify_one();
+        }
+
+        // wait until every line pushed before the call is written and flushed
+        void flush()
+        {
+            size_t target = head.load(memory_order_acquire);
+            unique_lock<mutex> lock(sleepMutex);
+
+            while (flushed.load(memory_order_acquire) < target)
+            {
+                flushWanted = true;
+                wake.notify_one();
+                done.wait_for(lock, interval);
+            }
+        }
+
+        void reset(const string& newfile)
+        {
+            flush();
+            lock_guard<mutex> lock(fileMutex);
+
+            if (file) fclose(file);
+
+            filename = newfile;
+            file     = fopen(filename.c_str(), "w");
+        }
+    };
+
+    // formatted once per second per thread
+    const string& currentTime()
     {
-        Lockless_s lock(atomlock);
+        thread_local time_t cachedTime = 0;
+        thread_local string cachedStamp;
+
+        time_t rawtime = time(nullptr);
+
+        if (rawtime != cachedTime)
+        {
+            tm timeinfo;
+            char buffer[80];
+
+#ifdef _WIN32
+            localtime_s(&timeinfo, &rawtime);
+#else
+            localtime_r(&rawtime, &timeinfo);
+#endif
 
-        if(gcfg_debug_output_to_stdio)
-            std::wcout << L"DEBUG:[" + currentTimeW() + L"] " + line << std::endl;
+            strftime(buffer, sizeof(buffer), "%d-%m-%Y %H:%M:%S", &timeinfo);
+            cachedStamp = buffer;
+            cachedTime  = rawtime;
+        }
 
-        wofstream relog(filename, ios_base::app);
-        relog << L"[" + currentTimeW() + L"] " + line + L"\n";
-        relog.close();
+        return cachedStamp;
     }
-    catch (std::exception &e)
+}
+
+void DebugOutput()
+{
+    LogWriter::get().flush();
+}
+
+void DebugLogging(string line, bool noEndLine)
+{
+    if (noEndLine)
     {
-        if(gcfg_debug_output_to_stdio)
-            std::cout << "DEBUG: exception generated in DebugLogging!!! log files may be incomplete. Exception: " << e.what() << std::endl;
-        throw(std::runtime_error(e.what()));
+        size_t pos = line.find('\n');
+
+        while (pos != string::npos)
+        {
+            line.replace(pos, 1, " | ");
+            pos = line.find('\n', pos + 3);
+        }
     }
 
+    const string& stamp = currentTime();
+    string entry;
+    entry.reserve(stamp.length() + line.length() + 4);
+    entry.append("[").append(stamp).append("] ").append(line).push_back('\n');
+    LogWriter::get().push(move(entry));
+}
+
+void DebugLogging(wstring line, bool noEndLine)
+{
+    DebugLogging(nemesis::transform_to<string>(line), noEndLine);
 }
 
 void UpdateLogReset()
 {
-    filename = "UpdateLog.txt";
-    ofstream log(filename);
-    log.close();
+    LogWriter::get().reset("UpdateLog.txt");
 }
 
 void PatchLogReset()
 {
-    filename = "PatchLog.txt";
-    ofstream log(filename);
-    log.close();
+    LogWriter::get().reset("PatchLog.txt");
 }
@@ -3,7 +3,9 @@
 //#undef pyslots
 //#define MS_NO_COREDLL
 #include <Python.h>
+#include <chrono>
 #include <filesystem>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -26,6 +28,157 @@ bool dummyScript = false;
 void BatchScriptThread(const wstring& filename, const filesystem::path& filepath, bool hidden);
 void PythonScriptThread(const wstring& filename, const wchar_t* filepath);
 
+namespace
+{
+    // The interpreter is started by the first python script and kept until the program exits, so the
+    // bootstrap and the stdlib imports from the zip archive are only paid once.
+    // Every script gets its own global namespace, modules it imports stay cached in sys.modules.
+    // sys.path and the working directory are put back after each script, so one script cannot change
+    // where the next one imports from or resolves its relative paths.
+    // The GIL is released between scripts, any thread can run the next one
+    class PythonRuntime
+    {
+        mutex startMutex;
+        bool started = false;
+
+        PythonRuntime() = default;
+
+    public:
+        static PythonRuntime& get()
+        {
+            static PythonRuntime runtime;
+            return runtime;
+        }
+
+        void start()
+        {
+            lock_guard<mutex> lock(startMutex);
+
+            if (started) return;
+
+            // Setup python program name and embedded library paths before calling Py_Initialize().
+            // Zip archive containing Python libraries have to be in location 'python_libs/python39.zip'
+            // Libraries from lib-dynload have to be copied to 'python_libs/lib-dynload' and left there unpacked!!!
+            // Otherwise python can't unpack archive containing rest of libraries.
+            // Program name has to be set to nemesis main executable name.
+
+            #ifndef PYTHON_LIBS_ARCH_VER
+                #error PYTHON_LIBS_ARCH_VER should be defined as (python_ver_major)(python_ver_minor) ex. 39 for python 3.9.x
+            #endif
+
+            std::filesystem::path current_path = std::filesystem::current_path();
+            std::filesystem::path python_lib_path = current_path / (std::wstring(L"python_libs\\python") + std::to_wstring(PYTHON_LIBS_ARCH_VER) + L".zip");
+            std::filesystem::path python_dynlib_path = current_path / L"python_libs\\lib-dynload";
+
+            std::wstring python_lib_paths = std::wstring(python_lib_path) + L";" + std::wstring(python_dynlib_path);
+
+            std::error_code ec;
+            if (!std::filesystem::exists(python_lib_path, ec))
+            {
+                throw std::runtime_error("Python library archive missing! It is NOT a script Error!!! Try reinstalling Nemesis-Bfx. Missing file: " + python_lib_path.u8string());
+            }
+
+            Py_SetProgramName(L"Nemesis Unlimited Behavior Engine.exe");
+            Py_SetPath(python_lib_paths.c_str());
+
+            Py_Initialize();
+
+            // hand the GIL back, scripts take it through PyGILState_Ensure
+            PyEval_SaveThread();
+            started = true;
+        }
+
+        void run(FILE* f, const string& filepath)
+        {
+            PyGILState_STATE gil = PyGILState_Ensure();
+            PyObject* globals    = PyDict_New();
+            PyObject* name       = PyUnicode_FromString("__main__");
+            PyObject* file       = PyUnicode_DecodeFSDefault(filepath.c_str());
+
+            error_code ec;
+            filesystem::path workdir = filesystem::current_path(ec);
+            PyObject* syspath        = PySys_GetObject("path");
+            PyObject* savedPath      = nullptr;
+
+            if (syspath && PyList_Check(syspath))
+            {
+                Py_INCREF(syspath);
+                savedPath = PyList_GetSlice(syspath, 0, PyList_GET_SIZE(syspath));
+            }
+            else
+            {
+                syspath = nullptr;
+            }
+
+            PyDict_SetItemString(globals, "__name__", name);
+            PyDict_SetItemString(globals, "__file__", file);
+            PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+            Py_XDECREF(name);
+            Py_XDECREF(file);
+
+            PyObject* result = PyRun_FileExFlags(f, filepath.c_str(), Py_file_input, globals, globals, 0, nullptr);
+
+            if (result)
+            {
+                Py_DECREF(result);
+            }
+            // sys.exit() ends the script, not the program
+            else if (PyErr_ExceptionMatches(PyExc_SystemExit))
+            {
+                PyErr_Clear();
+            }
+            else
+            {
+                PyErr_Print();
+            }
+
+            // the interpreter is not finalized, output of the script would otherwise stay in the buffers
+            for (const char* stream : {"stdout", "stderr"})
+            {
+                PyObject* output = PySys_GetObject(stream);
+
+                if (!output || output == Py_None) continue;
+
+                PyObject* flushed = PyObject_CallMethod(output, "flush", nullptr);
+
+                if (flushed)
+                {
+                    Py_DECREF(flushed);
+                }
+                else
+                {
+                    PyErr_Clear();
+                }
+            }
+
+            // the script may have edited the list or bound sys.path to another one
+            if (savedPath)
+            {
+                if (PyList_SetSlice(syspath, 0, PyList_GET_SIZE(syspath), savedPath) != 0
+                    || PySys_SetObject("path", syspath) != 0)
+                {
+                    PyErr_Clear();
+                }
+
+                Py_DECREF(savedPath);
+            }
+
+            Py_XDECREF(syspath);
+
+            if (!workdir.empty()) filesystem::current_path(workdir, ec);
+
+            Py_DECREF(globals);
+            PyGILState_Release(gil);
+        }
+    };
+
+    void logDuration(const wstring& filename, chrono::steady_clock::time_point start)
+    {
+        auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+        DebugLogging(L"Script complete: " + filename + L" (" + to_wstring(duration.count()) + L"ms)");
+    }
+}
+
 void RunScript(const filesystem::path& directory, bool& hasScript)
 {
     if (!isFileExist(directory))
@@ -100,6 +253,8 @@ void BatchScriptThread(const wstring& filename, const filesystem::path& filepath
         interMsg(msg);
         DebugLogging(msg);
 
+        auto start = chrono::steady_clock::now();
+
         if (hidden)
         {
             QProcess* p = new QProcess();
@@ -111,6 +266,8 @@ void BatchScriptThread(const wstring& filename, const filesystem::path& filepath
         {
             if (QProcess::execute(QString::fromStdWString(filepath)) != 0) WarningMessage(1023, filepath);
         }
+
+        logDuration(filename, start);
     }
     catch (const exception& ex)
     {
@@ -138,34 +295,10 @@ void PythonScriptThread(const wstring& filename, const wchar_t* filepath)
         {
             try
             {
-                // Setup python program name and embedded library paths before calling Py_Initialize().
-                // Zip archive containing Python libraries have to be in location 'python_libs/python39.zip'
-                // Libraries from lib-dynload have to be copied to 'python_libs/lib-dynload' and left there unpacked!!!
-                // Otherwise python can't unpack archive containing rest of libraries.
-                // Program name has to be set to nemesis main executable name.
-
-                #ifndef PYTHON_LIBS_ARCH_VER
-                    #error PYTHON_LIBS_ARCH_VER should be defined as (python_ver_major)(python_ver_minor) ex. 39 for python 3.9.x
-                #endif
-
-                std::filesystem::path current_path = std::filesystem::current_path();
-                std::filesystem::path python_lib_path = current_path / (std::wstring(L"python_libs\\python") + std::to_wstring(PYTHON_LIBS_ARCH_VER) + L".zip");
-                std::filesystem::path python_dynlib_path = current_path / L"python_libs\\lib-dynload";
-
-                std::wstring python_lib_paths = std::wstring(python_lib_path) + L";" + std::wstring(python_dynlib_path);
-
-                std::error_code ec;
-                if (!std::filesystem::exists(python_lib_path, ec))
-                {
-                    throw std::runtime_error("Python library archive missing! It is NOT a script Error!!! Try reinstalling Nemesis-Bfx. Missing file: " + python_lib_path.u8string());
-                }
-
-                Py_SetProgramName(L"Nemesis Unlimited Behavior Engine.exe");
-                Py_SetPath(python_lib_paths.c_str());
-
-                Py_Initialize();
-                PyRun_SimpleFile(f, nemesis::transform_to<string>(wstring(filepath)).c_str());
-                Py_Finalize();
+                auto start = chrono::steady_clock::now();
+                PythonRuntime::get().start();
+                PythonRuntime::get().run(f, nemesis::transform_to<string>(wstring(filepath)));
+                logDuration(filename, start);
             }
             catch (const exception& ex)
             {
@@ -629,16 +629,14 @@ void fixedKeyInitialize()
     }
 }
 
-unsigned int CRC32Convert(string line)
+unsigned int CRC32Convert(string_view line)
 {
-    static nemesis::CRC32 crc32;
-    return crc32.FullCRC(line);
+    return nemesis::CRC32::instance().FullCRC(line);
 }
 
-unsigned int CRC32Convert(wstring line)
+unsigned int CRC32Convert(const wstring& line)
 {
-    static nemesis::CRC32 crc32;
-    return crc32.FullCRC(nemesis::transform_to<string>(line));
+    return nemesis::CRC32::instance().FullCRC(nemesis::transform_to<string>(line));
 }
 
 uint getUniqueKey(unsigned char bytearray[], int byte1, int byte2)
@@ -24,6 +24,7 @@ AnimationInfo::AnimationInfo(VecStr newAnimInfo,
     animInfo       = newAnimInfo;
     ignoreGroup    = behaviorOption.ignoreGroup;
     groupOption    = behaviorOption.groupOption;
+    optionIndex    = behaviorOption.optionIndex;
 
     if (animInfo.size() < 3) ErrorMessage(1142, curFilename, linecount);
 
@@ -70,7 +71,7 @@ AnimationInfo::AnimationInfo(VecStr newAnimInfo,
             if (option[0] == 'D' && isOnlyNumber(option.substr(1)))
             {
                 string time = nemesis::regex_replace(
-                    string(option), nemesis::regex("[^0-9]*([0-9]+(\\.([0-9]+)?)?).*"), string("\\1"));
+                    string(option), nemesis::precompiled(nemesis::pattern::first_decimal), string("\\1"));
 
                 if ("D" + time == option)
                 {
@@ -122,8 +123,7 @@ AnimationInfo::AnimationInfo(VecStr newAnimInfo,
                             {
                                 header           = optionOrder[m];
                                 string nonHeader = option.substr(header.length());
-                                string group     = nemesis::regex_replace(
-                                    string(nonHeader), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                                string group     = nemesis::first_number(nonHeader);
 
                                 if (group.length() != 0 && option == header + group && group != nonHeader)
                                 {
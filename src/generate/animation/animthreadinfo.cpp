@@ -21,8 +21,8 @@ AnimThreadInfo::AnimThreadInfo(
     int& _counter,
     size_t& _elementLine,
     int _furnitureCount,
-    ID& _eventid,
-    ID& _variableid,
+    const ID& _eventid,
+    const ID& _variableid,
     std::vector<int>& _fixedStateID,
     std::vector<int>& _stateCountMultiplier,
     int _order,
@@ -34,6 +34,8 @@ AnimThreadInfo::AnimThreadInfo(
     const std::unordered_map<std::string, std::unordered_map<std::string, VecStr>>& _groupAddition,
     const std::vector<std::unordered_map<std::string, bool>>& _groupOptionPicked,
     const std::vector<std::vector<std::unordered_map<std::string, bool>>>& _masterOptionPicked,
+    const std::vector<nemesis::OptionSet>& _groupOptionBits,
+    const std::vector<std::vector<nemesis::OptionSet>>& _masterOptionBits,
     std::shared_ptr<group> _groupFunction,
     std::shared_ptr<VecStr> _generatedlines,
     NewAnimation* _curAnim,
@@ -68,6 +70,8 @@ AnimThreadInfo::AnimThreadInfo(
     , groupOptionPicked(_groupOptionPicked)
     , masterOptionPicked(_masterOptionPicked)
     , groupFunction(_groupFunction)
+    , groupOptionBits(_groupOptionBits)
+    , masterOptionBits(_masterOptionBits)
 {
     generatedlines = _generatedlines;
     curAnim        = _curAnim;
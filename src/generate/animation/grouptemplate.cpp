@@ -7,6 +7,7 @@
 #include "utilities/stringsplit.h"
 
 #include "generate/animation/nodejoint.h"
+#include "generate/animation/nodeidledger.h"
 #include "generate/animation/templatetree.h"
 #include "generate/animation/grouptemplate.h"
 #include "generate/animation/singletemplate.h"
@@ -19,7 +20,7 @@ std::wstring DMLogError(int errorcode);
 void multiChoice(std::string& line,
                  std::string filename,
                  std::vector<std::vector<std::unordered_map<std::string, bool>>> masterOptionPicked,
-                 std::vector<std::vector<std::shared_ptr<AnimationInfo>>> groupAnimInfo,
+                 const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo,
                  int numline,
                  std::string format,
                  std::string masterformat,
@@ -27,7 +28,7 @@ void multiChoice(std::string& line,
 bool singleCondition(string condition,
                      string filename,
                      vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                     vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                     const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                      int numline,
                      string format,
                      string masterformat,
@@ -35,7 +36,7 @@ bool singleCondition(string condition,
 bool andLoop(string condition,
              string filename,
              vector<vector<unordered_map<string, bool>>> curOptionPicked,
-             vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+             const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
              int numline,
              string format,
              string masterformat,
@@ -45,7 +46,7 @@ bool andOrParenthesis(size_t c_and,
                       string condition,
                       string filename,
                       vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                      vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                      const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                       int numline,
                       string format,
                       string masterformat,
@@ -53,7 +54,7 @@ bool andOrParenthesis(size_t c_and,
 bool andParenthesis(string condition,
                     string filename,
                     vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                    vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                    const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                     int numline,
                     string format,
                     string masterformat,
@@ -61,7 +62,7 @@ bool andParenthesis(string condition,
 bool newCondition(std::string condition,
                   std::string filename,
                   std::vector<std::vector<std::unordered_map<std::string, bool>>> optionPicked,
-                  std::vector<std::vector<std::shared_ptr<AnimationInfo>>> groupAnimInfo,
+                  const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo,
                   int numline,
                   std::string format,
                   std::string masterformat,
@@ -72,7 +73,7 @@ bool conditionProcess(std::string condition,
                       std::string filename,
                       int numline,
                       std::vector<std::vector<std::unordered_map<std::string, bool>>> curOptionPicked,
-                      std::vector<std::vector<std::shared_ptr<AnimationInfo>>> groupAnimInfo,
+                      const std::vector<std::vector<std::shared_ptr<AnimationInfo>>>& groupAnimInfo,
                       bool isNot,
                       AnimationUtility utility);
 int formatGroupReplace(string& curline,
@@ -81,7 +82,7 @@ int formatGroupReplace(string& curline,
                        string filename,
                        string format,
                        shared_ptr<master> subFunctionIDs,
-                       vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                       const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                        int linecount,
                        int groupMulti,
                        int optionMulti,
@@ -95,7 +96,7 @@ void processing(string& line, shared_ptr<NodePackedParameters> parameters);
 bool specialCondition(string condition,
                       string filename,
                       vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                      vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                      const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                       int numline,
                       string format,
                       string masterformat,
@@ -112,11 +113,11 @@ void GroupTemplate::getFunctionLines(shared_ptr<VecStr> functionline,
                                      string formatname,
                                      vector<int>& stateID,
                                      shared_ptr<master> newSubFunctionIDs,
-                                     vector<vector<shared_ptr<AnimationInfo>>> newGroupAnimInfo,
+                                     const vector<vector<shared_ptr<AnimationInfo>>>& newGroupAnimInfo,
                                      int* nFunctionID,
                                      ImportContainer& import,
-                                     ID newEventID,
-                                     ID newVariableID,
+                                     const ID& newEventID,
+                                     const ID& newVariableID,
                                      string masterFormat,
                                      NewAnimLock& animLock,
                                      int groupCount)
@@ -128,8 +129,8 @@ void GroupTemplate::getFunctionLines(shared_ptr<VecStr> functionline,
     atomicLock     = const_cast<NewAnimLock*>(&animLock);
     subFunctionIDs = newSubFunctionIDs;
     groupAnimInfo  = newGroupAnimInfo;
-    eventid        = newEventID;
-    variableid     = newVariableID;
+    eventid        = &newEventID;
+    variableid     = &newVariableID;
 
     bool elementCatch  = false;
     bool norElement    = false;
@@ -144,19 +145,24 @@ void GroupTemplate::getFunctionLines(shared_ptr<VecStr> functionline,
 
 	unordered_map<int, bool> IsConditionOpened;
 	vector<vector<unordered_map<string, bool>>> masterOptionPicked;
+	vector<vector<nemesis::OptionSet>> masterOptionBits;
+	const vector<nemesis::OptionSet> groupOptionBits;
 
 	for (auto& groupInfo : groupAnimInfo)
 	{
 		vector<unordered_map<string, bool>> curGroupInfo;
+		vector<nemesis::OptionSet> curGroupBits;
 
 		for (auto& animInfo : groupInfo)
 		{
 			curGroupInfo.push_back(animInfo->optionPicked);
+			curGroupBits.emplace_back(animInfo->optionPicked, *animInfo->optionIndex);
 		}
 
 		if (curGroupInfo.size() > 0)
 		{
 			masterOptionPicked.push_back(curGroupInfo);
+			masterOptionBits.push_back(move(curGroupBits));
 		}
 	}
 
@@ -179,8 +185,8 @@ void GroupTemplate::getFunctionLines(shared_ptr<VecStr> functionline,
                                counter,
                                elementLine,
                                groupCount,
-                               eventid,
-                               variableid,
+                               newEventID,
+                               newVariableID,
                                fixedStateID,
                                stateCountMultiplier,
                                0,
@@ -192,6 +198,8 @@ void GroupTemplate::getFunctionLines(shared_ptr<VecStr> functionline,
                                unordered_map<string, unordered_map<string, VecStr>>(),
                                vector<unordered_map<string, bool>>(),
                                masterOptionPicked,
+                               groupOptionBits,
+                               masterOptionBits,
                                nullptr,
                                functionline,
                                nullptr,
@@ -201,1497 +209,56 @@ void GroupTemplate::getFunctionLines(shared_ptr<VecStr> functionline,
     animthrinfo.animLock       = atomicLock;
     animthrinfo.groupMulti     = grouptemplate->process.isMaster ? -1 : groupCount - 1;
     animthrinfo.curGroup       = this;
+    animthrinfo.idJournal      = idJournal;
 
     // output
     OutputCheckGroup(animthrinfo, grouptemplate->process, &grouptemplate->lines);
 
-    // OutputGroupBackup(functionline, format, masterFormat, behaviorFile, groupCount, templatelines, IsConditionOpened, masterOptionPicked, fixedStateID);
-
-    IsConditionOpened[0] = false;
-
-	for (auto it = IsConditionOpened.begin(); it != IsConditionOpened.end(); ++it)
-	{
-		if (it->second)
-		{
-			ErrorMessage(1120, format, filename);
-		}
-	}
-
-	if (functionline->size() != 0)
-	{
-		if (!functionline->back().empty())
-		{
-			functionline->push_back("");
-		}
-		else if (functionline->size() > 1)
-		{
-			while (functionline->back().empty())
-			{
-				if ((*functionline)[functionline->size() - 2].empty())
-				{
-					functionline->pop_back();
-				}
-				else
-				{
-					break;
-				}
-			}
-		}
-	}
-
-	functionline->shrink_to_fit();
-	return;
-}
-
-void GroupTemplate::OutputGroupBackup(shared_ptr<VecStr> functionline,
-                                      string format,
-                                      string masterFormat,
-                                      string behaviorFile,
-                                      int groupCount,
-                                      VecStr templatelines,
-                                      unordered_map<int, bool>& IsConditionOpened,
-                                      vector<vector<unordered_map<string, bool>>> masterOptionPicked,
-                                      vector<int> fixedStateID)
-{
-    unordered_map<string, string> IDExist;
-    VecStr tempstore;
-    VecStr templateID;
-    string multiOption;
-    bool negative   = false;
-    bool newOpen    = false;
-    bool multi      = false;
-    bool norElement = false;
-    bool open       = false;
-    bool skip       = false;
-    bool freeze     = false; // mainly used by CONDITION to freeze following CONDITION
-
-    int curGroup       = groupCount - 1;
-    int openRange      = 0;
-    int condition      = 0;
-    int counter        = 0;
-    int order          = -2;
-    int groupOrder     = -2;
-    size_t elementLine = -1;
-
-    for (uint i = 0; i < templatelines.size(); ++i)
-    {
-        bool uniqueskip   = false;
-        bool elementCatch = false;
-        string line       = templatelines[i];
-
-		if (line.find("<!-- CONDITION START ^", 0) != NOT_FOUND && !multi)
-		{
-			condition++;
-
-            if (!freeze && ((newOpen && !skip) || !newOpen))
-            {
-                if (!IsConditionOpened[condition])
-                {
-                    if (isPassed(condition, IsConditionOpened))
-                    {
-                        size_t optionPosition = line.find("<!-- CONDITION START ^") + 22;
-                        string conditionLine  = line.substr(
-                            optionPosition, line.find("^ -->", optionPosition) - optionPosition);
-                        AnimationUtility utility;
-                        utility.originalCondition = conditionLine;
-                        utility.currentProcess    = this;
-                        utility.hasGroup          = true;
-                        utility.groupMulti        = curGroup;
-
-                        if (newCondition(conditionLine,
-                                         filename,
-                                         masterOptionPicked,
-                                         groupAnimInfo,
-                                         i + 1,
-                                         format,
-                                         masterFormat,
-                                         utility))
-                        {
-                            skip                         = false;
-                            IsConditionOpened[condition] = true;
-                        }
-                        else
-                        {
-                            skip = true;
-                        }
-
-                        if (error) throw nemesis::exception();
-                    }
-                }
-                else
-                {
-                    skip   = true;
-                    freeze = true;
-                }
-            }
-
-			uniqueskip = true;
-		}
-		else if (line.find("<!-- CONDITION ^", 0) != NOT_FOUND && !multi)
-		{
-			if (condition == 0)
-			{
-				ErrorMessage(1119, format, filename, i + 1);
-			}
-
-            if (!freeze && ((newOpen && !skip) || !newOpen))
-            {
-                if (!IsConditionOpened[condition])
-                {
-                    if (isPassed(condition, IsConditionOpened))
-                    {
-                        size_t optionPosition = line.find("<!-- CONDITION ^") + 16;
-                        string option
-                            = line.substr(optionPosition, line.find("^", optionPosition) - optionPosition);
-                        AnimationUtility utility;
-                        utility.originalCondition = line;
-                        utility.currentProcess    = this;
-                        utility.hasGroup          = true;
-                        utility.groupMulti        = curGroup;
-
-                        if (newCondition(option,
-                                         filename,
-                                         masterOptionPicked,
-                                         groupAnimInfo,
-                                         i + 1,
-                                         format,
-                                         masterFormat,
-                                         utility))
-                        {
-                            skip                         = false;
-                            IsConditionOpened[condition] = true;
-                            uniqueskip                   = true;
-                        }
-                        else
-                        {
-                            skip = true;
-                        }
-
-                        if (error) throw nemesis::exception();
-                    }
-                }
-                else
-                {
-                    skip   = true;
-                    freeze = true;
-                }
-            }
-
-			uniqueskip = true;
-		}
-		else if (line.find("<!-- CONDITION -->", 0) != NOT_FOUND && !multi)
-		{
-			if (condition == 0)
-			{
-				ErrorMessage(1119, format, filename, i + 1);
-			}
-
-            if (!freeze && ((newOpen && !skip) || !newOpen))
-            {
-                if (!IsConditionOpened[condition])
-                {
-                    if (isPassed(condition, IsConditionOpened))
-                    {
-                        skip                         = false;
-                        IsConditionOpened[condition] = true;
-                    }
-                    else
-                    {
-                        skip = true;
-                    }
-                }
-                else
-                {
-                    skip   = true;
-                    freeze = true;
-                }
-            }
-
-			uniqueskip = true;
-		}
-		else if (line.find("<!-- NEW ^" + masterFormat + "^ -->", 0) != NOT_FOUND || line.find("<!-- NEW ^" + masterFormat + "_group^ -->", 0) != NOT_FOUND)
-		{
-			if (newOpen)
-			{
-				ErrorMessage(1116, format, filename, i + 1);
-			}
-
-			ErrorMessage(1164, format, filename, i + 1);
-		}
-		else if (line.find("<!-- FOREACH ^" + masterFormat + "^ -->", 0) != NOT_FOUND)
-		{
-			if (newOpen)
-			{
-				ErrorMessage(1116, format, filename, i + 1);
-			}
-
-            if (IsConditionOpened[condition])
-            {
-                if (groupCount != -1)
-                {
-                    if (!open)
-                    {
-                        open        = true;
-                        multi       = true;
-                        order       = -1;
-                        multiOption = masterFormat;
-                    }
-                    else
-                    {
-                        ErrorMessage(1115, format, filename, i + 1);
-                    }
-                }
-                else
-                {
-                    ErrorMessage(1159, format, filename, i + 1);
-                }
-            }
-
-			newOpen = true;
-			uniqueskip = true;
-		}
-		else if (line.find("<!-- FOREACH ^" + masterFormat + "_group^ -->", 0) != NOT_FOUND)
-		{
-			if (newOpen)
-			{
-				ErrorMessage(1116, format, filename, i + 1);
-			}
-
-            if (IsConditionOpened[condition])
-            {
-                if (groupCount == -1)
-                {
-                    if (!open)
-                    {
-                        open        = true;
-                        multi       = true;
-                        groupOrder  = -1;
-                        multiOption = masterFormat + "_group";
-                    }
-                    else
-                    {
-                        ErrorMessage(1115, format, filename, i + 1);
-                    }
-                }
-                else
-                {
-                    ErrorMessage(1160, format, filename, i + 1);
-                }
-            }
-
-			newOpen = true;
-			uniqueskip = true;
-		}
-		else if (line.find("<!-- NEW ^" + masterFormat + "_master^ -->", 0) != NOT_FOUND
-			|| line.find("<!-- FOREACH ^" + masterFormat + "_master^ -->", 0) != NOT_FOUND)
-		{
-			if (newOpen)
-			{
-				ErrorMessage(1116, format, filename, i + 1);
-			}
-
-			ErrorMessage(1163, format, filename, i + 1);
-		}
-		else if (line.find("<!-- NEW ^", 0) != NOT_FOUND && line.find("^ -->", 0) != NOT_FOUND)
-		{
-			if (newOpen)
-			{
-				ErrorMessage(1116, format, filename, i + 1);
-			}
-
-            if (IsConditionOpened[condition])
-            {
-                if (!open)
-                {
-                    string curOption = getOption(line);
-                    bool isNot       = false;
-
-                    if (curOption[0] == '!')
-                    {
-                        isNot     = true;
-                        curOption = curOption.substr(1);
-                    }
-
-                    VecStr optionInfo = GetOptionInfo(
-                        curOption, masterFormat, filename, i + 1, groupAnimInfo, false, true, groupCount);
-
-                    if (error) throw nemesis::exception();
-
-					if (optionInfo[3].find("AnimObject") != NOT_FOUND)
-					{
-						ErrorMessage(1129, format, filename, i + 1);
-					}
-
-                    if (!groupAnimInfo[stoi(optionInfo[1])][stoi(optionInfo[2])]->optionPicked[curOption])
-                    {
-                        // clear group number
-                        curOption = nemesis::regex_replace(string(optionInfo[2]),
-                                                         nemesis::regex("[^A-Za-z\\s]*([A-Za-z\\s]+).*"),
-                                                         string("\\1"));
-
-						if (groupAnimInfo[stoi(optionInfo[1])][stoi(optionInfo[2])]->optionPicked[curOption])
-						{
-							if (isNot)
-							{
-								skip = true;
-							}
-							else
-							{
-								open = true;
-							}
-						}
-						else
-						{
-							// Check if current condition accepts other options that are linked
-							if (isNot)
-							{
-								open = true;
-							}
-							else
-							{
-								skip = true;
-							}
-						}
-					}
-					else
-					{
-						if (isNot)
-						{
-							skip = true;
-						}
-						else
-						{
-							open = true;
-						}
-					}
-				}
-				else
-				{
-					ErrorMessage(1116, format, filename, i + 1);
-				}
-			}
-
-			newOpen = true;
-			uniqueskip = true;
-		}
-		else if (line.find("<!-- FOREACH ^", 0) != NOT_FOUND && line.find("^ -->", 0) != NOT_FOUND)
-		{
-			if (newOpen)
-			{
-				ErrorMessage(1116, format, filename, i + 1);
-			}
-
-            if (IsConditionOpened[condition])
-            {
-                if (!open)
-                {
-                    string curOption = getOption(line);
-                    bool isNot       = false;
-
-                    if (curOption[0] == '!')
-                    {
-                        isNot     = true;
-                        curOption = curOption.substr(1);
-                    }
-
-                    VecStr optionInfo = GetOptionInfo(
-                        curOption, masterFormat, filename, i + 1, groupAnimInfo, true, true, curGroup);
-
-                    if (error) throw nemesis::exception();
-
-                    if (!groupAnimInfo[stoi(optionInfo[1])][stoi(optionInfo[2])]->optionPicked[optionInfo[3]])
-                    {
-                        // Check if current condition accepts other options that are linked
-                        if (isNot)
-                        {
-                            tempstore.reserve(templatelines.size() / 5);
-                            open        = true;
-                            multi       = true;
-                            multiOption = optionInfo[3];
-
-							if (optionInfo[2].length() == 0)
-							{
-								order = -1;
-							}
-							else
-							{
-								order = stoi(optionInfo[2]);
-							}
-						}
-						else
-						{
-							skip = true;
-						}
-					}
-					else
-					{
-						if (isNot)
-						{
-							skip = true;
-						}
-						else
-						{
-							tempstore.reserve(templatelines.size() / 5);
-							open = true;
-							multi = true;
-							multiOption = optionInfo[3];
-
-							if (optionInfo[2].length() == 0)
-							{
-								order = -1;
-							}
-							else
-							{
-								order = stoi(optionInfo[2]);
-							}
-						}
-					}
-				}
-				else
-				{
-					ErrorMessage(1115, format, filename, i + 1);
-				}
-			}
-
-			newOpen = true;
-			uniqueskip = true;
-		}
-		else if (line.find("<!-- CLOSE -->", 0) != NOT_FOUND)
-		{
-			if (!newOpen)
-			{
-				ErrorMessage(1171, format, filename, i + 1);
-			}
-
-            newOpen    = false;
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- CONDITION END -->", 0) != NOT_FOUND && !multi)
-        {
-            uniqueskip = true;
-        }
-
-        if (!skip && !freeze && !uniqueskip)
-        {
-            while (true)
-            {
-                if (multi)
-                {
-                    tempstore.push_back(line);
-                    break;
-                }
-
-                if (line.find("MID$", 0) != NOT_FOUND)
-                {
-                    int counter = sameWordCount(line, "MID$");
-
-                    for (int k = 0; k < counter; ++k)
-                    {
-                        size_t MIDposition = line.find("MID$");
-                        string ID          = nemesis::regex_replace(string(line.substr(MIDposition)),
-                                                         nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                         string("\\1"));
-                        string oldID       = "MID$" + ID;
-
-						if (line.find(oldID, MIDposition) != NOT_FOUND)
-						{
-                            Lockless lock(atomicLock->subIDLock);
-
-							if (groupCount != -1 && subFunctionIDs->grouplist[curGroup]->functionIDs.find(oldID) != subFunctionIDs->grouplist[curGroup]->functionIDs.end())
-							{
-								ID = subFunctionIDs->grouplist[curGroup]->functionIDs[oldID];
-								subFunctionIDs->grouplist[curGroup]->functionIDs.erase(oldID);
-								IDExist[oldID] = ID;
-							}
-							else
-							{
-								if (IDExist[oldID].length() > 0)
-								{
-									ID = IDExist[oldID];
-								}
-								else
-                                {
-                                    ID             = newID();
-                                    IDExist[oldID] = ID;
-								}
-							}
-
-                            string templine = line;
-                            templine.replace(templine.find("MID$", MIDposition), 3, format);
-                            templine = templine.substr(templine.find(format + "$", MIDposition),
-                                                       format.length() + oldID.length() - 3);
-                            line.replace(line.find("MID$"), oldID.length(), ID);
-
-							if (groupCount == -1)
-							{
-								// master
-								subFunctionIDs->functionIDs[templine] = ID;
-							}
-							else
-							{
-								// group
-								subFunctionIDs->grouplist[curGroup]->functionIDs[templine] = ID;
-							}
-						}
-					}
-				}
-
-                // set state ID
-                if (line.find("$(S", 0) != NOT_FOUND)
-                {
-                    string templine = line.substr(line.find("$(S"));
-                    string ID       = nemesis::regex_replace(
-                        string(templine), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
-                    int intID;
-
-                    if (line.find("$(S" + ID + "+") == NOT_FOUND)
-                    {
-                        ID    = "";
-                        intID = 0;
-                    }
-                    else
-                    {
-                        intID = stoi(ID) - 1;
-
-						if (intID >= int(fixedStateID.size()) || intID < 0)
-						{
-							ErrorMessage(1168, format, filename, i + 1, templine.substr(0, templine.find(")") + 1));
-						}
-					}
-
-					if (line.find("$(S" + ID + "+") != NOT_FOUND)
-					{
-						stateReplacer(line, filename, ID, intID, fixedStateID[intID], i + 1, curGroup);
-					}
-				}
-
-				if (groupCount != -1)
-				{
-					// set animation ID
-					while (line.find("$%$", 0) != NOT_FOUND)
-					{
-						line.replace(line.find("$%$"), 3, to_string(groupCount));
-					}
-
-                    // multi choice selection
-                    if (line.find("$MC$", 0) != NOT_FOUND)
-                    {
-                        AnimationUtility utility;
-                        utility.originalCondition = line;
-                        utility.currentProcess    = this;
-                        utility.hasGroup          = true;
-                        utility.groupMulti        = curGroup;
-                        multiChoice(line,
-                                    filename,
-                                    masterOptionPicked,
-                                    groupAnimInfo,
-                                    i + 1,
-                                    format,
-                                    masterFormat,
-                                    utility);
-
-						if (error) throw nemesis::exception();
-					}
-
-					if (line.find("%") != NOT_FOUND)
-					{
-						__int64 counter = count(line.begin(), line.end(), '%');
-
-						for (int p = 0; p < counter; ++p)
-						{
-							line.replace(line.find("%"), 1, to_string(0));
-						}
-					}
-				}
-
-                // compute numelements
-                if (line.find("<hkparam name=\"") != NOT_FOUND && line.find("numelements=\"") != NOT_FOUND
-                    && line.find("</hkparam>") == NOT_FOUND
-                    && line.find("<!-- COMPUTE -->", line.find("numelements=\"")) != NOT_FOUND)
-                {
-                    if (!norElement)
-                    {
-                        norElement      = true;
-                        elementCatch    = true;
-                        string templine = line.substr(0, line.find("<hkparam name=\"", 0));
-                        openRange       = count(templine.begin(), templine.end(), '\t');
-                    }
-                    else
-                    {
-                        ErrorMessage(1136, format, filename, i + 1);
-                    }
-                }
-                else if (line.find("</hkparam>") != NOT_FOUND && norElement)
-                {
-                    string templine   = line.substr(0, line.find("</hkparam>"));
-                    __int64 t_counter = count(templine.begin(), templine.end(), '\t');
-
-					if (openRange == t_counter)
-					{
-						string oldElement;
-
-                        if ((*functionline)[elementLine].find("numelements=\"$elements$\">", 0) == NOT_FOUND)
-                        {
-                            size_t position = (*functionline)[elementLine].find("numelements=\"") + 13;
-                            oldElement      = (*functionline)[elementLine].substr(
-                                position, (*functionline)[elementLine].find("\">", position) - position);
-                        }
-                        else
-                        {
-                            oldElement = "$elements$";
-                        }
-
-                        if (oldElement != to_string(counter))
-                        {
-                            (*functionline)[elementLine].replace(
-                                (*functionline)[elementLine].find(oldElement),
-                                oldElement.length(),
-                                to_string(counter));
-                        }
-
-                        norElement  = false;
-                        counter     = 0;
-                        elementLine = -1;
-                    }
-                }
-
-				if (norElement)
-				{
-					string templine = line;
-
-					if (templine.find("<hkobject>") != NOT_FOUND)
-					{
-						templine = templine.substr(0, templine.find("<hkobject>"));
-						__int64 t_counter = count(templine.begin(), templine.end(), '\t');
-
-						if (t_counter == openRange + 1)
-						{
-							counter++;
-						}
-					}
-					else if (templine.find("\t\t\t#") != NOT_FOUND)
-					{
-						templine = templine.substr(0, templine.find("#", 0));
-						__int64 reference = count(templine.begin(), templine.end(), '\t');
-
-                        if (reference == openRange + 1)
-                        {
-                            __int64 number = count(line.begin(), line.end(), '#');
-                            counter += int(number);
-                        }
-                    }
-                }
-
-                if ((line.find("#" + masterFormat + "$") != NOT_FOUND
-                     || line.find("#" + masterFormat + "_group$") != NOT_FOUND))
-                {
-                    VecStr generator;
-                    size_t nextpos = -1;
-
-					if (line.find("\t\t\t#") != NOT_FOUND)
-					{
-						StringSplit(line, generator);
-					}
-					else
-					{
-						int ref = sameWordCount(line, "#" + masterFormat);
-
-                        for (int j = 0; j < ref; ++j)
-                        {
-                            nextpos         = line.find("#" + masterFormat, nextpos + 1);
-                            string templine = line.substr(nextpos);
-                            string ID       = nemesis::regex_replace(
-                                string(templine), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
-                            templine = line.substr(nextpos, line.find(ID, nextpos) - nextpos);
-                            generator.push_back(templine);
-                        }
-                    }
-
-					nextpos = 0;
-
-					for (unsigned int p = 0; p < generator.size(); p++)
-					{
-						string ID = generator[p];
-
-                        if (ID.find("#" + masterFormat + "$") != NOT_FOUND && multiOption == masterFormat)
-                        {
-                            nextpos       = line.find("#" + masterFormat + "$", nextpos) + 1;
-                            string tempID = line.substr(nextpos);
-                            string curID  = nemesis::regex_replace(
-                                string(tempID), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
-                            curID = masterFormat + "$" + curID;
-
-							if (tempID.find(curID, 0) != NOT_FOUND && nextpos == line.find(curID))
-							{
-								if (subFunctionIDs->grouplist[curGroup]->singlelist[0]->format[curID].length() == 0)
-								{
-									ErrorMessage(2017, format, filename, i + 1);
-								}
-
-                                line.replace(
-                                    nextpos,
-                                    curID.length(),
-                                    subFunctionIDs->grouplist[curGroup]->singlelist[0]->format[curID]);
-                            }
-                            else
-                            {
-                                ErrorMessage(2018, format, filename, i + 1, curID);
-                            }
-                        }
-                        else if (ID.find("#" + masterFormat + "_group") != NOT_FOUND
-                                 && multiOption == masterFormat + "_group")
-                        {
-                            nextpos       = line.find("#" + masterFormat + "_group$", nextpos) + 1;
-                            string tempID = line.substr(nextpos);
-                            string curID  = nemesis::regex_replace(
-                                string(tempID), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
-                            curID = multiOption + "$" + curID;
-
-							if (tempID.find(curID, 0) != NOT_FOUND && nextpos == line.find(curID))
-							{
-								for (unsigned int k = 0; k < subFunctionIDs->grouplist.size(); ++k) // number of variation
-								{
-									if (subFunctionIDs->grouplist[k]->functionIDs[curID].length() == 0)
-									{
-										ErrorMessage(2017, format, filename, i + 1);
-									}
-
-                                    line.replace(nextpos,
-                                                 curID.length(),
-                                                 subFunctionIDs->grouplist[k]->functionIDs[curID]);
-                                }
-                            }
-                            else
-                            {
-                                ErrorMessage(2018, format, filename, i + 1, curID);
-                            }
-                        }
-                    }
-                }
-
-				if (line.find("$") != NOT_FOUND && groupCount != -1)
-				{
-					processing(line, filename, masterFormat, i + 1, eventid, variableid, curGroup);
-				}
-
-                if (error) throw nemesis::exception();
-
-                size_t pos = line.find("(");
-
-                if (pos != NOT_FOUND && line.find(")", pos) != NOT_FOUND)
-                {
-                    string templine = line.substr(pos);
-                    int nextpos     = openEndBracket(templine, '(', ')', format, filename, i + 1) + 1;
-                    templine        = templine.substr(0, nextpos);
-                    string oldline  = templine;
-                    nemesis::calculate(templine, format, filename, i + 1);
-
-                    if (oldline != templine) line.replace(pos, oldline.length(), templine);
-                }
-
-                if (line.find("<hkparam name=\"animationName\">") != NOT_FOUND)
-                {
-                    pos             = line.find("animationName\">") + 15;
-                    string animPath = line.substr(pos, line.find("</hkparam>", pos) - pos);
-                    addUsedAnim(behaviorFile, animPath);
-                }
-                else if (line.find("<hkparam name=\"localTime\">-") != NOT_FOUND)
-                {
-                    negative = true;
-                }
-                else if (negative && line.find("<hkparam name=\"relativeToEndOfClip\">") != NOT_FOUND)
-                {
-                    if (line.find("<hkparam name=\"relativeToEndOfClip\">true</hkparam>") == NOT_FOUND)
-                    {
-                        size_t pos = line.find("<hkparam name=\"relativeToEndOfClip\">") + 36;
-                        line.replace(pos, line.find("</hkparam>", pos) - pos, "true");
-                    }
-
-					negative = false;
-				}
-
-				if (error) throw nemesis::exception();
-
-				functionline->push_back(line);
-
-				if (elementCatch)
-				{
-					elementLine = functionline->size() - 1;
-				}
-
-				break;
-			}
-		}
-
-		if (line.find("<!-- CLOSE -->", 0) != NOT_FOUND && IsConditionOpened[condition])
-		{
-			if (skip)
-			{
-				skip = false;
-			}
-			else
-			{
-				if (multi)
-				{
-					int size;
-					int tempOrder;
-					int groupSize;
-
-                    if (groupOrder == -2)
-                    {
-                        groupOrder = curGroup;
-                        groupSize  = groupCount;
-                    }
-                    else if (groupOrder == -1)
-                    {
-                        groupOrder = 0;
-                        groupSize  = int(subFunctionIDs->grouplist.size());
-                    }
-                    else
-                    {
-                        groupSize = groupOrder + 1;
-                    }
-
-                    for (int groupMulti = groupOrder; groupMulti < groupSize; ++groupMulti)
-                    {
-                        if (order == -2)
-                        {
-                            tempOrder = 0;
-                            size      = 1;
-                        }
-                        else if (order == -1)
-                        {
-                            tempOrder = 0;
-                            size      = int(subFunctionIDs->grouplist[groupMulti]->singlelist.size());
-                        }
-                        else
-                        {
-                            tempOrder = order;
-                            size      = order + 1;
-                        }
-
-						for (int animMulti = tempOrder; animMulti < size; ++animMulti) // each animation in a group
-						{
-							int optionMulti = 0;
-
-							while (true)
-							{
-								if (groupCount == -1 && multiOption == masterFormat + "_group")
-								{
-
-								}
-								else if (optionMulti >= groupAnimInfo[curGroup][animMulti]->optionPickedCount[multiOption])
-								{
-									break;
-								}
-
-								bool skip2 = false;
-								bool freeze2 = false;
-
-                                for (uint l = 0; l < tempstore.size(); ++l) // part lines need to add
-                                {
-                                    string curLine   = tempstore[l];
-                                    bool uniqueskip2 = false;
-                                    size_t linecount = i + 1 + l - int(tempstore.size());
-
-									if (curLine.find("<!-- CONDITION START ^", 0) != NOT_FOUND)
-									{
-										condition++;
-
-                                        if (!freeze2)
-                                        {
-                                            if (!IsConditionOpened[condition])
-                                            {
-                                                if (isPassed(condition, IsConditionOpened))
-                                                {
-                                                    size_t optionPosition
-                                                        = curLine.find("<!-- CONDITION START ^") + 22;
-                                                    string conditionLine
-                                                        = curLine.substr(optionPosition,
-                                                                         curLine.find("^ -->", optionPosition)
-                                                                             - optionPosition);
-                                                    AnimationUtility utility;
-                                                    utility.originalCondition = conditionLine;
-                                                    utility.currentProcess    = this;
-                                                    utility.hasGroup          = true;
-                                                    utility.groupMulti        = groupMulti;
-                                                    utility.animMulti         = animMulti;
-                                                    utility.optionMulti       = optionMulti;
-                                                    utility.multiOption       = multiOption;
-
-                                                    if (newCondition(conditionLine,
-                                                                     filename,
-                                                                     masterOptionPicked,
-                                                                     groupAnimInfo,
-                                                                     linecount,
-                                                                     format,
-                                                                     masterFormat,
-                                                                     utility))
-                                                    {
-                                                        skip2                        = false;
-                                                        IsConditionOpened[condition] = true;
-                                                    }
-                                                    else
-                                                    {
-                                                        skip2 = true;
-                                                    }
-
-                                                    if (error)
-                                                    {
-                                                        functionline->shrink_to_fit();
-                                                        return;
-                                                    }
-                                                }
-                                            }
-                                            else
-                                            {
-                                                skip2   = true;
-                                                freeze2 = true;
-                                            }
-                                        }
-
-										uniqueskip2 = true;
-									}
-									else if (curLine.find("<!-- CONDITION ^", 0) != NOT_FOUND)
-									{
-										if (condition == 0)
-										{
-											ErrorMessage(1119, format, filename, linecount);
-										}
-
-                                        if (!freeze2)
-                                        {
-                                            if (!IsConditionOpened[condition])
-                                            {
-                                                if (isPassed(condition, IsConditionOpened))
-                                                {
-                                                    size_t optionPosition
-                                                        = curLine.find("<!-- CONDITION ^") + 16;
-                                                    string option
-                                                        = curLine.substr(optionPosition,
-                                                                         curLine.find("^ -->", optionPosition)
-                                                                             - optionPosition);
-                                                    AnimationUtility utility;
-                                                    utility.originalCondition = option;
-                                                    utility.currentProcess    = this;
-                                                    utility.hasGroup          = true;
-                                                    utility.groupMulti        = groupMulti;
-                                                    utility.animMulti         = animMulti;
-                                                    utility.optionMulti       = optionMulti;
-                                                    utility.multiOption       = multiOption;
-
-                                                    if (newCondition(option,
-                                                                     filename,
-                                                                     masterOptionPicked,
-                                                                     groupAnimInfo,
-                                                                     linecount,
-                                                                     format,
-                                                                     masterFormat,
-                                                                     utility))
-                                                    {
-                                                        skip2                        = false;
-                                                        IsConditionOpened[condition] = true;
-                                                        uniqueskip2                  = true;
-                                                    }
-                                                    else
-                                                    {
-                                                        skip2 = true;
-                                                    }
-
-                                                    if (error)
-                                                    {
-                                                        functionline->shrink_to_fit();
-                                                        return;
-                                                    }
-                                                }
-                                            }
-                                            else
-                                            {
-                                                skip2   = true;
-                                                freeze2 = true;
-                                            }
-                                        }
-
-										uniqueskip2 = true;
-									}
-									else if (curLine.find("<!-- CONDITION -->", 0) != NOT_FOUND)
-									{
-										if (condition == 0)
-										{
-											ErrorMessage(1119, format, filename, linecount);
-										}
-
-                                        if (!freeze2)
-                                        {
-                                            if (!IsConditionOpened[condition])
-                                            {
-                                                if (isPassed(condition, IsConditionOpened))
-                                                {
-                                                    skip2                        = false;
-                                                    IsConditionOpened[condition] = true;
-                                                    uniqueskip2                  = true;
-                                                    size_t conditionPosition
-                                                        = curLine.find("<!-- CONDITION") + 14;
-                                                    string replacement1
-                                                        = curLine.substr(0, conditionPosition + 1);
-                                                    string replacement2 = curLine.substr(conditionPosition);
-                                                    functionline->push_back(replacement1 + "START"
-                                                                            + replacement2);
-                                                }
-                                                else
-                                                {
-                                                    skip2 = true;
-                                                }
-                                            }
-                                            else
-                                            {
-                                                skip2   = true;
-                                                freeze2 = true;
-                                            }
-                                        }
-
-                                        uniqueskip2 = true;
-                                    }
-                                    else if (curLine.find("<!-- CONDITION END -->", 0) != NOT_FOUND)
-                                    {
-                                        uniqueskip2 = true;
-                                    }
-
-                                    if (curLine.find("<!-- ") != NOT_FOUND
-                                        && curLine.find(" -->", curLine.find("<!-- ")) != NOT_FOUND
-                                        && curLine.find("$MC$") == NOT_FOUND)
-                                    {
-                                        bool isNot    = false;
-                                        size_t pos    = curLine.find("<!-- ") + 5;
-                                        string option = curLine.substr(pos, curLine.find(" -->") - pos);
-
-                                        if (option[0] == '!')
-                                        {
-                                            isNot  = true;
-                                            option = option.substr(1);
-                                        }
-
-										if (option == "L")
-										{
-											option = to_string(groupAnimInfo.size() - 1);
-										}
-
-										if (option == "F")
-										{
-											option = "0";
-										}
-
-										if (isOnlyNumber(option))
-										{
-											if (to_string(animMulti) == option && isNot)
-											{
-												break;
-											}
-											else if (to_string(animMulti) != option && !isNot)
-											{
-												break;
-											}
-										}
-
-										uniqueskip2 = true;
-									}
-
-									if (!skip2 && !freeze2 && !uniqueskip2)
-									{
-										if (curLine.find("$") != NOT_FOUND)
-										{
-											// set animation ID
-											while (curLine.find("$%$", 0) != NOT_FOUND)
-											{
-												curLine.replace(curLine.find("$%$"), 3, to_string(groupCount));
-											}
-
-											if (curLine.find("MID$", 0) != NOT_FOUND)
-											{
-												int counter = sameWordCount(curLine, "MID$");
-
-                                                for (int k = 0; k < counter; ++k)
-                                                {
-                                                    size_t MIDposition = curLine.find("MID$");
-                                                    string ID          = nemesis::regex_replace(
-                                                        string(curLine.substr(MIDposition)),
-                                                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                        string("\\1"));
-                                                    string oldID = "MID$" + ID;
-
-													if (curLine.find(oldID, MIDposition) != NOT_FOUND)
-													{
-                                                        Lockless lock(atomicLock->subIDLock);
-
-														if (groupCount != -1 
-															&& subFunctionIDs->grouplist[curGroup]->functionIDs.find(oldID) != subFunctionIDs->grouplist[curGroup]->functionIDs.end())
-														{
-															ID = subFunctionIDs->grouplist[curGroup]->functionIDs[oldID];
-															subFunctionIDs->grouplist[curGroup]->functionIDs.erase(oldID);
-															IDExist[oldID] = ID;
-														}
-														else
-														{
-															if (IDExist[oldID].length() > 0)
-															{
-																ID = IDExist[oldID];
-															}
-															else
-                                                            {
-                                                                ID             = newID();
-                                                                IDExist[oldID] = ID;
-															}
-														}
-
-                                                        string templine = curLine;
-                                                        templine.replace(
-                                                            templine.find("MID$", MIDposition), 3, format);
-                                                        templine = templine.substr(
-                                                            templine.find(format + "$", MIDposition),
-                                                            format.length() + oldID.length() - 3);
-                                                        curLine.replace(
-                                                            curLine.find("MID$"), oldID.length(), ID);
-
-                                                        if (groupCount == -1)
-                                                        {
-                                                            // master
-                                                            subFunctionIDs->functionIDs[templine] = ID;
-                                                        }
-                                                        else
-                                                        {
-                                                            // group
-                                                            subFunctionIDs->grouplist[curGroup]
-                                                                ->functionIDs[templine]
-                                                                = ID;
-                                                        }
-                                                    }
-                                                }
-                                            }
-
-                                            // set state ID
-                                            if (curLine.find("$(S", 0) != NOT_FOUND)
-                                            {
-                                                string templine = curLine.substr(curLine.find("$(S"));
-                                                string ID
-                                                    = nemesis::regex_replace(string(templine),
-                                                                           nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                                           string("\\1"));
-                                                int intID;
-
-                                                if (curLine.find("$(S" + ID + "+") == NOT_FOUND)
-                                                {
-                                                    ID    = "";
-                                                    intID = 0;
-                                                }
-                                                else
-                                                {
-                                                    intID = stoi(ID) - 1;
-
-                                                    if (intID >= int(fixedStateID.size()) || intID < 0)
-                                                    { 
-                                                        ErrorMessage(1127, format, filename, linecount); 
-                                                    }
-                                                }
-
-                                                if (curLine.find("$(S" + ID + "+") != NOT_FOUND)
-                                                {
-                                                    stateReplacer(curLine,
-                                                                  filename,
-                                                                  ID,
-                                                                  intID,
-                                                                  fixedStateID[intID],
-                                                                  linecount,
-                                                                  curGroup);
-                                                }
-                                            }
-
-                                            // multi choice selection
-                                            if (curLine.find("$MC$", 0) != NOT_FOUND)
-                                            {
-                                                AnimationUtility utility;
-                                                utility.originalCondition = curLine;
-                                                utility.currentProcess    = this;
-                                                utility.hasGroup          = true;
-                                                utility.groupMulti        = groupMulti;
-                                                utility.animMulti         = animMulti;
-                                                utility.optionMulti       = optionMulti;
-                                                utility.multiOption       = multiOption;
-
-                                                multiChoice(curLine,
-                                                            filename,
-                                                            masterOptionPicked,
-                                                            groupAnimInfo,
-                                                            linecount,
-                                                            format,
-                                                            masterFormat,
-                                                            utility);
-                                            }
-                                        }
-
-										if (error) throw nemesis::exception();
-
-										if (curLine.find("%") != NOT_FOUND)
-										{
-											__int64 counter = count(curLine.begin(), curLine.end(), '%');
-
-											for (int p = 0; p < counter; ++p)
-											{
-												curLine.replace(curLine.find("%"), 1, to_string(optionMulti));
-											}
-										}
-
-										if (norElement)
-										{
-											string templine = curLine;
-
-											if (templine.find("<hkobject>") != NOT_FOUND)
-											{
-												templine = templine.substr(0, templine.find("<hkobject>"));
-												__int64 t_counter = count(templine.begin(), templine.end(), '\t');
-
-												if (t_counter == openRange + 1)
-												{
-													counter++;
-												}
-											}
-											else if (templine.find("\t\t\t#") != NOT_FOUND)
-											{
-												templine = templine.substr(0, templine.find("#", 0));
-												__int64 reference = count(templine.begin(), templine.end(), '\t');
-
-												if (reference == openRange + 1)
-												{
-													__int64 number = count(curLine.begin(), curLine.end(), '#');
-													counter += int(number);
-												}
-											}
-										}
-
-										if (curLine.find("\t\t\t#") != NOT_FOUND && (curLine.find("#" + masterFormat + "$") != NOT_FOUND
-											|| curLine.find("#" + masterFormat + "_group$") != NOT_FOUND))
-										{
-											VecStr generator;
-											StringSplit(curLine, generator);
-											size_t nextpos = 0;
-
-                                            for (uint p = 0; p < generator.size(); p++)
-                                            {
-                                                string ID = generator[p];
-
-                                                if (ID.find("#" + masterFormat + "$") != NOT_FOUND
-                                                    && multiOption == masterFormat)
-                                                {
-                                                    nextpos
-                                                        = curLine.find("#" + masterFormat + "$", nextpos) + 1;
-                                                    string tempID = curLine.substr(nextpos);
-                                                    string curID  = nemesis::regex_replace(
-                                                        string(tempID),
-                                                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                        string("\\1"));
-                                                    curID = masterFormat + "$" + curID;
-
-													if (tempID.find(curID, 0) != NOT_FOUND && nextpos == curLine.find(curID))
-													{
-														if (subFunctionIDs->grouplist[groupMulti]->singlelist[animMulti]->format[curID].length() == 0)
-														{
-															ErrorMessage(2017, format, filename, linecount);
-														}
-
-                                                        curLine.replace(nextpos,
-                                                                        curID.length(),
-                                                                        subFunctionIDs->grouplist[groupMulti]
-                                                                            ->singlelist[animMulti]
-                                                                            ->format[curID]);
-                                                    }
-                                                    else
-                                                    {
-                                                        ErrorMessage(
-                                                            2018, format, filename, linecount, curID);
-                                                    }
-                                                }
-                                                else if (ID.find("#" + masterFormat + "_group") != NOT_FOUND
-                                                         && multiOption == masterFormat + "_group")
-                                                {
-                                                    nextpos = curLine.find("#" + multiOption, nextpos) + 1;
-                                                    string tempID = curLine.substr(nextpos);
-                                                    string curID  = nemesis::regex_replace(
-                                                        string(tempID),
-                                                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                        string("\\1"));
-                                                    curID = multiOption + "$" + curID;
-
-													if (tempID.find(curID, 0) != NOT_FOUND && nextpos == curLine.find(curID))
-													{
-														if (subFunctionIDs->grouplist[groupMulti]->functionIDs[curID].length() == 0)
-														{
-															ErrorMessage(2017, format, filename, linecount);
-														}
-
-														curLine.replace(nextpos, curID.length(), subFunctionIDs->grouplist[groupMulti]->functionIDs[curID]);
-													}
-													else
-													{
-														ErrorMessage(2018, format, filename, linecount, curID);
-													}
-												}
-											}
-										}
-
-                                        if (curLine.find("$") != NOT_FOUND)
-                                        {
-                                            processing(curLine,
-                                                       filename,
-                                                       masterFormat,
-                                                       linecount,
-                                                       eventid,
-                                                       variableid,
-                                                       curGroup,
-                                                       optionMulti,
-                                                       animMulti,
-                                                       multiOption);
-                                        }
-
-										if (error) throw nemesis::exception();
-
-										size_t pos = curLine.find("(");
-
-                                        if (pos != NOT_FOUND && curLine.find(")", pos) != NOT_FOUND)
-                                        {
-                                            string templine = curLine.substr(pos);
-                                            int nextpos     = openEndBracket(
-                                                              templine, '(', ')', format, filename, linecount)
-                                                          + 1;
-
-                                            if (error)
-                                            {
-                                                functionline->shrink_to_fit();
-                                                return;
-                                            }
-
-                                            templine       = templine.substr(0, nextpos);
-                                            string oldline = templine;
-                                            nemesis::calculate(templine, format, filename, linecount);
-
-											if (oldline != templine)
-											{
-												curLine.replace(pos, oldline.length(), templine);
-											}
-										}
-
-										if (curLine.find("<hkparam name=\"animationName\">") != NOT_FOUND)
-										{
-											pos = curLine.find("animationName\">") + 15;
-											string animPath = curLine.substr(pos, curLine.find("</hkparam>", pos) - pos);
-											addUsedAnim(behaviorFile, animPath);
-										}
-										else if (curLine.find("<hkparam name=\"localTime\">-") != NOT_FOUND)
-										{
-											negative = true;
-										}
-										else if (negative && curLine.find("<hkparam name=\"relativeToEndOfClip\">") != NOT_FOUND)
-										{
-											if (curLine.find("<hkparam name=\"relativeToEndOfClip\">true</hkparam>") == NOT_FOUND)
-											{
-												size_t pos = curLine.find("<hkparam name=\"relativeToEndOfClip\">") + 36;
-												curLine.replace(pos, curLine.find("</hkparam>", pos) - pos, "true");
-											}
-
-											negative = false;
-										}
-
-										functionline->push_back(curLine);
-									}
-
-									if (curLine.find("<!-- CONDITION END -->", 0) != NOT_FOUND)
-									{
-										if (condition == 0)
-										{
-											ErrorMessage(1118, format, filename, linecount);
-										}
-
-										if (freeze2 && IsConditionOpened[condition])
-										{
-											freeze2 = false;
-										}
-
-										if (isPassed(condition, IsConditionOpened))
-										{
-											skip2 = false;
-										}
-										else
-										{
-											skip2 = true;
-										}
-
-										IsConditionOpened[condition] = false;
-										condition--;
-									}
-								}
-
-								if (groupCount == -1 && multiOption == masterFormat + "_group")
-								{
-									break;
-								}
-
-								++optionMulti;
-							}
-						}
-
-						order = -2;
-					}
-				}
+    IsConditionOpened[0] = false;
 
-				tempstore.clear();
-			}
+	for (auto it = IsConditionOpened.begin(); it != IsConditionOpened.end(); ++it)
+	{
+		if (it->second)
+		{
+			ErrorMessage(1120, format, filename);
+		}
+	}
 
-			multi = false;
-			open = false;
+	if (functionline->size() != 0)
+	{
+		if (!functionline->back().empty())
+		{
+			functionline->push_back("");
 		}
-		else if (line.find("<!-- CONDITION END -->", 0) != NOT_FOUND && !multi)
+		else if (functionline->size() > 1)
 		{
-			if (condition == 0)
-			{
-				ErrorMessage(1118, format, filename, i + 1);
-			}
-
-			if ((newOpen && !skip) || !newOpen)
+			while (functionline->back().empty())
 			{
-				if (freeze && IsConditionOpened[condition])
-				{
-					freeze = false;
-				}
-
-				if (isPassed(condition, IsConditionOpened))
+				if ((*functionline)[functionline->size() - 2].empty())
 				{
-					skip = false;
+					functionline->pop_back();
 				}
 				else
 				{
-					skip = true;
+					break;
 				}
-
-				IsConditionOpened[condition] = false;
 			}
-
-			condition--;
 		}
 	}
 
-	if (newOpen)
-	{
-		ErrorMessage(1116, format, filename, templatelines.size());
-	}
+	functionline->shrink_to_fit();
+	return;
 }
 
 VecStr
 ExistingFunction::groupExistingFunctionProcess(int curFunctionID,
                                                VecStr existingFunctionLines,
                                                shared_ptr<master> newSubFunctionIDs,
-                                               vector<vector<shared_ptr<AnimationInfo>>> newGroupAnimInfo,
+                                               const vector<vector<shared_ptr<AnimationInfo>>>& newGroupAnimInfo,
                                                string curformat,
                                                ImportContainer& import,
-                                               ID newEventID,
-                                               ID newVariableID,
+                                               const ID& newEventID,
+                                               const ID& newVariableID,
                                                int& nFunctionID,
                                                bool hasMaster,
                                                bool hasGroup,
@@ -1709,8 +276,8 @@ ExistingFunction::groupExistingFunctionProcess(int curFunctionID,
     format         = curformat;
     subFunctionIDs = newSubFunctionIDs;
     groupAnimInfo  = newGroupAnimInfo;
-    eventid        = newEventID;
-    variableid     = newVariableID;
+    eventid        = &newEventID;
+    variableid     = &newVariableID;
     m_hasGroup     = hasGroup;
     nodeIDLock     = &nodeIDFlag;
 
@@ -2311,7 +878,7 @@ ExistingFunction::groupExistingFunctionProcess(int curFunctionID,
 
 				if (line.find("$") != NOT_FOUND && !hasGroup)
 				{
-					processing(line, IDFileName, curFunctionID, i + 1, eventid, variableid, 0);
+					processing(line, IDFileName, curFunctionID, i + 1, *eventid, *variableid, 0);
 				}
 
 				size_t pos = line.find("(");
@@ -2568,10 +1135,7 @@ ExistingFunction::groupExistingFunctionProcess(int curFunctionID,
                                                 {
                                                     nextpos = curLine.find("#" + format + "$", nextpos) + 1;
                                                     string tempID = curLine.substr(nextpos);
-                                                    string curID  = nemesis::regex_replace(
-                                                        string(tempID),
-                                                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                        string("\\1"));
+                                                    string curID  = nemesis::first_number(tempID);
                                                     curID = format + "$" + curID;
 
                                                     if (tempID.find(curID, 0) != NOT_FOUND
@@ -2604,10 +1168,7 @@ ExistingFunction::groupExistingFunctionProcess(int curFunctionID,
                                                 {
                                                     nextpos = curLine.find("#" + multiOption, nextpos) + 1;
                                                     string tempID = curLine.substr(nextpos);
-                                                    string curID  = nemesis::regex_replace(
-                                                        string(tempID),
-                                                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                        string("\\1"));
+                                                    string curID  = nemesis::first_number(tempID);
                                                     curID = multiOption + "$" + curID;
 
                                                     if (tempID.find(curID, 0) != NOT_FOUND
@@ -2638,10 +1199,7 @@ ExistingFunction::groupExistingFunctionProcess(int curFunctionID,
                                                 {
                                                     nextpos = curLine.find("#" + multiOption, nextpos) + 1;
                                                     string tempID = curLine.substr(nextpos);
-                                                    string curID  = nemesis::regex_replace(
-                                                        string(tempID),
-                                                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                        string("\\1"));
+                                                    string curID  = nemesis::first_number(tempID);
                                                     curID = multiOption + "$" + curID;
 
                                                     if (tempID.find(curID, 0) != NOT_FOUND
@@ -2737,8 +1295,8 @@ ExistingFunction::groupExistingFunctionProcess(int curFunctionID,
                                                        IDFileName,
                                                        curFunctionID,
                                                        linecount,
-                                                       eventid,
-                                                       variableid,
+                                                       *eventid,
+                                                       *variableid,
                                                        groupMulti,
                                                        optionMulti,
                                                        animMulti,
@@ -2849,10 +1407,7 @@ void GroupTemplate::stateReplacer(
 
     for (int i = 0; i < count; ++i)
     {
-        string number = nemesis::regex_replace(
-            string(line.substr(line.find("$(S" + statenum + "+") + statenum.length() + 4)),
-            nemesis::regex("[^0-9]*([0-9]+).*"),
-            string("\\1"));
+        string number = nemesis::first_number(string(line.substr(line.find("$(S" + statenum + "+") + statenum.length() + 4)));
         string state = "$(S" + statenum + "+" + number + ")$";
 
         if (line.find(state, 0) != NOT_FOUND)
@@ -2889,8 +1444,8 @@ void GroupTemplate::processing(string& line,
                                string filename,
                                string masterFormat,
                                int linecount,
-                               ID eventid,
-                               ID variableid,
+                               const ID& eventid,
+                               const ID& variableid,
                                int groupMulti,
                                int optionMulti,
                                int animMulti,
@@ -2927,14 +1482,11 @@ void GroupTemplate::processing(string& line,
 
                         if (equation.find("(S", 0) != NOT_FOUND)
                         {
-                            ID = nemesis::regex_replace(
-                                string(equation), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                            ID = nemesis::first_number(equation);
 
                             if (change.find("(S" + ID + "+") == NOT_FOUND) ID = "";
 
-                            number = nemesis::regex_replace(string(equation.substr(3 + ID.length())),
-                                                          nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                          string("\\1"));
+                            number = nemesis::first_number(string(equation.substr(3 + ID.length())));
                         }
 
                         if (equation != "(S" + ID + "+" + number + ")")
@@ -3010,9 +1562,7 @@ void GroupTemplate::processing(string& line,
                 if (change.find(masterFormat + "[", 0) != NOT_FOUND)
                 {
                     string number
-                        = nemesis::regex_replace(string(change.substr(change.find(masterFormat + "[", 0))),
-                                               nemesis::regex("[^0-9]*([0-9]+).*"),
-                                               string("\\1"));
+                        = nemesis::first_number(string(change.substr(change.find(masterFormat + "[", 0))));
 
                     if (change.find(masterFormat + "[" + number + "][FilePath]", 0) != NOT_FOUND)
                     {
@@ -3080,9 +1630,7 @@ void GroupTemplate::processing(string& line,
                 if (change.find(masterFormat + "[", 0) != NOT_FOUND)
                 {
                     string number
-                        = nemesis::regex_replace(string(change.substr(change.find(masterFormat + "[", 0))),
-                                               nemesis::regex("[^0-9]*([0-9]+).*"),
-                                               string("\\1"));
+                        = nemesis::first_number(string(change.substr(change.find(masterFormat + "[", 0))));
 
                     if (change.find(masterFormat + "[" + number + "][FileName]", 0) != NOT_FOUND)
                     {
@@ -3455,8 +2003,8 @@ void ExistingFunction::processing(string& line,
                                   string filename,
                                   int curFunctionID,
                                   int linecount,
-                                  ID eventid,
-                                  ID variableid,
+                                  const ID& eventid,
+                                  const ID& variableid,
                                   int groupMulti,
                                   int optionMulti,
                                   int animMulti,
@@ -3494,14 +2042,11 @@ void ExistingFunction::processing(string& line,
 
                         if (equation.find("(S", 0) != NOT_FOUND)
                         {
-                            ID = nemesis::regex_replace(
-                                string(equation), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                            ID = nemesis::first_number(equation);
 
                             if (change.find("(S" + ID + "+") == NOT_FOUND) ID = "";
 
-                            number = nemesis::regex_replace(string(equation.substr(3 + ID.length())),
-                                                          nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                          string("\\1"));
+                            number = nemesis::first_number(string(equation.substr(3 + ID.length())));
                         }
 
                         if (equation != "(S" + ID + "+" + number + ")")
@@ -3581,9 +2126,7 @@ void ExistingFunction::processing(string& line,
                     if (change.find(format + "[", 0) != NOT_FOUND)
                     {
                         string number
-                            = nemesis::regex_replace(string(change.substr(change.find(format + "[", 0))),
-                                                   nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                   string("\\1"));
+                            = nemesis::first_number(string(change.substr(change.find(format + "[", 0))));
 
                         if (change.find(format + "[" + number + "][FilePath]", 0) != NOT_FOUND)
                         {
@@ -3647,9 +2190,7 @@ void ExistingFunction::processing(string& line,
                     if (change.find(format + "[", 0) != NOT_FOUND)
                     {
                         string number
-                            = nemesis::regex_replace(string(change.substr(change.find(format + "[", 0))),
-                                                   nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                   string("\\1"));
+                            = nemesis::first_number(string(change.substr(change.find(format + "[", 0))));
 
                         if (change.find(format + "[" + number + "][FileName]", 0) != NOT_FOUND)
                         {
@@ -4081,7 +2622,7 @@ void ExistingFunction::processing(string& line,
 void multiChoice(string& line,
                  string filename,
                  vector<vector<unordered_map<string, bool>>> masterOptionPicked,
-                 vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                 const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                  int numline,
                  string format,
                  string masterformat,
@@ -4163,7 +2704,7 @@ void multiChoice(string& line,
 bool specialCondition(string condition,
                       string filename,
                       vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                      vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                      const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                       int numline,
                       string format,
                       string masterformat,
@@ -4479,8 +3020,8 @@ bool specialCondition(string condition,
                                                 filename,
                                                 stoi(filename.substr(1)),
                                                 numline,
-                                                utility.currentProcess->eventid,
-                                                utility.currentProcess->variableid,
+                                                *utility.currentProcess->eventid,
+                                                *utility.currentProcess->variableid,
                                                 groupMulti1,
                                                 optionMulti1,
                                                 animMulti1,
@@ -4501,8 +3042,8 @@ bool specialCondition(string condition,
                                                                            filename,
                                                                            masterformat,
                                                                            numline,
-                                                                           utility.currentProcess->eventid,
-                                                                           utility.currentProcess->variableid,
+                                                                           *utility.currentProcess->eventid,
+                                                                           *utility.currentProcess->variableid,
                                                                            groupMulti1,
                                                                            optionMulti1,
                                                                            animMulti1,
@@ -4544,8 +3085,8 @@ bool specialCondition(string condition,
                                                 filename,
                                                 stoi(filename.substr(1)),
                                                 numline,
-                                                utility.currentProcess->eventid,
-                                                utility.currentProcess->variableid,
+                                                *utility.currentProcess->eventid,
+                                                *utility.currentProcess->variableid,
                                                 groupMulti2,
                                                 optionMulti1,
                                                 animMulti2,
@@ -4566,8 +3107,8 @@ bool specialCondition(string condition,
                                                                            filename,
                                                                            masterformat,
                                                                            numline,
-                                                                           utility.currentProcess->eventid,
-                                                                           utility.currentProcess->variableid,
+                                                                           *utility.currentProcess->eventid,
+                                                                           *utility.currentProcess->variableid,
                                                                            groupMulti2,
                                                                            optionMulti1,
                                                                            animMulti2,
@@ -4639,7 +3180,7 @@ bool specialCondition(string condition,
 bool singleCondition(string condition,
                      string filename,
                      vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                     vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                     const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                      int numline,
                      string format,
                      string masterformat,
@@ -4678,7 +3219,7 @@ bool singleCondition(string condition,
 bool andLoop(string condition,
              string filename,
              vector<vector<unordered_map<string, bool>>> curOptionPicked,
-             vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+             const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
              int numline,
              string format,
              string masterformat,
@@ -4795,7 +3336,7 @@ bool andOrParenthesis(size_t c_and,
                       string condition,
                       string filename,
                       vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                      vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                      const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                       int numline,
                       string format,
                       string masterformat,
@@ -4874,7 +3415,7 @@ bool andOrParenthesis(size_t c_and,
 bool andParenthesis(string condition,
                     string filename,
                     vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                    vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                    const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                     int numline,
                     string format,
                     string masterformat,
@@ -4947,7 +3488,7 @@ bool andParenthesis(string condition,
 bool newCondition(string condition,
                   string filename,
                   vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                  vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                  const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                   int numline,
                   string format,
                   string masterformat,
@@ -5290,7 +3831,7 @@ namespace backup
     bool newCondition(string condition,
                       string filename,
                       vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                      vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                      const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                       int numline,
                       string format,
                       string masterformat,
@@ -5849,7 +4390,7 @@ VecStr GetOptionInfo(string line,
                      string format,
                      string filename,
                      int numline,
-                     vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                     const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                      bool allowNoFixAnim,
                      bool isCondition,
                      int groupMulti,
@@ -6008,7 +4549,7 @@ void nonGroupOptionInfo(VecStr& optionInfo,
                         string format,
                         string filename,
                         int numline,
-                        vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                        const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                         bool allowNoFixAnim,
                         bool isCondition,
                         int groupMulti,
@@ -6075,7 +4616,7 @@ void optionLimiter(VecStr optionInfo,
                    string format,
                    string filename,
                    int numline,
-                   vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                   const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                    int open,
                    bool isCondition,
                    int curGroup,
@@ -6206,7 +4747,7 @@ string optionOrderProcess(string line,
         string templine = newline;
         templine        = templine + "a";
         string newtempline
-            = nemesis::regex_replace(string(templine), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+            = nemesis::first_number(templine);
 
 		if (newtempline == templine) ErrorMessage(1055, format, filename, numline, line);
 		if (stoi(newline) > int(lastOrder)) ErrorMessage(1148, format, filename, numline, line);
@@ -6223,7 +4764,7 @@ bool conditionProcess(string condition,
                       string filename,
                       int numline,
                       vector<vector<unordered_map<string, bool>>> curOptionPicked,
-                      vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                      const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                       bool isNot,
                       AnimationUtility utility)
 {
@@ -6323,7 +4864,7 @@ bool conditionProcess(string condition,
                 if (isalpha(optionInfo.back()[1]))
                 {
                     conditionOrder = nemesis::regex_replace(
-                        string(optionInfo.back()), nemesis::regex("\\^([A-Za-z]+)\\^"), string("\\1"));
+                        string(optionInfo.back()), nemesis::precompiled(nemesis::pattern::condition_order), string("\\1"));
 
 					if (nemesis::iequals(conditionOrder, "last")) conditionResult = utility.animMulti == groupAnimInfo.size() - 1 ? !isNot : isNot;
 					else if (nemesis::iequals(conditionOrder, "first")) conditionOrder = "0";
@@ -6372,7 +4913,7 @@ bool conditionProcess(string condition,
 			if (isalpha(optionInfo.back()[1]))
 			{
                 conditionOrder = nemesis::regex_replace(
-                    string(optionInfo.back()), nemesis::regex("\\^([A-Za-z]+)\\^"), string("\\1"));
+                    string(optionInfo.back()), nemesis::precompiled(nemesis::pattern::condition_order), string("\\1"));
 
 				if (nemesis::iequals(conditionOrder, "last")) return utility.animMulti == groupAnimInfo.size() - 1 ? !isNot : isNot;
 				else if (nemesis::iequals(conditionOrder, "first")) conditionOrder = "0";
@@ -6404,18 +4945,15 @@ bool conditionProcess(string condition,
 
 string GroupTemplate::newID()
 {
-    Lockless lock(atomicLock->nodeIDLock);
-    int& refID   = *nextFunctionID;
-    string strID = to_string(refID++);
-
-	while (strID.length() < 4)
-	{
-		strID = "0" + strID;
-    }
+    if (idJournal) return idJournal->newID();
 
-    if (refID == 9216) ++refID;
+    Lockless lock(atomicLock->nodeIDLock);
+    return nemesis::NodeIDLedger::take(*nextFunctionID);
+}
 
-    return strID;
+void GroupTemplate::setIDJournal(nemesis::NodeIDJournal* journal)
+{
+    idJournal = journal;
 }
 
 void GroupTemplate::setZeroEvent(string eventname)
@@ -6428,19 +4966,12 @@ void GroupTemplate::setZeroVariable(string variablename)
 	zeroVariable = variablename;
 }
 
+// existing functions are processed on the thread of the behavior file, after its template jobs are
+// joined and their ledgers resolved, so lastID is final here
 string ExistingFunction::newID()
 {
     Lockless lock(*nodeIDLock);
-	string strID = to_string(*nextFunctionID++);
-
-	while (strID.length() < 4)
-	{
-		strID = "0" + strID;
-	}
-
-    if (*nextFunctionID == 9216) ++(*nextFunctionID);
-
-    return strID;
+    return nemesis::NodeIDLedger::take(*nextFunctionID);
 }
 
 void ExistingFunction::setZeroEvent(string eventname)
@@ -6459,7 +4990,7 @@ int formatGroupReplace(string& curline,
                        string filename,
                        string format,
                        shared_ptr<master> subFunctionIDs,
-                       vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                       const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                        int linecount,
                        int groupMulti,
                        int optionMulti,
@@ -6715,14 +5246,12 @@ void OutputCheckGroup(AnimThreadInfo& animthrinfo, const proc& process, nemesis:
         bool hasProcess          = false;
         animthrinfo.elementCatch = false;
         string line;
-        VecStr lineblocks;
 
 		if (curstack.nestedcond.size() == 0)
 		{
 			hasProcess = curstack.hasProcess;
 
-			if (hasProcess) lineblocks = curstack.lineblocks;
-			else line = *curstack.raw;
+			if (!hasProcess) line = *curstack.raw;
 		}
 		else
 		{
@@ -6845,7 +5374,7 @@ void OutputCheckGroup(AnimThreadInfo& animthrinfo, const proc& process, nemesis:
                 {
                     animthrinfo.numline = curstack.linecount;
                     animthrinfo.line    = &line;
-                    process.blocksCompile(lineblocks, animthrinfo);
+                    process.blocksCompile(curstack.lineblocks, animthrinfo);
 
 					if (error) throw nemesis::exception();
 				}
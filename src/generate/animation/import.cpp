@@ -1,3 +1,4 @@
+#include <map>
 #include <utility>
 
 #include "Global.h"
@@ -20,7 +21,15 @@ VecStr importOutput(vector<ImportContainer>& ExportID, int counter, int nextID)
     ImportContainer newExportID;
     int lastID = nextID;
 
-    for (auto it = ExportID[counter].begin(); it != ExportID[counter].end(); ++it)
+    // sorted, so the output does not depend on the order the animations registered their imports
+    map<string, map<string, string>> sortedExport;
+
+    for (auto& file : ExportID[counter])
+    {
+        sortedExport[file.first].insert(file.second.begin(), file.second.end());
+    }
+
+    for (auto it = sortedExport.begin(); it != sortedExport.end(); ++it)
     {
         string filename = "behavior templates\\" + it->first + ".txt";
 
@@ -157,9 +166,7 @@ VecStr importOutput(vector<ImportContainer>& ExportID, int counter, int nextID)
 
 						for (int k = 0; k < reference; ++k)
 						{
-                            string number = nemesis::regex_replace(string(line.substr(line.find("$import["))),
-                                                                   nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                                   string("\\1"));
+                            string number = nemesis::first_number(string(line.substr(line.find("$import["))));
 
 							if (line.find("$import[" + number + "]$", 0) != NOT_FOUND)
 							{
@@ -324,8 +331,7 @@ VecStr importOutput(vector<ImportContainer>& ExportID, int counter, int nextID)
                         for (int k = 0; k < reference; ++k)
                         {
                             string tempID = line.substr(line.find("MID$"));
-                            string number = nemesis::regex_replace(
-                                string(tempID), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                            string number = nemesis::first_number(tempID);
                             string oldID = "MID$" + number;
 
                             if (line.find(oldID) != NOT_FOUND)
@@ -43,7 +43,7 @@ bool hasOptionPicked(const vector<unordered_map<string, bool>>& groupOptionPicke
 
 NewAnimation::NewAnimation(shared_ptr<unordered_map<string, AnimTemplate>> animlines,
                            string formatname,
-                           unordered_map<string, VecStr> furnituretemplate,
+                           shared_ptr<const unordered_map<string, VecStr>> furnituretemplate,
                            int furniturecount,
                            string curfilepath,
                            AnimationInfo& animationinfo)
@@ -76,8 +76,8 @@ NewAnimation::NewAnimation(shared_ptr<unordered_map<string, AnimTemplate>> animl
 void NewAnimation::GetNewAnimationLine(shared_ptr<NewAnimArgs> args)
 {
     shared_ptr<VecStr> generatedlines = args->allEditLines;
-    ID eventid                        = args->eventid;
-    ID variableid                     = args->variableid;
+    const ID& eventid                 = args->eventid;
+    const ID& variableid              = args->variableid;
     vector<int>& stateID              = args->stateID;
     vector<int> stateCountMultiplier  = args->stateMultiplier;
     bool hasGroup                     = args->hasGroup;
@@ -87,6 +87,7 @@ void NewAnimation::GetNewAnimationLine(shared_ptr<NewAnimArgs> args)
     newImport      = const_cast<ImportContainer*>(&args->exportID);
     atomicLock     = const_cast<NewAnimLock*>(&args->atomicLock);
     nextFunctionID = args->lastID;
+    idJournal      = args->idJournal;
     subFunctionIDs = args->singleFunctionIDs;
 
     bool negative      = false;
@@ -104,12 +105,16 @@ void NewAnimation::GetNewAnimationLine(shared_ptr<NewAnimArgs> args)
 
     auto optPickPtr = (std::vector<unordered_map<string, bool>>*) &groupOptionPicked;
     optPickPtr->reserve(groupAnimInfo.size());
+    groupOptionBits.reserve(groupOptionBits.size() + groupAnimInfo.size());
 
     for (unsigned int i = 0; i < groupAnimInfo.size(); ++i)
     {
         optPickPtr->push_back(groupAnimInfo[i]->optionPicked);
+        groupOptionBits.emplace_back(groupAnimInfo[i]->optionPicked, *groupAnimInfo[i]->optionIndex);
     }
 
+    // a single animation has no master group; the thread info only keeps a reference to it
+    const vector<vector<nemesis::OptionSet>> noMasterBits;
     generatedlines->reserve((*animtemplate)[behaviorFile].size + 10 * memory);
     AnimThreadInfo curAnimInfo(filepath,
                                filename,
@@ -140,18 +145,23 @@ void NewAnimation::GetNewAnimationLine(shared_ptr<NewAnimArgs> args)
                                groupAddition,
                                groupOptionPicked,
                                std::vector<std::vector<std::unordered_map<std::string, bool>>>(),
+                               groupOptionBits,
+                               noMasterBits,
                                args->subFunctionIDs,
                                generatedlines,
                                this,
                                atomicLock);
-    proc process = (*animtemplate)[behaviorFile].process;
+    curAnimInfo.idJournal = idJournal;
+    const proc& process = (*animtemplate)[behaviorFile].process;
 
     if (args->core)
     {
-        for (unsigned int i = 0; i < rawtemplate[behaviorFile].size(); ++i)
+        auto rawlines = rawtemplate->find(behaviorFile);
+
+        for (unsigned int i = 0; rawlines != rawtemplate->end() && i < rawlines->second.size(); ++i)
         {
             elementCatch = false;
-            string line  = rawtemplate[behaviorFile][i];
+            string line  = rawlines->second[i];
 
             hasProcessing(line,
                           norElement,
@@ -284,6 +294,7 @@ void NewAnimation::GetNewAnimationLine(shared_ptr<NewAnimArgs> args)
     }
 
     generatedlines->shrink_to_fit();
+    idJournal = nullptr;
 }
 
 string NewAnimation::GetFilePath()
@@ -328,18 +339,15 @@ unordered_map<string, unordered_map<string, VecStr>> NewAnimation::GetGroupAddit
 
 string NewAnimation::newID()
 {
-    Lockless lock(atomicLock->nodeIDLock);
-    int& refID   = *nextFunctionID;
-    string strID = to_string(refID++);
-
-    while (strID.length() < 4)
-    {
-        strID = "0" + strID;
-    }
+    if (idJournal) return idJournal->newID();
 
-    if (refID == 9216) ++refID;
+    Lockless lock(atomicLock->nodeIDLock);
+    return nemesis::NodeIDLedger::take(*nextFunctionID);
+}
 
-    return strID;
+void NewAnimation::resolveIDs(const nemesis::NodeIDLedger& ledger)
+{
+    ledger.patch(IDExist);
 }
 
 void NewAnimation::addGroupAnimInfo(vector<shared_ptr<AnimationInfo>> animInfo)
@@ -400,17 +408,17 @@ int NewAnimation::getNextID(string behavior)
 {
     unordered_map<int, bool> taken;
     int IDUsed = 0;
+    auto rawlines = rawtemplate->find(behavior);
 
-    for (auto& line : rawtemplate[behavior])
+    if (rawlines == rawtemplate->end()) return IDUsed;
+
+    for (auto& line : rawlines->second)
     {
         if (line.find("<hkobject name=\"#MID$") != NOT_FOUND)
         {
-            string number
-                = nemesis::regex_replace(string(line),
-                                         nemesis::regex(".*<hkobject name=\"#MID[$]([0-9]+)\" class=\".*"),
-                                         string("\\1"));
+            string number;
 
-            if (number != line && isOnlyNumber(number))
+            if (nemesis::number_between(line, "<hkobject name=\"#MID$", "\" class=\"", number))
             {
                 int num = stoi(number);
 
@@ -873,14 +881,11 @@ void NewAnimation::processing(string& line,
 
                         if (equation.find("(S", 0) != NOT_FOUND)
                         {
-                            ID = nemesis::regex_replace(
-                                string(equation), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                            ID = nemesis::first_number(equation);
 
                             if (change.find("(S" + ID + "+") == NOT_FOUND) ID = "";
 
-                            number = nemesis::regex_replace(string(equation.substr(3 + ID.length())),
-                                                            nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                            string("\\1"));
+                            number = nemesis::first_number(string(equation.substr(3 + ID.length())));
                         }
 
                         if (equation != "(S" + ID + "+" + number + ")" && isOnlyNumber(number))
@@ -1023,10 +1028,7 @@ void NewAnimation::processing(string& line,
 
                 if (change.find(format + "[") != NOT_FOUND)
                 {
-                    string number = nemesis::regex_replace(
-                        string(change.substr(change.find(format + "[") + 1 + format.length())),
-                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                        string("\\1"));
+                    string number = nemesis::first_number(string(change.substr(change.find(format + "[") + 1 + format.length())));
 
                     if (change.find(format + "[" + number + "][END]", 0) != NOT_FOUND && isOnlyNumber(number))
                     {
@@ -1074,8 +1076,7 @@ void NewAnimation::processing(string& line,
             if (change.find("(S", 0) != NOT_FOUND)
             {
                 string templine = change.substr(change.find("(S"));
-                string ID       = nemesis::regex_replace(
-                    string(templine), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                string ID       = nemesis::first_number(templine);
                 int intID;
 
                 if (change.find("(S" + ID + "+") == NOT_FOUND)
@@ -1161,19 +1162,12 @@ void NewAnimation::processing(string& line,
 
                 if (change.find(format + "[") != NOT_FOUND)
                 {
-                    string number = nemesis::regex_replace(
-                        string(change.substr(change.find(format + "[") + 1 + format.length())),
-                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                        string("\\1"));
+                    string number = nemesis::first_number(string(change.substr(change.find(format + "[") + 1 + format.length())));
 
                     if (change.find(format + "[" + number + "][(S" + ID + "+") != NOT_FOUND
                         && isOnlyNumber(number))
                     {
-                        string number2 = nemesis::regex_replace(
-                            string(change.substr(change.find(format + "[" + number + "][(S" + ID + "+")
-                                                 + format.length() + number.length() + ID.length() + 6)),
-                            nemesis::regex("[^0-9]*([0-9]+).*"),
-                            string("\\1"));
+                        string number2 = nemesis::first_number(string(change.substr(change.find(format + "[" + number + "][(S" + ID + "+") + format.length() + number.length() + ID.length() + 6)));
 
                         if (change.find(format + "[" + number + "][(S" + ID + "+" + number2 + ")]")
                             != NOT_FOUND)
@@ -1192,10 +1186,7 @@ void NewAnimation::processing(string& line,
 
                 if (change.find("(S" + ID + "+", 0) != NOT_FOUND)
                 {
-                    string number = nemesis::regex_replace(
-                        string(change.substr(change.find("(S" + ID + "+") + 3 + ID.length())),
-                        nemesis::regex("[^0-9]*([0-9]+).*"),
-                        string("\\1"));
+                    string number = nemesis::first_number(string(change.substr(change.find("(S" + ID + "+") + 3 + ID.length())));
 
                     if (change.find("(S" + ID + "+" + number + ")", 0) != NOT_FOUND && isOnlyNumber(number))
                     {
@@ -1254,8 +1245,7 @@ void NewAnimation::processing(string& line,
 
                 if (change.find(format + "[", 0) != NOT_FOUND)
                 {
-                    string number = nemesis::regex_replace(
-                        string(change), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    string number = nemesis::first_number(change);
 
                     if (change.find(format + "[" + number + "][FilePath]", 0) != NOT_FOUND
                         && isOnlyNumber(number))
@@ -1333,8 +1323,7 @@ void NewAnimation::processing(string& line,
 
                 if (change.find(format + "[", 0) != NOT_FOUND)
                 {
-                    string number = nemesis::regex_replace(
-                        string(change), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    string number = nemesis::first_number(change);
 
                     if (change.find(format + "[" + number + "][FileName]", 0) != NOT_FOUND
                         && isOnlyNumber(number))
@@ -1406,8 +1395,7 @@ void NewAnimation::processing(string& line,
 
                 if (change.find(format + "[", 0) != NOT_FOUND)
                 {
-                    string number = nemesis::regex_replace(
-                        string(change), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    string number = nemesis::first_number(change);
 
                     if (change.find(format + "[" + number + "][Path]", 0) != NOT_FOUND
                         && isOnlyNumber(number))
@@ -1653,9 +1641,7 @@ void NewAnimation::processing(string& line,
 
                 if (fixedStateID.size() > 1)
                 {
-                    number = nemesis::regex_replace(string(change.substr(change.find("LastState"))),
-                                                    nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                    string("\\1"));
+                    number = nemesis::first_number(string(change.substr(change.find("LastState"))));
 
                     if (change.find("LastState" + number, 0) != NOT_FOUND && isOnlyNumber(number))
                     {
@@ -1782,6 +1768,8 @@ void NewAnimation::processing(string& line,
                     if ((*newImport)[file][keyword].length() > 0)
                     {
                         tempID = (*newImport)[file][keyword];
+
+                        if (idJournal) idJournal->touch(tempID);
                     }
                     else
                     {
@@ -1971,7 +1959,7 @@ void animObjectReplacer(string& line,
             size_t nextpos = line.find(format + "[" + animNum + "][@AnimObject/");
             string object  = line.substr(nextpos);
             string number
-                = nemesis::regex_replace(string(object), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                = nemesis::first_number(object);
             object = format + "[" + animNum + "][@AnimObject/" + number + "]";
 
             if (line.find(object) == NOT_FOUND || !isOnlyNumber(number))
@@ -1991,7 +1979,7 @@ void animObjectReplacer(string& line,
             size_t nextpos = line.find("@AnimObject/");
             string object  = line.substr(nextpos);
             string number
-                = nemesis::regex_replace(string(object), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                = nemesis::first_number(object);
             object = "@AnimObject/" + number;
 
             if (line.find(object) == NOT_FOUND || !isOnlyNumber(number))
@@ -2009,10 +1997,7 @@ void NewAnimation::stateReplacer(
 {
     if (otherAnim)
     {
-        string number = nemesis::regex_replace(
-            string(line.substr(line.find("][(S" + statenum + "+") + 5 + statenum.length())),
-            nemesis::regex("[^0-9]*([0-9]+).*"),
-            string("\\1"));
+        string number = nemesis::first_number(string(line.substr(line.find("][(S" + statenum + "+") + 5 + statenum.length())));
         string state = format + "[" + otherAnimOrder + "][(S" + statenum + "+" + number + ")]";
 
         if (!isOnlyNumber(number)) ErrorMessage(1152, format, behaviorFile, linecount, state);
@@ -2032,9 +2017,7 @@ void NewAnimation::stateReplacer(
     else
     {
         string templine = line.substr(line.find("(S" + statenum + "+"));
-        string number   = nemesis::regex_replace(string(templine.substr(statenum.length() + 3)),
-                                               nemesis::regex("[^0-9]*([0-9]+).*"),
-                                               string("\\1"));
+        string number   = nemesis::first_number(string(templine.substr(statenum.length() + 3)));
         string state    = "(S" + statenum + "+" + number + ")";
 
         if (!isOnlyNumber(number)) ErrorMessage(1152, format, behaviorFile, linecount, state);
@@ -2105,7 +2088,7 @@ void eventIDReplacer(string& line,
         size_t nextpos       = line.find("eventID[");
         string fullEventName = line.substr(nextpos, line.find("]", nextpos) - nextpos + 1);
         string eventName     = nemesis::regex_replace(
-            string(fullEventName), nemesis::regex(".*eventID[[](.*?)[]].*"), string("\\1"));
+            string(fullEventName), nemesis::precompiled(nemesis::pattern::event_id_name), string("\\1"));
         const auto& eventItr = eventid.find(eventName);
 
         if (eventItr == eventid.end() || (eventItr->second == 0 && eventName != firstEvent))
@@ -2133,7 +2116,7 @@ void variableIDReplacer(string& line,
         size_t nextpos     = line.find("variableID[");
         string fullVarName = line.substr(nextpos, line.find("]", nextpos) - nextpos + 1);
         string varName     = nemesis::regex_replace(
-            string(fullVarName), nemesis::regex(".*variableID[[](.*)[]].*"), string("\\1"));
+            string(fullVarName), nemesis::precompiled(nemesis::pattern::variable_id_name), string("\\1"));
         const auto& varItr    = variableid.find(varName);
 
         if (varItr == variableid.end() || (varItr->second == 0 && ZeroVariable != varName))
@@ -2265,8 +2248,7 @@ VecStr GetOptionInfo(string line,
         {
             templine           = optionInfo[1];
             templine           = templine + "a";
-            string newtempline = nemesis::regex_replace(
-                string(templine), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+            string newtempline = nemesis::first_number(templine);
 
             if (newtempline == templine) ErrorMessage(1179, format, filename, numline, line);
 
@@ -2382,7 +2364,7 @@ bool clearGroupNum(string option2,
                    const unordered_map<string, bool>& groupOption)
 {
     string templine = nemesis::regex_replace(
-        string(option2), nemesis::regex("[^A-Za-z\\s]*([A-Za-z\\s]+).*"), string("\\1"));
+        string(option2), nemesis::precompiled(nemesis::pattern::first_word), string("\\1"));
 
     auto grpopt = groupOption.find(templine);
 
@@ -2595,8 +2577,8 @@ bool NewAnimation::specialCondition(string condition,
                                        storeline,
                                        format,
                                        linecount,
-                                       utility.eventid,
-                                       utility.variableid,
+                                       *utility.eventid,
+                                       *utility.variableid,
                                        utility.fixedStateID,
                                        utility.stateCountMultiplier,
                                        utility.hasGroup,
@@ -2622,8 +2604,8 @@ bool NewAnimation::specialCondition(string condition,
                                        storeline,
                                        format,
                                        linecount,
-                                       utility.eventid,
-                                       utility.variableid,
+                                       *utility.eventid,
+                                       *utility.variableid,
                                        utility.fixedStateID,
                                        utility.stateCountMultiplier,
                                        utility.hasGroup,
@@ -2762,7 +2744,7 @@ bool NewAnimation::GetFirstCondition(string firstCondition,
         if (isalpha(optionInfo[2][1]))
         {
             conditionOrder = nemesis::regex_replace(
-                string(optionInfo[2]), nemesis::regex("\\^([A-Za-z]+)\\^"), string("\\1"));
+                string(optionInfo[2]), nemesis::precompiled(nemesis::pattern::condition_order), string("\\1"));
 
             if (nemesis::iequals(conditionOrder, "last"))
             {
@@ -2810,7 +2792,7 @@ bool NewAnimation::GetFirstCondition(string firstCondition,
 //	animdatalines = animdata;
 //}
 
-void NewAnimation::addAnimData(unordered_map<string, unordered_map<string, AnimTemplate>> animdata)
+void NewAnimation::addAnimData(shared_ptr<unordered_map<string, unordered_map<string, AnimTemplate>>> animdata)
 {
     animdatatemplate = animdata;
 }
@@ -2820,7 +2802,8 @@ void NewAnimation::addAnimData(unordered_map<string, unordered_map<string, AnimT
 //	asdlines = animsetdata;
 //}
 
-void NewAnimation::addAnimSetData(unordered_map<string, map<string, AnimTemplate, alphanum_less>> animsetdata)
+void NewAnimation::addAnimSetData(
+    shared_ptr<unordered_map<string, map<string, AnimTemplate, alphanum_less>>> animsetdata)
 {
     asdtemplate = animsetdata;
 }
@@ -2830,14 +2813,20 @@ void NewAnimation::GetAnimData(unordered_map<string, map<string, VecStr>>& newAn
     unordered_map<int, bool> IsConditionOpened;
     auto optPickPtr = (std::vector<unordered_map<string, bool>>*) &groupOptionPicked;
     optPickPtr->clear();
+    groupOptionBits.clear();
     optPickPtr->reserve(groupAnimInfo.size());
+    groupOptionBits.reserve(groupOptionBits.size() + groupAnimInfo.size());
 
     for (unsigned int i = 0; i < groupAnimInfo.size(); ++i)
     {
         optPickPtr->push_back(groupAnimInfo[i]->optionPicked);
+        groupOptionBits.emplace_back(groupAnimInfo[i]->optionPicked, *groupAnimInfo[i]->optionIndex);
     }
 
-    for (auto& project : animdatatemplate)
+    // core proxies carry no animation data
+    if (!animdatatemplate) return;
+
+    for (auto& project : *animdatatemplate)
     {
         for (auto& header : project.second)
         {
@@ -2892,7 +2881,9 @@ void NewAnimation::GetAnimSetData(unordered_map<string, map<string, VecStr, alph
         groupOptionPicked.push_back(groupAnimInfo[i]->optionPicked);
     }
 
-    for (auto& project : asdtemplate)
+    if (!asdtemplate) return;
+
+    for (auto& project : *asdtemplate)
     {
         for (auto& header : project.second)
         {
@@ -2919,35 +2910,120 @@ void NewAnimation::GetAnimSetData(unordered_map<string, map<string, VecStr, alph
     return;
 }
 
-void NewAnimation::AnimDataLineProcess(VecStr originallines,
-                                       VecStr& newlines,
+void NewAnimation::AnimDataLineProcess(AnimTemplate* originaltemplate,
+                                       shared_ptr<VecStr> generatedlines,
                                        string format,
+                                       string project,
+                                       string header,
                                        vector<int> ASD)
 {
+    int counter     = 0;
+    bool negative   = false;
+    bool norElement = false;
+    int openRange   = 0;
+    size_t elementLine;
+
+    generatedlines->reserve(originaltemplate->size + 10 * memory);
+
+    ID tmpId;
+    ID tmpId2;
+
+    std::vector<int> fixedStateID;
+    std::vector<int> stateCountMultiplier;
+    const vector<vector<nemesis::OptionSet>> noMasterBits;
+
+    AnimThreadInfo animThrInfo(filepath,
+                               filename,
+                               mainAnimEvent,
+                               zeroEvent,
+                               zeroVariable,
+                               false,
+                               negative,
+                               isEnd,
+                               norElement,
+                               elementCatch,
+                               hasDuration,
+                               duration,
+                               openRange,
+                               counter,
+                               elementLine,
+                               furnitureCount,
+                               tmpId,
+                               tmpId2,
+                               fixedStateID,
+                               stateCountMultiplier,
+                               order,
+                               lastOrder,
+                               IDExist,
+                               AnimObject,
+                               addition,
+                               newImport,
+                               groupAddition,
+                               groupOptionPicked,
+                               std::vector<std::vector<std::unordered_map<std::string, bool>>>(),
+                               groupOptionBits,
+                               noMasterBits,
+                               nullptr,
+                               generatedlines,
+                               this,
+                               nullptr);
+    animThrInfo.project = project;
+    animThrInfo.header  = header;
+
+    OutputCheck(generatedlines,
+                animThrInfo,
+                originaltemplate->process,
+                &originaltemplate->lines,
+                norElement,
+                openRange,
+                elementLine,
+                counter,
+                tmpId,
+                tmpId2,
+                vector<int>(),
+                vector<int>(),
+                false,
+                negative,
+                nullptr);
+}
+
+void NewAnimation::existingASDProcess(VecStr ASDLines, map<int, VecStr>& extract, vector<int> ASD)
+{
+    unordered_map<int, bool> IsConditionOpened;
+    auto optPickPtr = (std::vector<unordered_map<string, bool>>*) &groupOptionPicked;
+    optPickPtr->reserve(groupAnimInfo.size());
+    groupOptionBits.reserve(groupOptionBits.size() + groupAnimInfo.size());
+
+    for (unsigned int i = 0; i < groupAnimInfo.size(); ++i)
     {
-        VecStr emptyVS;
-        newlines = emptyVS;
+        optPickPtr->push_back(groupAnimInfo[i]->optionPicked);
+        groupOptionBits.emplace_back(groupAnimInfo[i]->optionPicked, *groupAnimInfo[i]->optionIndex);
     }
 
-    unordered_map<int, bool> IsConditionOpened;
+    VecStr store;
     VecStr recorder;
-    newlines.reserve(originallines.size() + 10 * memory);
     bool skip         = false; // mainly used by NEW
     bool freeze       = false; // mainly used by CONDITION to freeze following CONDITION
     bool open         = false;
     bool multi        = false;
     bool newOpen      = false;
+    bool openStore    = false;
     int openOrder     = -2;
     int condition     = 0;
+    int curExtract    = -1;
     __int64 openRange = 0;
     __int64 counter   = 0;
     string multiOption;
     IsConditionOpened[0] = true;
 
-    for (uint i = 0; i < originallines.size(); ++i)
+    VecStr newlines;
+    newlines.reserve(ASDLines.size() + 10 * memory);
+    string line;
+
+    for (uint i = 0; i < ASDLines.size(); ++i)
     {
+        line            = ASDLines[i];
         bool uniqueskip = false;
-        string line     = originallines[i];
 
         if (line.find("<!-- CONDITION START ^", 0) != NOT_FOUND && !multi)
         {
@@ -2962,21 +3038,24 @@ void NewAnimation::AnimDataLineProcess(VecStr originallines,
                         size_t optionPosition = line.find("<!-- CONDITION START ^") + 22;
                         string conditionLine  = line.substr(
                             optionPosition, line.find("^ -->", optionPosition) - optionPosition);
-                        AnimationUtility utility;
-
-                        if (conditionLine.find("[") == NOT_FOUND || conditionLine.find("]") == NOT_FOUND)
-                        {
-                            ErrorMessage(1153, format, behaviorFile, i + 1, conditionLine);
-                        }
 
-                        if (newCondition(conditionLine, newlines, i + 1, utility))
+                        if (conditionLine.find("[") == NOT_FOUND)
                         {
-                            skip                         = false;
-                            IsConditionOpened[condition] = true;
+                            if (format != conditionLine) skip = true;
                         }
                         else
                         {
-                            skip = true;
+                            AnimationUtility utility;
+
+                            if (newCondition(conditionLine, newlines, i + 1, utility))
+                            {
+                                skip                         = false;
+                                IsConditionOpened[condition] = true;
+                            }
+                            else
+                            {
+                                skip = true;
+                            }
                         }
                     }
                 }
@@ -3002,21 +3081,26 @@ void NewAnimation::AnimDataLineProcess(VecStr originallines,
                         size_t optionPosition = line.find("<!-- CONDITION ^") + 16;
                         string option         = line.substr(optionPosition,
                                                     line.find("^ -->", optionPosition) - optionPosition);
-                        AnimationUtility utility;
-
-                        if (option.find("[") == NOT_FOUND || option.find("]") == NOT_FOUND)
-                        {
-                            ErrorMessage(1153, format, behaviorFile, i + 1, option);
-                        }
 
-                        if (newCondition(option, newlines, i + 1, utility))
+                        if (option.find("[") == NOT_FOUND)
                         {
-                            skip                         = false;
-                            IsConditionOpened[condition] = true;
+                            if (format != option) skip = true;
                         }
                         else
                         {
-                            skip = true;
+                            AnimationUtility utility;
+
+                            if (newCondition(option, newlines, i + 1, utility))
+                            {
+                                skip                         = false;
+                                IsConditionOpened[condition] = true;
+                            }
+                            else
+                            {
+                                skip = true;
+                            }
+
+                            if (error) throw nemesis::exception();
                         }
                     }
                 }
@@ -3064,37 +3148,38 @@ void NewAnimation::AnimDataLineProcess(VecStr originallines,
             {
                 if (!open)
                 {
-                    string curOption = getOption(originallines[i]);
-                    bool isNot       = false;
+                    string curOption = getOption(ASDLines[i]);
 
-                    if (curOption[0] == '!')
+                    if (curOption.find("[") == NOT_FOUND)
                     {
-                        isNot     = true;
-                        curOption = curOption.substr(1);
+                        if (format != curOption)
+                            skip = true;
+                        else
+                            open = true;
                     }
-
-                    VecStr optionInfo = GetOptionInfo(
-                        curOption, format, behaviorFile, i + 1, lastOrder, groupAnimInfo, false, true, order);
-
-                    if (optionInfo[2] != "AnimObject")
+                    else
                     {
-                        if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[optionInfo[2]])
+                        bool isNot = false;
+
+                        if (curOption[0] == '!')
                         {
-                            if (isNot)
-                                skip = true;
-                            else
-                                open = true;
+                            isNot     = true;
+                            curOption = curOption.substr(1);
                         }
-                        else
+
+                        VecStr optionInfo = GetOptionInfo(curOption,
+                                                          format,
+                                                          behaviorFile,
+                                                          i + 1,
+                                                          lastOrder,
+                                                          groupAnimInfo,
+                                                          false,
+                                                          true,
+                                                          order);
+
+                        if (optionInfo[2] != "AnimObject")
                         {
-                            // clear group number
-                            string previous = optionInfo[2];
-                            string templine
-                                = nemesis::regex_replace(string(optionInfo[2]),
-                                                         nemesis::regex("[^A-Za-z\\s]*([A-Za-z\\s]+).*"),
-                                                         string("\\1"));
-
-                            if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[templine])
+                            if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[optionInfo[2]])
                             {
                                 if (isNot)
                                     skip = true;
@@ -3103,18 +3188,41 @@ void NewAnimation::AnimDataLineProcess(VecStr originallines,
                             }
                             else
                             {
-                                string ID = nemesis::regex_replace(
-                                    string(previous), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                                // clear group number
+                                string previous = optionInfo[2];
+                                string templine
+                                    = nemesis::regex_replace(string(optionInfo[2]),
+                                                             nemesis::precompiled(nemesis::pattern::first_word),
+                                                             string("\\1"));
 
-                                // animobject bypass
-                                if (previous == "AnimObject/" + ID)
+                                if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[templine])
+                                {
+                                    if (isNot)
+                                        skip = true;
+                                    else
+                                        open = true;
+                                }
+                                else
                                 {
-                                    if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[previous])
+                                    string ID = nemesis::first_number(previous);
+
+                                    // animobject bypass
+                                    if (previous == "AnimObject/" + ID)
                                     {
-                                        if (isNot)
-                                            skip = true;
+                                        if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[previous])
+                                        {
+                                            if (isNot)
+                                                skip = true;
+                                            else
+                                                open = true;
+                                        }
                                         else
-                                            open = true;
+                                        {
+                                            if (isNot)
+                                                open = true;
+                                            else
+                                                skip = true;
+                                        }
                                     }
                                     else
                                     {
@@ -3124,19 +3232,12 @@ void NewAnimation::AnimDataLineProcess(VecStr originallines,
                                             skip = true;
                                     }
                                 }
-                                else
-                                {
-                                    if (isNot)
-                                        open = true;
-                                    else
-                                        skip = true;
-                                }
                             }
                         }
-                    }
-                    else
-                    {
-                        ErrorMessage(1150, format, behaviorFile, i + 1);
+                        else
+                        {
+                            ErrorMessage(1150, format, behaviorFile, i + 1);
+                        }
                     }
                 }
                 else
@@ -3157,929 +3258,27 @@ void NewAnimation::AnimDataLineProcess(VecStr originallines,
                 if (!open)
                 {
                     string curOption = getOption(line);
-                    bool isNot       = false;
-
-                    if (curOption[0] == '!')
-                    {
-                        isNot     = true;
-                        curOption = curOption.substr(1);
-                    }
 
-                    while (true)
+                    if (curOption.find("[") == NOT_FOUND)
                     {
-                        VecStr optionInfo = GetOptionInfo(curOption,
-                                                          format,
-                                                          behaviorFile,
-                                                          i + 1,
-                                                          groupAnimInfo.size() - 1,
-                                                          groupAnimInfo,
-                                                          true,
-                                                          true,
-                                                          order);
-
-                        if (optionInfo[1].length() == 0)
+                        if (format != curOption)
+                        {
+                            skip = true;
+                        }
+                        else
                         {
-                            recorder.reserve(originallines.size() / 5);
+                            recorder.reserve(ASDLines.size() / 5);
                             open        = true;
                             multi       = true;
+                            multiOption = curOption;
                             openOrder   = -1;
-                            multiOption = optionInfo[2];
                         }
-                        else
-                        {
-                            if (!hasOptionPicked(groupOptionPicked, stoi(optionInfo[1]), optionInfo[2]))
-                            {
-                                // animobject bypass
-                                if (optionInfo[2] == "AnimObject")
-                                {
-                                    if (isNot)
-                                    {
-                                        skip = true;
-                                    }
-                                    else
-                                    {
-                                        recorder.reserve(originallines.size() / 5);
-                                        open        = true;
-                                        multi       = true;
-                                        multiOption = optionInfo[2];
-                                        openOrder   = stoi(optionInfo[1]);
-                                    }
-                                }
-                                else
-                                {
-                                    // Check if current condition accepts other options that are linked
-                                    if (isNot)
-                                    {
-                                        recorder.reserve(originallines.size() / 5);
-                                        open        = true;
-                                        multi       = true;
-                                        multiOption = optionInfo[2];
-                                        openOrder   = optionInfo[1].length() == 0 ? -1 : stoi(optionInfo[1]);
-                                    }
-                                    else
-                                    {
-                                        skip = true;
-                                    }
-                                }
-                            }
-                            else
-                            {
-                                if (isNot)
-                                {
-                                    skip = true;
-                                }
-                                else
-                                {
-                                    recorder.reserve(originallines.size() / 5);
-                                    open        = true;
-                                    multi       = true;
-                                    multiOption = optionInfo[2];
-                                    openOrder   = stoi(optionInfo[1]);
-                                }
-                            }
-                        }
-
-                        break;
-                    }
-                }
-                else
-                {
-                    ErrorMessage(1115, format, behaviorFile, i + 1);
-                }
-            }
-
-            newOpen    = true;
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- NEW ORDER ", 0) != NOT_FOUND && line.find(" -->", 0) != NOT_FOUND)
-        {
-            if (newOpen) ErrorMessage(1116, format, behaviorFile, i + 1);
-
-            if (IsConditionOpened[condition])
-            {
-                if (!open)
-                {
-                    size_t orderPosition = line.find("<!-- NEW ORDER ") + 15;
-                    string curOrder
-                        = line.substr(orderPosition, line.find(" -->", orderPosition) - orderPosition);
-                    bool isNot = false;
-
-                    if (curOrder[0] == '!')
-                    {
-                        isNot    = true;
-                        curOrder = curOrder.substr(1);
-                    }
-
-                    if (isOnlyNumber(curOrder))
-                    {
-                        if (order != stoi(curOrder))
-                        {
-                            if (!isNot) skip = true;
-                        }
-                        else if (isNot)
-                        {
-                            skip = true;
-                        }
-                    }
-                    else
-                    {
-                        bool word    = false;
-                        bool unknown = false;
-                        bool number  = false;
-
-                        for (uint j = 0; j < curOrder.size(); ++j)
-                        {
-                            if (isalpha(curOrder[j]))
-                                word = true;
-                            else if (isdigit(curOrder[j]))
-                                number = true;
-                            else
-                                unknown = true;
-                        }
-
-                        if (word & number)
-                        {
-                            ErrorMessage(1110, format, behaviorFile, i + 1);
-                        }
-                        else if (unknown)
-                        {
-                            ErrorMessage(1111, format, behaviorFile, i + 1);
-                        }
-                        else if (word)
-                        {
-                            if (nemesis::iequals(curOrder, "last"))
-                            {
-                                if (!isLastOrder)
-                                {
-                                    if (!isNot) skip = true;
-                                }
-                                else if (isNot)
-                                {
-                                    skip = true;
-                                }
-                            }
-                            else if (nemesis::iequals(curOrder, "first"))
-                            {
-                                if (order != 0)
-                                {
-                                    if (!isNot) skip = true;
-                                }
-                                else if (isNot)
-                                {
-                                    skip = true;
-                                }
-                            }
-                            else
-                            {
-                                ErrorMessage(1112, format, behaviorFile, i + 1);
-                            }
-                        }
-                        else
-                        {
-                            ErrorMessage(1113, format, behaviorFile, i + 1);
-                        }
-                    }
-                }
-                else
-                {
-                    ErrorMessage(1114, format, behaviorFile, i + 1);
-                }
-            }
-
-            newOpen    = true;
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- CLOSE -->", 0) != NOT_FOUND)
-        {
-            if (!newOpen) ErrorMessage(1171, format, behaviorFile, i + 1);
-
-            newOpen    = false;
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- CONDITION END -->", 0) != NOT_FOUND && !multi)
-        {
-            uniqueskip = true;
-        }
-
-        if (error) throw nemesis::exception();
-
-        if (!skip && !uniqueskip && !freeze)
-        {
-            while (true)
-            {
-                if (multi)
-                {
-                    recorder.push_back(line);
-                    break;
-                }
-
-                if (line.find("$") != NOT_FOUND)
-                {
-                    // set animation ID
-                    while (line.find("$%$", 0) != NOT_FOUND)
-                    {
-                        line.replace(line.find("$%$"), 3, to_string(furnitureCount));
-                    }
-
-                    // multi choice selection
-                    if (line.find("$MC$", 0) != NOT_FOUND)
-                    {
-                        AnimationUtility utility;
-                        multiChoice(line, newlines, i + 1, utility);
-                    }
-
-                    ID emptyID;
-                    vector<int> emptyVI;
-                    processing(line, newlines, format, i + 1, emptyID, emptyID, emptyVI, ASD, false);
-                    line = linebreakSeparator(line, newlines);
-
-                    if (line.length() == 0) ErrorMessage(1172, format, behaviorFile, i + 1);
-                }
-
-                if (error) throw nemesis::exception();
-
-                newlines.push_back(line);
-                break;
-            }
-
-            if (error) throw nemesis::exception();
-        }
-
-        if (line.find("<!-- CLOSE -->", 0) != NOT_FOUND && IsConditionOpened[condition])
-        {
-            if (skip)
-            {
-                skip = false;
-            }
-            else
-            {
-                if (multi)
-                {
-                    int size;
-                    bool skip2   = false;
-                    bool freeze2 = false;
-
-                    if (openOrder == -2)
-                    {
-                        openOrder = 0;
-                        size      = 1;
-                    }
-                    else if (openOrder == -1)
-                    {
-                        openOrder = 0;
-                        size      = int(groupAnimInfo.size());
-                    }
-                    else
-                    {
-                        size = openOrder + 1;
-                    }
-
-                    for (int animMulti = openOrder; animMulti < size; ++animMulti)
-                    {
-                        for (int optionMulti = 0;
-                             optionMulti < groupAnimInfo[animMulti]->optionPickedCount[multiOption];
-                             ++optionMulti)
-                        {
-                            for (uint k = 0; k < recorder.size(); ++k)
-                            {
-                                bool uniqueskip2 = false;
-                                string newline   = recorder[k];
-
-                                if (newline.find("<!-- CONDITION START ^", 0) != NOT_FOUND)
-                                {
-                                    condition++;
-
-                                    if (!freeze2)
-                                    {
-                                        if (!IsConditionOpened[condition])
-                                        {
-                                            if (isPassed(condition, IsConditionOpened))
-                                            {
-                                                size_t optionPosition
-                                                    = newline.find("<!-- CONDITION START ^") + 22;
-                                                string conditionLine = newline.substr(
-                                                    optionPosition,
-                                                    newline.find("^ -->", optionPosition) - optionPosition);
-                                                AnimationUtility utility;
-                                                utility.animMulti = animMulti;
-
-                                                if (conditionLine.find("[") == NOT_FOUND
-                                                    || conditionLine.find("]") == NOT_FOUND)
-                                                {
-                                                    ErrorMessage(
-                                                        1153, format, behaviorFile, i + 1, conditionLine);
-                                                }
-
-                                                if (newCondition(conditionLine, newlines, i + 1, utility))
-                                                {
-                                                    skip2                        = false;
-                                                    IsConditionOpened[condition] = true;
-                                                }
-                                                else
-                                                {
-                                                    skip2 = true;
-                                                }
-                                            }
-                                        }
-                                        else
-                                        {
-                                            skip2   = true;
-                                            freeze2 = true;
-                                        }
-                                    }
-
-                                    uniqueskip2 = true;
-                                }
-                                else if (newline.find("<!-- CONDITION ^", 0) != NOT_FOUND)
-                                {
-                                    if (condition == 0) ErrorMessage(1119, format, behaviorFile, i + 1);
-
-                                    if (!freeze2)
-                                    {
-                                        if (!IsConditionOpened[condition])
-                                        {
-                                            if (isPassed(condition, IsConditionOpened))
-                                            {
-                                                size_t optionPosition = newline.find("<!-- CONDITION ^") + 16;
-                                                string option         = newline.substr(
-                                                    optionPosition,
-                                                    newline.find("^ -->", optionPosition) - optionPosition);
-                                                AnimationUtility utility;
-                                                utility.animMulti = animMulti;
-
-                                                if (option.find("[") == NOT_FOUND
-                                                    || option.find("]") == NOT_FOUND)
-                                                {
-                                                    ErrorMessage(1153, format, behaviorFile, i + 1, option);
-                                                }
-
-                                                if (newCondition(option, newlines, i + 1, utility))
-                                                {
-                                                    skip2                        = false;
-                                                    IsConditionOpened[condition] = true;
-                                                }
-                                                else
-                                                {
-                                                    skip2 = true;
-                                                }
-                                            }
-                                        }
-                                        else
-                                        {
-                                            skip2   = true;
-                                            freeze2 = true;
-                                        }
-                                    }
-
-                                    uniqueskip2 = true;
-                                }
-                                else if (newline.find("<!-- CONDITION -->", 0) != NOT_FOUND)
-                                {
-                                    if (condition == 0) ErrorMessage(1119, format, behaviorFile, i + 1);
-
-                                    if (!freeze2)
-                                    {
-                                        if (!IsConditionOpened[condition])
-                                        {
-                                            if (isPassed(condition, IsConditionOpened))
-                                            {
-                                                skip2                        = false;
-                                                IsConditionOpened[condition] = true;
-                                                uniqueskip2                  = true;
-                                                size_t conditionPosition
-                                                    = newline.find("<!-- CONDITION") + 14;
-                                                string replacement1
-                                                    = newline.substr(0, conditionPosition + 1);
-                                                string replacement2 = newline.substr(conditionPosition);
-                                                newlines.push_back(replacement1 + "START" + replacement2);
-                                            }
-                                            else
-                                            {
-                                                skip2 = true;
-                                            }
-                                        }
-                                        else
-                                        {
-                                            skip2   = true;
-                                            freeze2 = true;
-                                        }
-                                    }
-
-                                    uniqueskip2 = true;
-                                }
-                                else if (newline.find("<!-- CONDITION END -->", 0) != NOT_FOUND)
-                                {
-                                    uniqueskip2 = true;
-                                }
-
-                                if (error) throw nemesis::exception();
-
-                                if (!skip2 && !uniqueskip2 && !freeze2)
-                                {
-                                    if (newline.find("$") != NOT_FOUND)
-                                    {
-                                        // set animation ID
-                                        while (newline.find("$%$", 0) != NOT_FOUND)
-                                        {
-                                            newline.replace(
-                                                newline.find("$%$"), 3, to_string(furnitureCount));
-                                        }
-
-                                        // multi choice selection
-                                        if (newline.find("$MC$", 0) != NOT_FOUND)
-                                        {
-                                            ID emptyID;
-                                            vector<int> emptyVI;
-                                            AnimationUtility utility(newline,
-                                                                     emptyID,
-                                                                     emptyID,
-                                                                     emptyVI,
-                                                                     ASD,
-                                                                     false,
-                                                                     optionMulti,
-                                                                     animMulti,
-                                                                     multiOption);
-                                            multiChoice(newline, newlines, i + 1, utility);
-                                        }
-                                    }
-
-                                    while (newline.find("%", 0) != NOT_FOUND)
-                                    {
-                                        newline.replace(newline.find("%", 0), 1, to_string(optionMulti));
-                                    }
-
-                                    if (newline.find("$") != NOT_FOUND)
-                                    {
-                                        ID emptyID;
-                                        vector<int> emptyVI;
-                                        processing(newline,
-                                                   newlines,
-                                                   format,
-                                                   i + 1 - int(recorder.size()) + k,
-                                                   emptyID,
-                                                   emptyID,
-                                                   emptyVI,
-                                                   ASD,
-                                                   false,
-                                                   optionMulti,
-                                                   animMulti);
-                                        newline = linebreakSeparator(newline, newlines);
-
-                                        if (newline.length() == 0)
-                                        {
-                                            ErrorMessage(1172, format, behaviorFile, i + 1);
-                                        }
-                                    }
-
-                                    size_t pos = newline.find("(");
-
-                                    if (pos != NOT_FOUND && newline.find(")", pos) != NOT_FOUND)
-                                    {
-                                        string templine = newline.substr(pos);
-                                        int nextpos
-                                            = openEndBracket(templine, '(', ')', format, behaviorFile, i + 1)
-                                              + 1;
-                                        templine       = templine.substr(0, nextpos);
-                                        string oldline = templine;
-                                        nemesis::calculate(templine, format, behaviorFile, i + 1);
-
-                                        if (oldline != templine)
-                                            newline.replace(pos, oldline.length(), templine);
-                                    }
-
-                                    if (error) throw nemesis::exception();
-
-                                    newlines.push_back(newline);
-                                }
-
-                                if (newline.find("<!-- CONDITION END -->", 0) != NOT_FOUND)
-                                {
-                                    if (condition == 0) ErrorMessage(1118, format, behaviorFile, i + 1);
-
-                                    if (freeze2 && IsConditionOpened[condition]) freeze2 = false;
-
-                                    skip2                        = !isPassed(condition, IsConditionOpened);
-                                    IsConditionOpened[condition] = false;
-                                    condition--;
-
-                                    if (error) throw nemesis::exception();
-                                }
-                            }
-                        }
-                    }
-
-                    multiOption.clear();
-                    openOrder = -2;
-                }
-
-                recorder.clear();
-            }
-
-            multi = false;
-            open  = false;
-        }
-        else if (line.find("<!-- CONDITION END -->", 0) != NOT_FOUND && !multi)
-        {
-            if (condition == 0) ErrorMessage(1118, format, behaviorFile, i + 1);
-
-            if (freeze && IsConditionOpened[condition]) freeze = false;
-
-            skip                         = !isPassed(condition, IsConditionOpened);
-            IsConditionOpened[condition] = false;
-            condition--;
-        }
-    }
-
-    if (error) throw nemesis::exception();
-
-    IsConditionOpened[0] = false;
-
-    if (newOpen) ErrorMessage(1116, format, behaviorFile, originallines.size());
-
-    for (auto itera = IsConditionOpened.begin(); itera != IsConditionOpened.end(); ++itera)
-    {
-        if (itera->second) ErrorMessage(1145, format, behaviorFile);
-    }
-
-    if (condition != 0) ErrorMessage(1122, format, behaviorFile);
-
-    if (ASD[0] == 0)
-    {
-        if (newlines.back().length() != 0) newlines.push_back("");
-    }
-    else if (newlines.back().length() == 0)
-    {
-        newlines.pop_back();
-    }
-
-    newlines.shrink_to_fit();
-}
-
-void NewAnimation::AnimDataLineProcess(AnimTemplate* originaltemplate,
-                                       shared_ptr<VecStr> generatedlines,
-                                       string format,
-                                       string project,
-                                       string header,
-                                       vector<int> ASD)
-{
-    int counter     = 0;
-    bool negative   = false;
-    bool norElement = false;
-    int openRange   = 0;
-    size_t elementLine;
-
-    generatedlines->reserve(originaltemplate->size + 10 * memory);
-
-    ID tmpId;
-    ID tmpId2;
-
-    std::vector<int> fixedStateID;
-    std::vector<int> stateCountMultiplier;
-
-    AnimThreadInfo animThrInfo(filepath,
-                               filename,
-                               mainAnimEvent,
-                               zeroEvent,
-                               zeroVariable,
-                               false,
-                               negative,
-                               isEnd,
-                               norElement,
-                               elementCatch,
-                               hasDuration,
-                               duration,
-                               openRange,
-                               counter,
-                               elementLine,
-                               furnitureCount,
-                               tmpId,
-                               tmpId2,
-                               fixedStateID,
-                               stateCountMultiplier,
-                               order,
-                               lastOrder,
-                               IDExist,
-                               AnimObject,
-                               addition,
-                               newImport,
-                               groupAddition,
-                               groupOptionPicked,
-                               std::vector<std::vector<std::unordered_map<std::string, bool>>>(),
-                               nullptr,
-                               generatedlines,
-                               this,
-                               nullptr);
-    animThrInfo.project = project;
-    animThrInfo.header  = header;
-
-    OutputCheck(generatedlines,
-                animThrInfo,
-                originaltemplate->process,
-                &originaltemplate->lines,
-                norElement,
-                openRange,
-                elementLine,
-                counter,
-                tmpId,
-                tmpId2,
-                vector<int>(),
-                vector<int>(),
-                false,
-                negative,
-                nullptr);
-}
-
-void NewAnimation::existingASDProcess(VecStr ASDLines, map<int, VecStr>& extract, vector<int> ASD)
-{
-    unordered_map<int, bool> IsConditionOpened;
-    auto optPickPtr = (std::vector<unordered_map<string, bool>>*) &groupOptionPicked;
-    optPickPtr->reserve(groupAnimInfo.size());
-
-    for (unsigned int i = 0; i < groupAnimInfo.size(); ++i)
-    {
-        optPickPtr->push_back(groupAnimInfo[i]->optionPicked);
-    }
-
-    VecStr store;
-    VecStr recorder;
-    bool skip         = false; // mainly used by NEW
-    bool freeze       = false; // mainly used by CONDITION to freeze following CONDITION
-    bool open         = false;
-    bool multi        = false;
-    bool newOpen      = false;
-    bool openStore    = false;
-    int openOrder     = -2;
-    int condition     = 0;
-    int curExtract    = -1;
-    __int64 openRange = 0;
-    __int64 counter   = 0;
-    string multiOption;
-    IsConditionOpened[0] = true;
-
-    VecStr newlines;
-    newlines.reserve(ASDLines.size() + 10 * memory);
-    string line;
-
-    for (uint i = 0; i < ASDLines.size(); ++i)
-    {
-        line            = ASDLines[i];
-        bool uniqueskip = false;
-
-        if (line.find("<!-- CONDITION START ^", 0) != NOT_FOUND && !multi)
-        {
-            condition++;
-
-            if (!freeze)
-            {
-                if (!IsConditionOpened[condition])
-                {
-                    if (isPassed(condition, IsConditionOpened))
-                    {
-                        size_t optionPosition = line.find("<!-- CONDITION START ^") + 22;
-                        string conditionLine  = line.substr(
-                            optionPosition, line.find("^ -->", optionPosition) - optionPosition);
-
-                        if (conditionLine.find("[") == NOT_FOUND)
-                        {
-                            if (format != conditionLine) skip = true;
-                        }
-                        else
-                        {
-                            AnimationUtility utility;
-
-                            if (newCondition(conditionLine, newlines, i + 1, utility))
-                            {
-                                skip                         = false;
-                                IsConditionOpened[condition] = true;
-                            }
-                            else
-                            {
-                                skip = true;
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    skip   = true;
-                    freeze = true;
-                }
-            }
-
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- CONDITION ^", 0) != NOT_FOUND && !multi)
-        {
-            if (condition == 0) ErrorMessage(1119, format, behaviorFile, i + 1);
-
-            if (!freeze)
-            {
-                if (!IsConditionOpened[condition])
-                {
-                    if (isPassed(condition, IsConditionOpened))
-                    {
-                        size_t optionPosition = line.find("<!-- CONDITION ^") + 16;
-                        string option         = line.substr(optionPosition,
-                                                    line.find("^ -->", optionPosition) - optionPosition);
-
-                        if (option.find("[") == NOT_FOUND)
-                        {
-                            if (format != option) skip = true;
-                        }
-                        else
-                        {
-                            AnimationUtility utility;
-
-                            if (newCondition(option, newlines, i + 1, utility))
-                            {
-                                skip                         = false;
-                                IsConditionOpened[condition] = true;
-                            }
-                            else
-                            {
-                                skip = true;
-                            }
-
-                            if (error) throw nemesis::exception();
-                        }
-                    }
-                }
-                else
-                {
-                    skip   = true;
-                    freeze = true;
-                }
-            }
-
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- CONDITION -->", 0) != NOT_FOUND && !multi)
-        {
-            if (condition == 0) ErrorMessage(1119, format, behaviorFile, i + 1);
-
-            if (!freeze)
-            {
-                if (!IsConditionOpened[condition])
-                {
-                    if (isPassed(condition, IsConditionOpened))
-                    {
-                        skip                         = false;
-                        IsConditionOpened[condition] = true;
-                    }
-                    else
-                    {
-                        skip = true;
-                    }
-                }
-                else
-                {
-                    skip   = true;
-                    freeze = true;
-                }
-            }
-
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- NEW ^", 0) != NOT_FOUND && line.find("^ -->", 0) != NOT_FOUND)
-        {
-            if (newOpen) ErrorMessage(1116, format, behaviorFile, i + 1);
-
-            if (IsConditionOpened[condition])
-            {
-                if (!open)
-                {
-                    string curOption = getOption(ASDLines[i]);
-
-                    if (curOption.find("[") == NOT_FOUND)
-                    {
-                        if (format != curOption)
-                            skip = true;
-                        else
-                            open = true;
-                    }
-                    else
-                    {
-                        bool isNot = false;
-
-                        if (curOption[0] == '!')
-                        {
-                            isNot     = true;
-                            curOption = curOption.substr(1);
-                        }
-
-                        VecStr optionInfo = GetOptionInfo(curOption,
-                                                          format,
-                                                          behaviorFile,
-                                                          i + 1,
-                                                          lastOrder,
-                                                          groupAnimInfo,
-                                                          false,
-                                                          true,
-                                                          order);
-
-                        if (optionInfo[2] != "AnimObject")
-                        {
-                            if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[optionInfo[2]])
-                            {
-                                if (isNot)
-                                    skip = true;
-                                else
-                                    open = true;
-                            }
-                            else
-                            {
-                                // clear group number
-                                string previous = optionInfo[2];
-                                string templine
-                                    = nemesis::regex_replace(string(optionInfo[2]),
-                                                             nemesis::regex("[^A-Za-z\\s]*([A-Za-z\\s]+).*"),
-                                                             string("\\1"));
-
-                                if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[templine])
-                                {
-                                    if (isNot)
-                                        skip = true;
-                                    else
-                                        open = true;
-                                }
-                                else
-                                {
-                                    string ID = nemesis::regex_replace(
-                                        string(previous), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
-
-                                    // animobject bypass
-                                    if (previous == "AnimObject/" + ID)
-                                    {
-                                        if (groupAnimInfo[stoi(optionInfo[1])]->optionPicked[previous])
-                                        {
-                                            if (isNot)
-                                                skip = true;
-                                            else
-                                                open = true;
-                                        }
-                                        else
-                                        {
-                                            if (isNot)
-                                                open = true;
-                                            else
-                                                skip = true;
-                                        }
-                                    }
-                                    else
-                                    {
-                                        if (isNot)
-                                            open = true;
-                                        else
-                                            skip = true;
-                                    }
-                                }
-                            }
-                        }
-                        else
-                        {
-                            ErrorMessage(1150, format, behaviorFile, i + 1);
-                        }
-                    }
-                }
-                else
-                {
-                    ErrorMessage(1116, format, behaviorFile, i + 1);
-                }
-            }
-
-            newOpen    = true;
-            uniqueskip = true;
-        }
-        else if (line.find("<!-- FOREACH ^", 0) != NOT_FOUND)
-        {
-            if (newOpen) ErrorMessage(1116, format, behaviorFile, i + 1);
-
-            if (IsConditionOpened[condition])
-            {
-                if (!open)
-                {
-                    string curOption = getOption(line);
-
-                    if (curOption.find("[") == NOT_FOUND)
-                    {
-                        if (format != curOption)
-                        {
-                            skip = true;
-                        }
-                        else
-                        {
-                            recorder.reserve(ASDLines.size() / 5);
-                            open        = true;
-                            multi       = true;
-                            multiOption = curOption;
-                            openOrder   = -1;
-                        }
-                    }
-                    else
-                    {
-                        bool isNot = false;
-
-                        if (curOption[0] == '!')
+                    }
+                    else
+                    {
+                        bool isNot = false;
+
+                        if (curOption[0] == '!')
                         {
                             isNot     = true;
                             curOption = curOption.substr(1);
@@ -4720,7 +3919,7 @@ void motionDataReplacer(string& change,
     if (change.find(format + "[", 0) != NOT_FOUND)
     {
         string number
-            = nemesis::regex_replace(string(change), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+            = nemesis::first_number(change);
 
         if (change.find(format + "[" + number + "][MD]", 0) != NOT_FOUND && isOnlyNumber(number))
         {
@@ -4864,7 +4063,7 @@ void rotationDataReplacer(string& change,
     if (change.find(format + "[", 0) != NOT_FOUND)
     {
         string number
-            = nemesis::regex_replace(string(change), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+            = nemesis::first_number(change);
 
         if (change.find(format + "[" + number + "][RD]", 0) != NOT_FOUND && isOnlyNumber(number))
         {
@@ -5002,17 +4201,12 @@ void NewAnimation::OutputCheck(shared_ptr<VecStr> generatedlines,
         bool hasProcess = false;
         elementCatch    = false;
         string line;
-        VecStr lineblocks;
 
         if (curstack.nestedcond.size() == 0)
         {
             hasProcess = curstack.hasProcess;
 
-            if (hasProcess)
-            {
-                lineblocks = curstack.lineblocks;
-            }
-            else
+            if (!hasProcess)
             {
                 line = *curstack.raw;
             }
@@ -5272,7 +4466,7 @@ void NewAnimation::OutputCheck(shared_ptr<VecStr> generatedlines,
             {
                 animThrInfo.numline = curstack.linecount;
                 animThrInfo.line    = &line;
-                process.blocksCompile(lineblocks, animThrInfo);
+                process.blocksCompile(curstack.lineblocks, animThrInfo);
 
                 if (error) throw nemesis::exception();
             }
@@ -5416,8 +4610,7 @@ void NewAnimation::hasProcessing(string& line,
             for (int k = 0; k < counter; ++k)
             {
                 pos       = line.find(format + "_group$", pos + 1);
-                string ID = nemesis::regex_replace(
-                    string(line.substr(pos)), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                string ID = nemesis::first_number(string(line.substr(pos)));
                 string oldID  = "MID$" + ID;
                 size_t newpos = line.find(format + "_group$" + ID, pos);
 
@@ -5427,6 +4620,8 @@ void NewAnimation::hasProcessing(string& line,
 
                     if (groupFunction->functionIDs.find(oldID) != groupFunction->functionIDs.end())
                     {
+                        if (idJournal) idJournal->touch(groupFunction->functionIDs[oldID]);
+
                         line.replace(
                             pos, format.length() + 7 + ID.length(), groupFunction->functionIDs[oldID]);
                     }
@@ -5448,8 +4643,7 @@ void NewAnimation::hasProcessing(string& line,
             for (int k = 0; k < counter; ++k)
             {
                 size_t MIDposition = line.find("MID$");
-                string ID          = nemesis::regex_replace(
-                    string(line.substr(MIDposition)), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                string ID          = nemesis::first_number(string(line.substr(MIDposition)));
                 string oldID = "MID$" + ID;
 
                 if (line.find(oldID, MIDposition) != NOT_FOUND)
@@ -0,0 +1,136 @@
+#include "generate/animation/nodeidledger.h"
+#include "generate/animation/templatetree.h"
+
+using namespace std;
+
+nemesis::NodeIDJournal::NodeIDJournal(NodeIDLedger* _ledger)
+{
+    ledger = _ledger;
+}
+
+string nemesis::NodeIDJournal::newID()
+{
+    size_t index = ledger->counter++;
+    touched.push_back(index);
+    return ledger->placeholder(index);
+}
+
+void nemesis::NodeIDJournal::touch(const string& strID)
+{
+    if (strID.length() < 3 || strID.front() != NodeIDLedger::mark || strID.back() != NodeIDLedger::mark) return;
+
+    touched.push_back(stoul(strID.substr(1, strID.length() - 2)));
+}
+
+string nemesis::NodeIDLedger::placeholder(size_t index) const
+{
+    return mark + to_string(index) + mark;
+}
+
+string nemesis::NodeIDLedger::take(int& lastID)
+{
+    string strID = toID(lastID++);
+
+    if (lastID == 9216) ++lastID;
+
+    return strID;
+}
+
+string nemesis::NodeIDLedger::toID(int nodeID)
+{
+    string strID = to_string(nodeID);
+
+    while (strID.length() < 4)
+    {
+        strID = "0" + strID;
+    }
+
+    return strID;
+}
+
+nemesis::NodeIDJournal* nemesis::NodeIDLedger::addJob()
+{
+    journals.emplace_back(new NodeIDJournal(this));
+    return journals.back().get();
+}
+
+void nemesis::NodeIDLedger::resolve(int& lastID)
+{
+    resolved = VecStr(counter.load());
+
+    for (auto& journal : journals)
+    {
+        for (size_t index : journal->touched)
+        {
+            string& strID = resolved[index];
+
+            if (strID.length() > 0) continue;
+
+            strID = take(lastID);
+        }
+    }
+}
+
+void nemesis::NodeIDLedger::patch(string& line) const
+{
+    size_t pos = line.find(mark);
+
+    while (pos != string::npos)
+    {
+        size_t end = line.find(mark, pos + 1);
+
+        if (end == string::npos) return;
+
+        const string& strID = resolved[stoul(line.substr(pos + 1, end - pos - 1))];
+        line.replace(pos, end - pos + 1, strID);
+        pos = line.find(mark, pos + strID.length());
+    }
+}
+
+void nemesis::NodeIDLedger::patch(VecStr& lines) const
+{
+    for (auto& line : lines)
+    {
+        patch(line);
+    }
+}
+
+void nemesis::NodeIDLedger::patch(master& functionIDs) const
+{
+    for (auto& each : functionIDs.functionIDs)
+    {
+        patch(each.second);
+    }
+
+    for (auto& groupID : functionIDs.grouplist)
+    {
+        for (auto& each : groupID->functionIDs)
+        {
+            patch(each.second);
+        }
+
+        for (auto& singleID : groupID->singlelist)
+        {
+            for (auto& each : singleID->format)
+            {
+                patch(each.second);
+            }
+        }
+    }
+}
+
+void nemesis::NodeIDLedger::patch(SSMap& IDExist) const
+{
+    for (auto& each : IDExist)
+    {
+        patch(each.second);
+    }
+}
+
+void nemesis::NodeIDLedger::patch(ImportContainer& exportID) const
+{
+    for (auto& file : exportID)
+    {
+        patch(file.second);
+    }
+}
@@ -9,6 +9,7 @@
 
 #include "generate/animation/animationinfo.h"
 #include "generate/animation/nodejoint.h"
+#include "generate/animation/nodeidledger.h"
 #include "generate/animation/templatetree.h"
 
 using namespace std;
@@ -16,7 +17,7 @@ using namespace std;
 bool newCondition(string condition,
                   string filename,
                   vector<vector<unordered_map<string, bool>>> optionPicked,
-                  vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                  const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                   int numline,
                   string format,
                   string masterformat,
@@ -25,7 +26,7 @@ VecStr GetOptionInfo(string line,
                      string format,
                      string filename,
                      int numline,
-                     vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                     const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                      bool allowNoFixAnim,
                      bool isCondition,
                      int groupMulti     = -1,
@@ -38,7 +39,7 @@ int formatGroupReplace(string& curline,
                        string filename,
                        string format,
                        shared_ptr<master> subFunctionIDs,
-                       vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                       const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                        int linecount,
                        int groupMulti,
                        int optionMulti,
@@ -61,7 +62,7 @@ void CRC32Replacer(string& line, string format, string behaviorFile, int linecou
 void multiChoice(string& line,
                  string filename,
                  vector<vector<unordered_map<string, bool>>> masterOptionPicked,
-                 vector<vector<shared_ptr<AnimationInfo>>> groupAnimInfo,
+                 const vector<vector<shared_ptr<AnimationInfo>>>& groupAnimInfo,
                  int numline,
                  string format,
                  string masterformat,
@@ -81,8 +82,8 @@ void processing(string& line,
                 shared_ptr<master> subFunctionIDs,
                 ImportContainer& import,
                 int linecount,
-                ID eventid,
-                ID variableid,
+                const ID& eventid,
+                const ID& variableid,
                 string zeroEvent,
                 string zeroVariable,
                 int groupMulti,
@@ -107,8 +108,8 @@ void processing2(string& line,
                  shared_ptr<master> subFunctionIDs,
                  ImportContainer& import,
                  int linecount,
-                 ID eventid,
-                 ID variableid,
+                 const ID& eventid,
+                 const ID& variableid,
                  string zeroEvent,
                  string zeroVariable,
                  int groupMulti,
@@ -154,8 +155,8 @@ NodePackedParameters::NodePackedParameters(string _format,
                                            shared_ptr<master> _subFunctionIDs,
                                            ImportContainer& _import,
                                            int _linecount,
-                                           ID _eventid,
-                                           ID _variableid,
+                                           const ID& _eventid,
+                                           const ID& _variableid,
                                            string _zeroEvent,
                                            string _zeroVariable,
                                            int _groupMulti,
@@ -174,6 +175,8 @@ NodePackedParameters::NodePackedParameters(string _format,
     , groupAnimInfo(_groupAnimInfo)
     , IDExist(_IDExist)
     , import(_import)
+    , eventid(_eventid)
+    , variableid(_variableid)
     , optionPicked(_optionPicked)
     , openRange(_openRange)
     , elementCount(_elementCount)
@@ -186,8 +189,6 @@ NodePackedParameters::NodePackedParameters(string _format,
     behaviorFile   = _behaviorFile;
     subFunctionIDs = _subFunctionIDs;
     linecount      = _linecount;
-    eventid        = _eventid;
-    variableid     = _variableid;
     zeroEvent      = _zeroEvent;
     zeroVariable   = _zeroVariable;
     groupMulti     = _groupMulti;
@@ -257,8 +258,8 @@ void NodeJoint::insertData(string format,
                            string& strID,
                            SSMap& IDExist,
                            ImportContainer& import,
-                           ID eventid,
-                           ID variableid,
+                           const ID& eventid,
+                           const ID& variableid,
                            string zeroEvent,
                            string zeroVariable,
                            unsigned __int64& openRange,
@@ -841,8 +842,8 @@ void NodeJoint::forEachProcess(vector<vector<LineCheck>>& output,
                                string& strID,
                                SSMap& IDExist,
                                ImportContainer& import,
-                               ID eventid,
-                               ID variableid,
+                               const ID& eventid,
+                               const ID& variableid,
                                string zeroEvent,
                                string zeroVariable,
                                unsigned __int64 openRange,
@@ -1339,8 +1340,8 @@ void NodeJoint::optionMultiLoop(vector<LineCheck>& output,
                                 string& strID,
                                 SSMap& IDExist,
                                 ImportContainer& import,
-                                ID eventid,
-                                ID variableid,
+                                const ID& eventid,
+                                const ID& variableid,
                                 string zeroEvent,
                                 string zeroVariable,
                                 unsigned __int64 openRange,
@@ -1738,8 +1739,8 @@ void processing(string& lineRef,
                 shared_ptr<master> subFunctionIDs,
                 ImportContainer& import,
                 int linecount,
-                ID eventid,
-                ID variableid,
+                const ID& eventid,
+                const ID& variableid,
                 string zeroEvent,
                 string zeroVariable,
                 int groupMulti,
@@ -1835,7 +1836,7 @@ void processing(string& lineRef,
                 nextpos       = line.find("#" + format + "$", nextpos) + 1;
                 string tempID = line.substr(nextpos);
                 string curID
-                    = nemesis::regex_replace(string(tempID), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    = nemesis::first_number(tempID);
                 curID = format + "$" + curID;
 
                 if (tempID.find(curID, 0) != NOT_FOUND && nextpos == line.find(curID))
@@ -1860,7 +1861,7 @@ void processing(string& lineRef,
                 nextpos       = line.find("#" + multiOption, nextpos) + 1;
                 string tempID = line.substr(nextpos);
                 string curID
-                    = nemesis::regex_replace(string(tempID), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    = nemesis::first_number(tempID);
                 curID = multiOption + "$" + curID;
 
                 if (tempID.find(curID, 0) != NOT_FOUND && nextpos == line.find(curID))
@@ -1883,7 +1884,7 @@ void processing(string& lineRef,
                 nextpos       = line.find("#" + multiOption, nextpos) + 1;
                 string tempID = line.substr(nextpos);
                 string curID
-                    = nemesis::regex_replace(string(tempID), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    = nemesis::first_number(tempID);
                 curID = multiOption + "$" + curID;
 
                 if (tempID.find(curID, 0) != NOT_FOUND && nextpos == line.find(curID))
@@ -1941,8 +1942,8 @@ void processing2(string& line,
                  shared_ptr<master> subFunctionIDs,
                  ImportContainer& import,
                  int linecount,
-                 ID eventid,
-                 ID variableid,
+                 const ID& eventid,
+                 const ID& variableid,
                  string zeroEvent,
                  string zeroVariable,
                  int groupMulti,
@@ -1985,14 +1986,11 @@ void processing2(string& line,
 
                         if (equation.find("(S", 0) != NOT_FOUND)
                         {
-                            ID = nemesis::regex_replace(
-                                string(equation), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                            ID = nemesis::first_number(equation);
 
                             if (change.find("(S" + ID + "+") == NOT_FOUND) ID = "";
 
-                            number = nemesis::regex_replace(string(equation.substr(3 + ID.length())),
-                                                          nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                          string("\\1"));
+                            number = nemesis::first_number(string(equation.substr(3 + ID.length())));
                         }
 
                         if (equation != "(S" + ID + "+" + number + ")")
@@ -2079,9 +2077,7 @@ void processing2(string& line,
                         if (change.find(format + "[", 0) != NOT_FOUND)
                         {
                             string number
-                                = nemesis::regex_replace(string(change.substr(change.find(format + "[", 0))),
-                                                       nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                       string("\\1"));
+                                = nemesis::first_number(string(change.substr(change.find(format + "[", 0))));
 
                             if (change.find(format + "[" + number + "][FilePath]", 0) != NOT_FOUND)
                             {
@@ -2144,9 +2140,7 @@ void processing2(string& line,
                         if (change.find(format + "[", 0) != NOT_FOUND)
                         {
                             string number
-                                = nemesis::regex_replace(string(change.substr(change.find(format + "[", 0))),
-                                                       nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                       string("\\1"));
+                                = nemesis::first_number(string(change.substr(change.find(format + "[", 0))));
 
                             if (change.find(format + "[" + number + "][FileName]", 0) != NOT_FOUND)
                             {
@@ -2632,16 +2626,10 @@ void processing2(string& line,
     }
 }
 
+// strID holds the ID to hand out next, which is used up now. Existing nodes are joined on the thread of the
+// behavior file once its template jobs are done and their ledgers resolved, so nextFunctionID is final here
 void newID(int& nextFunctionID, string& strID)
 {
-    ++nextFunctionID;
-
-    if (nextFunctionID == 9216) ++nextFunctionID;
-
-    strID = to_string(nextFunctionID);
-
-    while (strID.length() < 4)
-    {
-        strID = "0" + strID;
-    }
+    nemesis::NodeIDLedger::take(nextFunctionID);
+    strID = nemesis::NodeIDLedger::toID(nextFunctionID);
 }
@@ -136,8 +136,7 @@ OptionList::OptionList(string filepath, string format)
                     if (!stateDone)
                     {
                         string startState         = AnimInfo[1];
-                        string filteredStartState = nemesis::regex_replace(
-                            string(startState), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                        string filteredStartState = nemesis::first_number(startState);
 
                         if (startState == filteredStartState)
                             startStateID = filteredStartState;
@@ -157,8 +156,7 @@ OptionList::OptionList(string filepath, string format)
 
                     if (!minDone)
                     {
-                        string number = nemesis::regex_replace(
-                            string(AnimInfo[1]), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                        string number = nemesis::first_number(AnimInfo[1]);
 
                         if (strline.find(AnimInfo[0] + " " + number) != NOT_FOUND)
                         {
@@ -584,8 +582,7 @@ OptionList::OptionList(string filepath, string format)
                 }
                 else
                 {
-                    string ID = nemesis::regex_replace(
-                        string(lower), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    string ID = nemesis::first_number(lower);
 
                     if (AnimInfo[0] == "S" + ID)
                     {
@@ -600,14 +597,13 @@ OptionList::OptionList(string filepath, string format)
                             ErrorMessage(1070, format, filepath, linecount);
                         }
 
-                        string functionID = nemesis::regex_replace(
-                            string(AnimInfo[2]), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                        string functionID = nemesis::first_number(AnimInfo[2]);
 
                         if (AnimInfo[2] != "#" + functionID) ErrorMessage(1071, format, filepath, linecount);
 
-                        if (behaviorPath[nemesis::transform_to<wstring>(nemesis::to_lower_copy(AnimInfo[1]))]
-                                .length()
-                            == 0)
+                        auto path = nemesis::find_key(behaviorPath, AnimInfo[1]);
+
+                        if (path == behaviorPath.end() || path->second.length() == 0)
                         {
                             ErrorMessage(1083, AnimInfo[1], format, filepath, linecount);
                         }
@@ -618,7 +614,7 @@ OptionList::OptionList(string filepath, string format)
                     else
                     {
                         size_t lineplus = nemesis::regex_replace(string(strline),
-                                                               nemesis::regex("[<\\s]*([^<\\s]+).*"),
+                                                               nemesis::precompiled(nemesis::pattern::first_token),
                                                                string("\\1"))
                                               .length();
 
@@ -664,7 +660,7 @@ OptionList::OptionList(string filepath, string format)
                                         = strline.substr(nextpos, strline.find(">", nextpos) - nextpos);
                                     string tempAddOn
                                         = nemesis::regex_replace(string(addition),
-                                                               nemesis::regex("[^A-Za-z\\s]*([A-Za-z\\s]+).*"),
+                                                               nemesis::precompiled(nemesis::pattern::first_word),
                                                                string("\\1"));
 
                                     if (tempAddOn != addition)
@@ -0,0 +1,44 @@
+#include <mutex>
+
+#include "generate/animation/optionset.h"
+
+using namespace std;
+
+uint32_t nemesis::OptionIndex::bit(string_view name)
+{
+    {
+        shared_lock<shared_mutex> lock(mutex);
+        auto itr = index.find(name);
+
+        if (itr != index.end()) return itr->second;
+    }
+
+    unique_lock<shared_mutex> lock(mutex);
+
+    // another thread may have added it in between
+    auto itr = index.find(name);
+
+    if (itr != index.end()) return itr->second;
+
+    names.emplace_back(name);
+    uint32_t id = uint32_t(names.size() - 1);
+    index.emplace(names.back(), id);
+    return id;
+}
+
+nemesis::OptionSet::OptionSet(const unordered_map<string, bool>& picked, OptionIndex& index)
+{
+    for (auto& opt : picked)
+    {
+        set(index.bit(opt.first));
+    }
+}
+
+void nemesis::OptionSet::set(uint32_t bit)
+{
+    size_t word = bit >> 6;
+
+    if (word >= words.size()) words.resize(word + 1);
+
+    words[word] |= uint64_t(1) << (bit & 63);
+}
@@ -314,7 +314,7 @@ Paired::Paired(const string& line,
             {
                 string temp = templine.substr(templine.find('B'));
                 int tempint = stoi(
-                    nemesis::regex_replace(string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                    nemesis::first_number(line));
             }
 
             if (templine.find("bsa ", 0) != string::npos || templine.find("bsa,", 0) != string::npos) 
@@ -460,7 +460,7 @@ Paired::Paired(const string& line,
     }
 }
 
-VecStr Paired::GetPairedLine(int id, AOConvert AnimObjectNames, ID eventid, const ID& variableid)
+VecStr Paired::GetPairedLine(int id, AOConvert AnimObjectNames, const ID& eventid, const ID& variableid)
 {
     VecStr generatedlines;
     VecStr recordTrigger;
@@ -665,7 +665,9 @@ VecStr Paired::GetPairedLine(int id, AOConvert AnimObjectNames, ID eventid, cons
                         }
                         else if (triggerline.find("!T$0!", 0) != string::npos)
                         {
-                            triggerline.replace(triggerline.find("!T$0!"), 5, to_string(eventid[val.first]));
+                            // unknown events were written as 0 when the map was still a copy
+                            auto itr = eventid.find(val.first);
+                            triggerline.replace(triggerline.find("!T$0!"), 5, to_string(itr != eventid.end() ? itr->second : 0));
                         }
 
                         generatedlines.push_back(triggerline);
@@ -685,7 +687,9 @@ VecStr Paired::GetPairedLine(int id, AOConvert AnimObjectNames, ID eventid, cons
                         }
                         else if (triggerline.find("!T$!", 0) != string::npos)
                         {
-                            triggerline.replace(triggerline.find("!T$!"), 5, to_string(eventid[val.first]));
+                            // unknown events were written as 0 when the map was still a copy
+                            auto itr = eventid.find(val.first);
+                            triggerline.replace(triggerline.find("!T$!"), 5, to_string(itr != eventid.end() ? itr->second : 0));
                         }
 
                         generatedlines.push_back(triggerline);
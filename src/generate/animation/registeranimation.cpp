@@ -1,7 +1,7 @@
 #include "Global.h"
 
-#include <QtCore/QFile.h>
-#include <QtCore/QTextstream.h>
+#include <QtCore/QByteArray>
+#include <QtCore/QTextCodec>
 
 #include "debuglog.h"
 
@@ -10,6 +10,8 @@
 #include "utilities/stringsplit.h"
 #include "utilities/readtextfile.h"
 
+#include "generate/generationcache.h"
+
 #include "generate/animation/registeranimation.h"
 
 using namespace std;
@@ -26,7 +28,7 @@ bool ruleCheck(VecStr rules, VecStr curList, TemplateInfo& behaviortemplate, str
         {
             bool matching = false;
             string number
-                = nemesis::regex_replace(string(cur), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                = nemesis::first_number(cur);
 
             if (cur.length() == rule.length()
                 || (behaviortemplate.optionlist[lowerformat].addOn[rule].size() != 0
@@ -71,6 +73,53 @@ bool ruleCheck(VecStr rules, VecStr curList, TemplateInfo& behaviortemplate, str
     return true;
 }
 
+namespace
+{
+    // Lines of an animation list, as the old QTextStream reader returned them. Text is decoded by its byte
+    // order mark, or in the local 8-bit code page without one, and lines end at "\n", "\r\n" or a lone "\r".
+    // Pure ASCII reads the same in any of them, so it is split straight from the mapped file
+    VecStr readAnimationList(string_view raw)
+    {
+        string decoded;
+        string_view text = raw;
+
+        if (raw.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);
+
+        bool ascii = raw.substr(0, 2) != "\xFF\xFE" && raw.substr(0, 2) != "\xFE\xFF"
+                     && all_of(text.begin(), text.end(), [](char ch) { return (unsigned char)ch < 0x80; });
+
+        if (!ascii)
+        {
+            QByteArray bytes(raw.data(), int(raw.length()));
+            QTextCodec* codec = QTextCodec::codecForUtfText(bytes, QTextCodec::codecForLocale());
+            decoded = codec->toUnicode(bytes).toStdString();
+            text    = decoded;
+
+            // byte order mark, in case the codec kept it
+            if (text.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);
+        }
+
+        VecStr lines;
+        lines.reserve(nemesis::line_count(text));
+
+        while (text.length() > 0)
+        {
+            size_t end = text.find_first_of("\r\n");
+
+            if (end == string_view::npos)
+            {
+                lines.emplace_back(text);
+                break;
+            }
+
+            lines.emplace_back(text.substr(0, end));
+            text.remove_prefix(text[end] == '\r' && text.substr(end + 1, 1) == "\n" ? end + 2 : end + 1);
+        }
+
+        return lines;
+    }
+}
+
 registerAnimation::registerAnimation(sf::path curDirectory,
                                      sf::path filename,
                                      TemplateInfo behaviortemplate,
@@ -86,10 +135,12 @@ registerAnimation::registerAnimation(sf::path curDirectory,
     if (linecount == NOT_FOUND) ErrorMessage(1081);
 
     behaviorFile = bhvrPath;
-    QFile qfile(QString::fromStdWString(filepath));
+    FileReader input(filepath);
     string line;
 
-    if (!qfile.open(QIODevice::ReadOnly)) ErrorMessage(1004, filename);
+    if (!input.GetFile()) ErrorMessage(1004, filename);
+
+    contentHash = nemesis::hash_content(input.file.view());
 
     linecount      = 0;
     int multiCount = -1;
@@ -98,14 +149,12 @@ registerAnimation::registerAnimation(sf::path curDirectory,
     string curAAprefix;
     unordered_map<string, bool> AAAnimFileExist;
     unordered_map<string, bool> AAprefixExist;
-    QTextStream in(&qfile);
+    VecStr lines = readAnimationList(input.file.view());
 
-    while (!in.atEnd())
+    for (string& temp : lines)
     {
         if (error) throw nemesis::exception();
 
-        QString qline = in.readLine();
-        string temp   = qline.toStdString();
         string temp2;
         ++linecount;
         bool hasInfo = false;
@@ -337,8 +386,7 @@ registerAnimation::registerAnimation(sf::path curDirectory,
                     {
                         bool isOExist = true;
                         string anim   = newAnimInfo[newAnimInfo.size() - 1];
-                        string number = nemesis::regex_replace(
-                            string(anim), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                        string number = nemesis::first_number(anim);
 
                         if (isOnlyNumber(number) && anim.length() > number.length()
                             && anim[anim.length() - number.length() - 1] == '/'
@@ -616,8 +664,6 @@ registerAnimation::registerAnimation(sf::path curDirectory,
         if (error) throw nemesis::exception();
     }
 
-    qfile.close();
-
     if (error) throw nemesis::exception();
 
     ++linecount;
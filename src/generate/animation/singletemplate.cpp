@@ -16,7 +16,7 @@ void stateInstall(string line,
                   bool isMC,
                   map<int, vector<nemesis::scope>>& lineblocks,
                   proc& process,
-                  void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const);
+                  void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const);
 void mainAnimEventInstall(string format,
                           string behaviorFile,
                           string change,
@@ -101,7 +101,7 @@ void AnimTemplate::ExamineTemplate(
             nemesis::smatch match;
 
             if (nemesis::regex_search(
-                    line, match, nemesis::regex(".*<!-- CONDITION START \\^(.+?)\\^ -->.*")))
+                    line, match, nemesis::precompiled(nemesis::pattern::condition_start)))
             {
                 condition++;
                 string multiOption;
@@ -128,7 +128,7 @@ void AnimTemplate::ExamineTemplate(
                 generatedlines.back()->conditionType = nemesis::CONDITION_START;
                 uniqueskip                           = true;
             }
-            else if (nemesis::regex_search(line, match, nemesis::regex(".*<!-- CONDITION \\^(.+?)\\^ -->.*")))
+            else if (nemesis::regex_search(line, match, nemesis::precompiled(nemesis::pattern::condition)))
             {
                 if (condition == 0) ErrorMessage(1119, format, behaviorFile, i + 1);
 
@@ -250,7 +250,7 @@ void AnimTemplate::ExamineTemplate(
                 generatedlines.back()->rawlist.back().nestedcond.push_back(nemesis::CondVar<string>());
                 generatedlines.push_back(&generatedlines.back()->rawlist.back().nestedcond.back());
                 generatedlines.back()->conditions = nemesis::regex_replace(
-                    string(line), nemesis::regex(".*<!-- NEW ORDER (.+?) -->.*"), string("\\1"));
+                    string(line), nemesis::precompiled(nemesis::pattern::new_order), string("\\1"));
                 generatedlines.back()->next = make_shared<nemesis::Condt>(generatedlines.back()->conditions,
                                                                           format,
                                                                           behaviorFile,
@@ -442,7 +442,7 @@ void AnimTemplate::Process(const string& line,
             vector<nemesis::MultiChoice> m_conditions;
             process.hasMC.insert(numline);
 
-            for (auto itr = nemesis::regex_iterator(line, nemesis::regex("[\\s]+<!-- (.+?) -->[\\s]*?"));
+            for (auto itr = nemesis::regex_iterator(line, nemesis::precompiled(nemesis::pattern::comment));
                  itr != nemesis::regex_iterator();
                  ++itr)
             {
@@ -480,7 +480,7 @@ void AnimTemplate::Process(const string& line,
                 }
             }
 
-            for (auto itr = nemesis::regex_iterator(line, nemesis::regex("\\$MC\\$"));
+            for (auto itr = nemesis::regex_iterator(line, nemesis::precompiled(nemesis::pattern::mc));
                  itr != nemesis::regex_iterator();
                  ++itr)
             {
@@ -543,7 +543,7 @@ void AnimTemplate::Process(const string& line,
                 isEnd = false;
             }
 
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
             if (isMaster)
             {
@@ -558,7 +558,7 @@ void AnimTemplate::Process(const string& line,
                 func = &proc::IDRegis;
             }
 
-            for (auto itr = nemesis::regex_iterator(line, nemesis::regex("MID\\$([0-9]+)"));
+            for (auto itr = nemesis::regex_iterator(line, nemesis::precompiled(nemesis::pattern::mid));
                  itr != nemesis::regex_iterator();
                  ++itr)
             {
@@ -573,7 +573,7 @@ void AnimTemplate::Process(const string& line,
     if (isEnd)
     {
         for (auto itr = nemesis::regex_iterator(
-                 line, nemesis::regex("<hkparam name\\=\"relativeToEndOfClip\">(.+?)<\\/hkparam>"));
+                 line, nemesis::precompiled(nemesis::pattern::hkparam_relative_to_end));
              itr != nemesis::regex_iterator();
              ++itr)
         {
@@ -585,7 +585,7 @@ void AnimTemplate::Process(const string& line,
         }
 
         for (auto itr = nemesis::regex_iterator(
-                 line, nemesis::regex("<hkparam name\\=\"localTime\">(.+?)<\\/hkparam>"));
+                 line, nemesis::precompiled(nemesis::pattern::hkparam_local_time));
              itr != nemesis::regex_iterator();
              ++itr)
         {
@@ -597,7 +597,7 @@ void AnimTemplate::Process(const string& line,
     }
 
     for (auto itr = nemesis::regex_iterator(
-             line, nemesis::regex("<hkparam name\\=\"animationName\">(.+?)<\\/hkparam>"));
+             line, nemesis::precompiled(nemesis::pattern::hkparam_animation_name));
          itr != nemesis::regex_iterator();
          ++itr)
     {
@@ -607,7 +607,7 @@ void AnimTemplate::Process(const string& line,
     }
 
     for (auto itr = nemesis::regex_iterator(
-             line, nemesis::regex("<hkparam name\\=\"behaviorName\">(.+?)<\\/hkparam>"));
+             line, nemesis::precompiled(nemesis::pattern::hkparam_behavior_name));
          itr != nemesis::regex_iterator();
          ++itr)
     {
@@ -639,7 +639,7 @@ AddOnInfo::AddOnInfo(string n_h, string n_a, int n_om)
 string getOption(string curline)
 {
     return nemesis::regex_replace(
-        string(curline), nemesis::regex(".*<!-- (?:FOREACH|NEW) \\^(.+?)\\^ -->.*"), string("\\1"));
+        string(curline), nemesis::precompiled(nemesis::pattern::foreach_or_new), string("\\1"));
 }
 
 void stateInstall(string line,
@@ -652,7 +652,7 @@ void stateInstall(string line,
                   bool isMC,
                   map<int, vector<shared_ptr<nemesis::scope>>>& lineblocks,
                   proc& process,
-                  void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const)
+                  void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const)
 {
     int intID;
     nemesis::regex expr(format + "\\[" + animOrder + "\\]\\[\\(S([0-9]*)\\+([0-9]+)\\)\\]");
@@ -736,7 +736,7 @@ void mainAnimEventInstall(string format,
         bool num     = false;
         string first = itr->str(1);
         size_t post  = curPos + itr->position();
-        void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+        void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
         if (first.length() == 0)
         {
@@ -859,17 +859,14 @@ void ProcessFunction(proc& process,
 
                 if (equation.find("(S", 0) != NOT_FOUND)
                 {
-                    ID = nemesis::regex_replace(
-                        string(equation), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                    ID = nemesis::first_number(equation);
 
                     if (change.find("(S" + ID + "+") == NOT_FOUND)
                     {
                         ID = "";
                     }
 
-                    number = nemesis::regex_replace(string(equation.substr(3 + ID.length())),
-                                                    nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                    string("\\1"));
+                    number = nemesis::first_number(string(equation.substr(3 + ID.length())));
                 }
 
                 if (equation != "(S" + ID + "+" + number + ")" && isOnlyNumber(number))
@@ -906,7 +903,7 @@ void ProcessFunction(proc& process,
         {
             bool number  = false;
             string first = itr->str(1);
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
             if (first.length() == 0)
             {
@@ -1003,7 +1000,7 @@ void ProcessFunction(proc& process,
              ++itr)
         {
             string first = itr->str(1);
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
             if (first.length() == 0)
             {
@@ -1143,7 +1140,7 @@ void ProcessFunction(proc& process,
             bool number  = false;
             size_t post  = curPos + itr->position();
             string first = itr->str(1);
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
             if (first.length() == 0)
             {
@@ -1224,7 +1221,7 @@ void ProcessFunction(proc& process,
             bool number  = false;
             size_t post  = curPos + itr->position();
             string first = itr->str(1);
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
             if (first.length() == 0)
             {
@@ -1340,7 +1337,7 @@ void ProcessFunction(proc& process,
             string optionMulti = itr->str(3);
             string full        = itr->str();
             size_t post        = curPos + itr->position();
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
             vector<int> container;
             ++counter;
             string templine;
@@ -1539,7 +1536,7 @@ void ProcessFunction(proc& process,
             isMaster,
             process);
 
-        for (auto itr = nemesis::regex_iterator(change, nemesis::regex("(\\{main_anim_event\\})"));
+        for (auto itr = nemesis::regex_iterator(change, nemesis::precompiled(nemesis::pattern::main_anim_event));
              itr != nemesis::regex_iterator();
              ++itr)
         {
@@ -1592,7 +1589,7 @@ void ProcessFunction(proc& process,
                     string header;
                     string first  = itr->str(1);
                     size_t addpos = curPos + itr->position();
-                    void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+                    void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
                     if (first.length() == 0)
                     {
@@ -1751,7 +1748,7 @@ void ProcessFunction(proc& process,
 
     if (change.find("LastState") != NOT_FOUND)
     {
-        for (auto itr = nemesis::regex_iterator(change, nemesis::regex("LastState([0-9]*)"));
+        for (auto itr = nemesis::regex_iterator(change, nemesis::precompiled(nemesis::pattern::last_state));
              itr != nemesis::regex_iterator();
              ++itr)
         {
@@ -1974,7 +1971,7 @@ void ProcessFunction(proc& process,
             bool number  = false;
             string first = itr->str(1);
             size_t post  = curPos + itr->position();
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
             if (first.length() == 0)
             {
@@ -2060,7 +2057,7 @@ void ProcessFunction(proc& process,
             bool number  = false;
             string first = itr->str(1);
             size_t post  = curPos + itr->position();
-            void (proc::*func)(nemesis::scope, VecStr&, AnimThreadInfo&) const;
+            void (proc::*func)(const nemesis::scope&, VecStr&, AnimThreadInfo&) const;
 
             if (first.length() == 0)
             {
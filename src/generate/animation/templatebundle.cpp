@@ -0,0 +1,465 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Global.h"
+#include "version.h"
+
+#include "utilities/mappedfile.h"
+
+#include "generate/generationcache.h"
+
+#include "generate/animation/optionlist.h"
+#include "generate/animation/templatebundle.h"
+#include "generate/animation/templateinfo.h"
+
+using namespace std;
+namespace sf = filesystem;
+
+namespace
+{
+    const string bundleMagic     = "nemesis template bundle";
+    constexpr uint32_t bundleFormat = 1;
+
+    template <class Stream, class Option>
+    void optionFields(Stream& stream, Option& option);
+
+    template <class Stream, class Info>
+    void templateFields(Stream& stream, Info& info);
+
+    class BundleWriter
+    {
+        template <class Container>
+        void range(const Container& value)
+        {
+            (*this)(static_cast<uint32_t>(value.size()));
+
+            for (auto& element : value)
+            {
+                (*this)(element);
+            }
+        }
+
+    public:
+        string buffer;
+
+        void operator()(uint32_t value)
+        {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void operator()(uint64_t value)
+        {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void operator()(int value)
+        {
+            (*this)(static_cast<uint32_t>(value));
+        }
+
+        void operator()(bool value)
+        {
+            buffer.push_back(value ? 1 : 0);
+        }
+
+        void operator()(const string& value)
+        {
+            (*this)(static_cast<uint32_t>(value.length()));
+            buffer.append(value);
+        }
+
+        void operator()(const OptionList& value)
+        {
+            optionFields(*this, value);
+        }
+
+        template <class First, class Second>
+        void operator()(const pair<First, Second>& value)
+        {
+            (*this)(value.first);
+            (*this)(value.second);
+        }
+
+        template <class T, class A>
+        void operator()(const vector<T, A>& value)
+        {
+            range(value);
+        }
+
+        template <class K, class C, class A>
+        void operator()(const set<K, C, A>& value)
+        {
+            range(value);
+        }
+
+        template <class K, class H, class E, class A>
+        void operator()(const unordered_set<K, H, E, A>& value)
+        {
+            range(value);
+        }
+
+        template <class K, class V, class C, class A>
+        void operator()(const map<K, V, C, A>& value)
+        {
+            range(value);
+        }
+
+        template <class K, class V, class H, class E, class A>
+        void operator()(const unordered_map<K, V, H, E, A>& value)
+        {
+            range(value);
+        }
+    };
+
+    // reads over the mapped bundle, any overrun marks the whole bundle as failed
+    class BundleReader
+    {
+        string_view data;
+
+        bool take(void* value, size_t length)
+        {
+            if (failed || data.length() < length)
+            {
+                failed = true;
+                return false;
+            }
+
+            memcpy(value, data.data(), length);
+            data.remove_prefix(length);
+            return true;
+        }
+
+        uint32_t count()
+        {
+            uint32_t size = 0;
+            (*this)(size);
+
+            // every element takes at least a byte
+            if (size > data.length()) failed = true;
+
+            return failed ? 0 : size;
+        }
+
+    public:
+        bool failed = false;
+
+        BundleReader(string_view _data)
+            : data(_data)
+        {
+        }
+
+        bool done() const
+        {
+            return !failed && data.empty();
+        }
+
+        void operator()(uint32_t& value)
+        {
+            if (!take(&value, sizeof(value))) value = 0;
+        }
+
+        void operator()(uint64_t& value)
+        {
+            if (!take(&value, sizeof(value))) value = 0;
+        }
+
+        void operator()(int& value)
+        {
+            uint32_t raw = 0;
+            (*this)(raw);
+            value = static_cast<int>(raw);
+        }
+
+        void operator()(bool& value)
+        {
+            char raw = 0;
+            take(&raw, 1);
+            value = raw != 0;
+        }
+
+        void operator()(string& value)
+        {
+            uint32_t length = 0;
+            (*this)(length);
+
+            if (failed || data.length() < length)
+            {
+                failed = true;
+                return;
+            }
+
+            value.assign(data.data(), length);
+            data.remove_prefix(length);
+        }
+
+        void operator()(OptionList& value)
+        {
+            optionFields(*this, value);
+        }
+
+        template <class First, class Second>
+        void operator()(pair<First, Second>& value)
+        {
+            (*this)(value.first);
+            (*this)(value.second);
+        }
+
+        template <class T, class A>
+        void operator()(vector<T, A>& value)
+        {
+            uint32_t size = count();
+            value.clear();
+            value.reserve(size);
+
+            for (uint32_t i = 0; i < size && !failed; ++i)
+            {
+                T element;
+                (*this)(element);
+                value.push_back(move(element));
+            }
+        }
+
+        template <class K, class C, class A>
+        void operator()(set<K, C, A>& value)
+        {
+            uint32_t size = count();
+            value.clear();
+
+            for (uint32_t i = 0; i < size && !failed; ++i)
+            {
+                K element;
+                (*this)(element);
+                value.insert(move(element));
+            }
+        }
+
+        template <class K, class H, class E, class A>
+        void operator()(unordered_set<K, H, E, A>& value)
+        {
+            uint32_t size = count();
+            value.clear();
+            value.reserve(size);
+
+            for (uint32_t i = 0; i < size && !failed; ++i)
+            {
+                K element;
+                (*this)(element);
+                value.insert(move(element));
+            }
+        }
+
+        template <class K, class V, class C, class A>
+        void operator()(map<K, V, C, A>& value)
+        {
+            uint32_t size = count();
+            value.clear();
+
+            for (uint32_t i = 0; i < size && !failed; ++i)
+            {
+                K key;
+                V mapped;
+                (*this)(key);
+                (*this)(mapped);
+                value.emplace(move(key), move(mapped));
+            }
+        }
+
+        template <class K, class V, class H, class E, class A>
+        void operator()(unordered_map<K, V, H, E, A>& value)
+        {
+            uint32_t size = count();
+            value.clear();
+            value.reserve(size);
+
+            for (uint32_t i = 0; i < size && !failed; ++i)
+            {
+                K key;
+                V mapped;
+                (*this)(key);
+                (*this)(mapped);
+                value.emplace(move(key), move(mapped));
+            }
+        }
+    };
+
+    // puts back what a failed read left behind
+    struct BundleClearer
+    {
+        template <class T>
+        void operator()(T& value)
+        {
+            value = T();
+        }
+    };
+
+    // a new field in OptionList or TemplateInfo needs to be listed here and bundleFormat raised
+    template <class Stream, class Option>
+    void optionFields(Stream& stream, Option& option)
+    {
+        stream(option.core);
+        stream(option.ignoreGroup);
+        stream(option.groupMin);
+        stream(option.animObjectCount);
+        stream(option.coreBehavior);
+        stream(option.startStateID);
+        stream(option.templatecode);
+        stream(option.ruleOne);
+        stream(option.ruleTwo);
+        stream(option.compulsory);
+        stream(option.optionOrder);
+        stream(option.multiState);
+        stream(option.storelist);
+        stream(option.groupOption);
+        stream(option.mixOptRegis);
+        stream(option.mixOptRever);
+        stream(option.joint);
+        stream(option.addOn);
+        stream(option.modAddOn);
+        stream(option.eleEvent);
+        stream(option.eleEventLine);
+        stream(option.eleEventGroupF);
+        stream(option.eleEventGroupFLine);
+        stream(option.eleEventGroupL);
+        stream(option.eleEventGroupLLine);
+        stream(option.eleVar);
+        stream(option.eleVarLine);
+        stream(option.eleVarGroupF);
+        stream(option.eleVarGroupFLine);
+        stream(option.eleVarGroupL);
+        stream(option.eleVarGroupLLine);
+    }
+
+    template <class Stream, class Info>
+    void templateFields(Stream& stream, Info& info)
+    {
+        stream(info.optionlist);
+        stream(info.grouplist);
+        stream(info.templatelist);
+        stream(info.existingFunctionID);
+        stream(info.mainBehaviorJoint);
+        stream(info.behaviortemplate);
+        stream(info.coreTemplate);
+        stream(info.coreBehaviorCode);
+        stream(info.coreJoints);
+        stream(info.asdtemplate);
+        stream(info.animdatatemplate);
+        stream(info.existingASDHeader);
+        stream(info.existingAnimDataHeader);
+    }
+}
+
+uint64_t nemesis::template_fingerprint(const sf::path& directory)
+{
+    struct Stamp
+    {
+        string path;
+        uintmax_t size;
+        int64_t time;
+    };
+
+    vector<Stamp> stamps;
+    error_code ec;
+
+    for (auto& entry : sf::recursive_directory_iterator(directory, ec))
+    {
+        Stamp stamp{nemesis::to_lower_copy(entry.path().lexically_relative(directory).string()), 0, 0};
+
+        // empty folders register animation data projects too, so they are part of the fingerprint
+        if (!entry.is_directory(ec))
+        {
+            stamp.size = entry.file_size(ec);
+            stamp.time = entry.last_write_time(ec).time_since_epoch().count();
+        }
+
+        stamps.push_back(move(stamp));
+    }
+
+    sort(stamps.begin(), stamps.end(), [](const Stamp& lhs, const Stamp& rhs) { return lhs.path < rhs.path; });
+    uint64_t hash = nemesis::hash_content(stamps.size(), nemesis::hash_seed);
+
+    for (auto& stamp : stamps)
+    {
+        hash = nemesis::hash_content(stamp.path, hash);
+        hash = nemesis::hash_content(stamp.size, hash);
+        hash = nemesis::hash_content(static_cast<uint64_t>(stamp.time), hash);
+    }
+
+    return hash;
+}
+
+uint64_t nemesis::option_check_fingerprint(uint64_t seed)
+{
+    // behavior states (S lines) must name a behavior file with a path, error 1083 otherwise
+    vector<string> behaviors;
+
+    for (auto& path : behaviorPath)
+    {
+        if (!path.second.empty()) behaviors.push_back(path.first.str());
+    }
+
+    sort(behaviors.begin(), behaviors.end());
+    uint64_t hash = nemesis::hash_content(behaviors.size(), seed);
+
+    for (auto& behavior : behaviors)
+    {
+        hash = nemesis::hash_content(behavior, hash);
+    }
+
+    // warnings 1001 and 1002 are only given in debug
+    return nemesis::hash_content(debug ? 1 : 0, hash);
+}
+
+bool nemesis::load_template_bundle(TemplateInfo& info, uint64_t fingerprint, const sf::path& filename)
+{
+    if (!isFileExist(filename)) return false;
+
+    nemesis::MappedFile file;
+
+    if (!file.open(filename)) return false;
+
+    BundleReader reader(file.view());
+    string magic;
+    uint32_t format = 0;
+    string version;
+    uint64_t key = 0;
+    reader(magic);
+    reader(format);
+    reader(version);
+    reader(key);
+
+    if (reader.failed || magic != bundleMagic || format != bundleFormat || version != GetNemesisVersion()
+        || key != fingerprint)
+    {
+        return false;
+    }
+
+    templateFields(reader, info);
+
+    if (reader.done()) return true;
+
+    BundleClearer clearer;
+    templateFields(clearer, info);
+    return false;
+}
+
+void nemesis::save_template_bundle(const TemplateInfo& info, uint64_t fingerprint, const sf::path& filename)
+{
+    BundleWriter writer;
+    writer(bundleMagic);
+    writer(bundleFormat);
+    writer(GetNemesisVersion());
+    writer(fingerprint);
+    templateFields(writer, info);
+
+    // a bundle that is cut short fails to load and the next run walks the folder again
+    ofstream output(filename, ios::binary | ios::trunc);
+
+    if (!output.is_open()) return;
+
+    output.write(writer.buffer.data(), writer.buffer.size());
+}
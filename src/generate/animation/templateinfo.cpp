@@ -3,6 +3,7 @@
 #include "utilities/algorithm.h"
 
 #include "generate/animation/optionlist.h"
+#include "generate/animation/templatebundle.h"
 #include "generate/animation/templateinfo.h"
 
 #include "utilities/regex.h"
@@ -12,9 +13,37 @@
 using namespace std;
 namespace sf = filesystem;
 
+const string templateDirectory = "behavior templates\\";
+
 TemplateInfo::TemplateInfo()
 {
-    string templateDirectory = "behavior templates\\";
+    // a bundle only stands for the parse under the same checks, so a template that names a behavior file
+    // the update no longer found is parsed again and reported
+    uint64_t fingerprint = nemesis::option_check_fingerprint(nemesis::template_fingerprint(templateDirectory));
+
+    if (nemesis::load_template_bundle(*this, fingerprint))
+    {
+        DebugLogging("Behavior templates loaded from bundle");
+
+        for (auto& option : optionlist)
+        {
+            option.second.setDebug(debug);
+        }
+
+        for (auto& joint : coreJoints)
+        {
+            JoinCore(joint.first, joint.second);
+        }
+
+        return;
+    }
+
+    ReadTemplates();
+    nemesis::save_template_bundle(*this, fingerprint);
+}
+
+void TemplateInfo::ReadTemplates()
+{
     string newpath;
     VecStr codelist;
     set<string> corelist;
@@ -84,13 +113,8 @@ TemplateInfo::TemplateInfo()
 
                         if (isCore)
                         {
-                            if (behaviorJoints[lowerBehaviorFolder].size() == 0)
-                            {
-                                ErrorMessage(1182, code, templateDirectory + code + "\\option_list.txt");
-                            }
-
-                            behaviorJoints[nemesis::to_lower_copy(optionlist[code].coreBehavior)]
-                                = behaviorJoints[lowerBehaviorFolder];
+                            coreJoints.emplace_back(code, lowerBehaviorFolder);
+                            JoinCore(code, lowerBehaviorFolder);
                         }
 
                         for (uint i = 0; i < filelist.size(); ++i)
@@ -151,9 +175,7 @@ TemplateInfo::TemplateInfo()
                                 }
                                 else if (lowerfilename[0] == '#')
                                 {
-                                    string number = nemesis::regex_replace(string(lowerfilename),
-                                                                         nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                                         string("\\1"));
+                                    string number = nemesis::first_number(lowerfilename);
 
                                     if (lowerfilename == "#" + number + ".txt" && isOnlyNumber(number))
                                     {
@@ -378,3 +400,13 @@ TemplateInfo::TemplateInfo()
         }
     }
 }
+
+void TemplateInfo::JoinCore(const string& code, const string& behavior)
+{
+    if (behaviorJoints[behavior].size() == 0)
+    {
+        ErrorMessage(1182, code, templateDirectory + code + "\\option_list.txt");
+    }
+
+    behaviorJoints[nemesis::to_lower_copy(optionlist[code].coreBehavior)] = behaviorJoints[behavior];
+}
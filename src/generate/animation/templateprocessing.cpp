@@ -85,7 +85,7 @@ void proc::installBlock(nemesis::scope blok, int curline, vector<nemesis::MultiC
     choiceblocks[curline].push_back(blok);
 }
 
-void proc::relativeNegative(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::relativeNegative(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -103,40 +103,40 @@ void proc::relativeNegative(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::compute(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::compute(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     curAnimInfo.elementCatch = true;
     curAnimInfo.norElement   = true;
 }
 
-void proc::rangeCompute(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rangeCompute(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     (*curAnimInfo.generatedlines)[curAnimInfo.elementLine]
         = nemesis::regex_replace(string((*curAnimInfo.generatedlines)[curAnimInfo.elementLine]),
-                                 nemesis::regex("(.*<hkparam name\\=\".+\" numelements\\=\").+(\">.*)"),
+                                 nemesis::precompiled(nemesis::pattern::hkparam_numelements_value),
                                  string("\\1" + to_string(curAnimInfo.counter) + "\\2"));
     curAnimInfo.norElement  = false;
     curAnimInfo.counter     = 0;
     curAnimInfo.elementLine = -1;
 }
 
-void proc::upCounter(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::upCounter(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     ++curAnimInfo.counter;
 }
 
-void proc::upCounterPlus(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::upCounterPlus(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string full = combineBlocks(0, blocks.size() - 1, blocks);
     curAnimInfo.counter += count(full.begin(), full.end(), '#');
 }
 
-void proc::animCount(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::animCount(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo)) blocks[blok.front] = to_string(curAnimInfo.furnitureCount);
 }
 
-void proc::multiChoiceRegis(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::multiChoiceRegis(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string result = !curAnimInfo.captured
                         ? "null"
@@ -146,7 +146,7 @@ void proc::multiChoiceRegis(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     blocks[blok.front] = result;
 }
 
-void proc::groupIDRegis(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::groupIDRegis(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -157,6 +157,8 @@ void proc::groupIDRegis(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
             != curAnimInfo.groupFunction->functionIDs.end())
         {
             blocks[blok.front] = curAnimInfo.groupFunction->functionIDs[oldID];
+
+            if (curAnimInfo.idJournal) curAnimInfo.idJournal->touch(blocks[blok.front]);
         }
         else
         {
@@ -167,7 +169,7 @@ void proc::groupIDRegis(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::IDRegis(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::IDRegis(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -189,7 +191,7 @@ void proc::IDRegis(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimI
     }
 }
 
-void proc::IDRegisAnim(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::IDRegisAnim(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -209,6 +211,9 @@ void proc::IDRegisAnim(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
             ErrorMessage(1057, format, behaviorFile, curAnimInfo.numline, blok.olddata[0]);
         }
 
+        // the master's function IDs are shared by every group job
+        Lockless lock(curAnimInfo.animLock->subIDLock);
+
         if (curAnimInfo.masterFunction->grouplist[n_groupMulti]
                 ->singlelist[curAnimInfo.animMulti]
                 ->format.find(oldID)
@@ -243,7 +248,7 @@ void proc::IDRegisAnim(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
     }
 }
 
-void proc::IDRegisGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::IDRegisGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -258,6 +263,9 @@ void proc::IDRegisGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
 
         n_groupMulti = curAnimInfo.groupMulti;
 
+        // the master's function IDs are shared by every group job
+        Lockless lock(curAnimInfo.animLock->subIDLock);
+
         if (curAnimInfo.masterFunction->grouplist[n_groupMulti]->functionIDs.find(oldID)
             != curAnimInfo.masterFunction->grouplist[n_groupMulti]->functionIDs.end())
         {
@@ -283,18 +291,21 @@ void proc::IDRegisGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::IDRegisMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::IDRegisMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
         string ID;
         string oldID = masterformat + "_master$" + blok.olddata[0];
+        Lockless lock(curAnimInfo.animLock->subIDLock);
 
         if (curAnimInfo.masterFunction->functionIDs.find(oldID)
             != curAnimInfo.masterFunction->functionIDs.end())
         {
             ID                         = curAnimInfo.masterFunction->functionIDs[oldID];
             curAnimInfo.IDExist[oldID] = ID;
+
+            if (curAnimInfo.idJournal) curAnimInfo.idJournal->touch(ID);
         }
         else
         {
@@ -315,7 +326,7 @@ void proc::IDRegisMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::computation(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::computation(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string equation       = combineBlocks(blok, blocks);
     size_t equationLength = equation.length();
@@ -402,7 +413,7 @@ void proc::computation(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
     }
 }
 
-void proc::endMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -424,7 +435,7 @@ void proc::endMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::endFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -440,7 +451,7 @@ void proc::endFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::endNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endNextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -460,7 +471,7 @@ void proc::endNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::endBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -480,7 +491,7 @@ void proc::endBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::endLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endLastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -498,7 +509,7 @@ void proc::endLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::endNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endNumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -521,7 +532,7 @@ void proc::endNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
     }
 }
 
-void proc::endMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1)
     {
@@ -548,7 +559,7 @@ void proc::endMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::endFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -570,7 +581,7 @@ void proc::endFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::endLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endLastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -595,7 +606,7 @@ void proc::endLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::endNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endNumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -624,7 +635,7 @@ void proc::endNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::endSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::endSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -640,7 +651,7 @@ void proc::endSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAni
     }
 }
 
-void proc::stateMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
         blocks[blok.front] = to_string(curAnimInfo.fixedStateID[blok.olddataint[0]]
@@ -649,7 +660,7 @@ void proc::stateMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
                                        + blok.olddataint[1]);
 }
 
-void proc::stateFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
         blocks[blok.front]
@@ -658,7 +669,7 @@ void proc::stateFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
                         + blok.olddataint[1]);
 }
 
-void proc::stateNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateNextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -671,7 +682,7 @@ void proc::stateNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::stateBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -684,7 +695,7 @@ void proc::stateBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::stateLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateLastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -695,7 +706,7 @@ void proc::stateLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::stateNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateNumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -713,7 +724,7 @@ void proc::stateNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::stateMultiMasterToGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateMultiMasterToGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -734,7 +745,7 @@ void proc::stateMultiMasterToGroup(nemesis::scope blok, VecStr& blocks, AnimThre
     }
 }
 
-void proc::stateMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -755,7 +766,7 @@ void proc::stateMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::stateFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -776,7 +787,7 @@ void proc::stateFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::stateLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateLastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -797,7 +808,7 @@ void proc::stateLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::stateNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateNumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[2];
 
@@ -825,23 +836,28 @@ void proc::stateNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::stateSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::stateSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
         string state    = to_string(curAnimInfo.fixedStateID[blok.olddataint[0]] + blok.olddataint[1]);
         string original = "(S+" + to_string(blok.olddataint[1]) + ")";
 
-        if (isMaster)
-            curAnimInfo.masterFunction->functionIDs[original] = state;
-        else if (isGroup)
-            curAnimInfo.masterFunction->grouplist[curAnimInfo.groupMulti]->functionIDs[original] = state;
+        if (isMaster || isGroup)
+        {
+            Lockless lock(curAnimInfo.animLock->subIDLock);
+
+            if (isMaster)
+                curAnimInfo.masterFunction->functionIDs[original] = state;
+            else
+                curAnimInfo.masterFunction->grouplist[curAnimInfo.groupMulti]->functionIDs[original] = state;
+        }
 
         blocks[blok.front] = state;
     }
 }
 
-void proc::filepathMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1)
     {
@@ -855,7 +871,7 @@ void proc::filepathMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInf
     }
 }
 
-void proc::filepathFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -863,7 +879,7 @@ void proc::filepathFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInf
     }
 }
 
-void proc::filepathNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathNextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -874,7 +890,7 @@ void proc::filepathNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
     }
 }
 
-void proc::filepathBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -885,7 +901,7 @@ void proc::filepathBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
     }
 }
 
-void proc::filepathLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathLastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -894,7 +910,7 @@ void proc::filepathLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
     }
 }
 
-void proc::filepathNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathNumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -907,7 +923,7 @@ void proc::filepathNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
         blocks[blok.front] = curAnimInfo.filepath + curAnimInfo.curAnim->GetGroupAnimInfo()[num]->filename;
 }
 
-void proc::filepathMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1) ErrorMessage(1146, format, behaviorFile, curAnimInfo.numline);
 
@@ -922,7 +938,7 @@ void proc::filepathMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadIn
                                  ->format["FilePath"];
 }
 
-void proc::filepathFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -935,7 +951,7 @@ void proc::filepathFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadIn
                                  ->format["FilePath"];
 }
 
-void proc::filepathLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathLastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -948,7 +964,7 @@ void proc::filepathLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInf
                                  ->format["FilePath"];
 }
 
-void proc::filepathNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathNumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -961,7 +977,7 @@ void proc::filepathNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
                                  ->format["FilePath"];
 }
 
-void proc::filepathSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filepathSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.filename == combineBlocks(blok, blocks))
     {
@@ -972,7 +988,7 @@ void proc::filepathSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
         blocks[blok.front] = curAnimInfo.filepath + curAnimInfo.filename;
 }
 
-void proc::filenameMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1) ErrorMessage(1146, format, behaviorFile, curAnimInfo.numline);
 
@@ -983,7 +999,7 @@ void proc::filenameMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInf
     }
 }
 
-void proc::filenameFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -992,7 +1008,7 @@ void proc::filenameFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInf
     }
 }
 
-void proc::filenameNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameNextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1008,7 +1024,7 @@ void proc::filenameNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
     }
 }
 
-void proc::filenameBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1024,7 +1040,7 @@ void proc::filenameBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
     }
 }
 
-void proc::filenameLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameLastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1033,7 +1049,7 @@ void proc::filenameLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
     }
 }
 
-void proc::filenameNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameNumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -1049,7 +1065,7 @@ void proc::filenameNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::filenameMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1070,7 +1086,7 @@ void proc::filenameMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadIn
     }
 }
 
-void proc::filenameFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1086,7 +1102,7 @@ void proc::filenameFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadIn
     }
 }
 
-void proc::filenameLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameLastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1102,7 +1118,7 @@ void proc::filenameLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInf
     }
 }
 
-void proc::filenameNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameNumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1118,13 +1134,13 @@ void proc::filenameNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo
     }
 }
 
-void proc::filenameSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::filenameSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
         blocks[blok.front] = curAnimInfo.filename.substr(0, curAnimInfo.filename.find_last_of("."));
 }
 
-void proc::pathSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::pathSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1137,7 +1153,7 @@ void proc::pathSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAn
     }
 }
 
-void proc::AOMultiGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOMultiGroupA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1 || curAnimInfo.optionMulti == -1)
     {
@@ -1151,7 +1167,7 @@ void proc::AOMultiGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::AOMultiGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOMultiGroupB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1)
     {
@@ -1165,7 +1181,7 @@ void proc::AOMultiGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::AOFirstGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOFirstGroupA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1179,7 +1195,7 @@ void proc::AOFirstGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::AOFirstGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOFirstGroupB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1188,7 +1204,7 @@ void proc::AOFirstGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::AONextGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AONextGroupA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1209,7 +1225,7 @@ void proc::AONextGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AONextGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AONextGroupB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1227,7 +1243,7 @@ void proc::AONextGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AOBackGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOBackGroupA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1247,7 +1263,7 @@ void proc::AOBackGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AOBackGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOBackGroupB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1262,7 +1278,7 @@ void proc::AOBackGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AOLastGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOLastGroupA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1276,7 +1292,7 @@ void proc::AOLastGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AOLastGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOLastGroupB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1285,7 +1301,7 @@ void proc::AOLastGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AONumGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AONumGroupA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1306,7 +1322,7 @@ void proc::AONumGroupA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
     }
 }
 
-void proc::AONumGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AONumGroupB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -1322,7 +1338,7 @@ void proc::AONumGroupB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
     }
 }
 
-void proc::AOMultiMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOMultiMasterA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1 || curAnimInfo.optionMulti == -1)
     {
@@ -1342,7 +1358,7 @@ void proc::AOMultiMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::AOMultiMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOMultiMasterB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1)
     {
@@ -1362,7 +1378,7 @@ void proc::AOMultiMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::AOFirstMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOFirstMasterA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1381,7 +1397,7 @@ void proc::AOFirstMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::AOFirstMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOFirstMasterB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1395,7 +1411,7 @@ void proc::AOFirstMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::AOLastMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOLastMasterA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1415,7 +1431,7 @@ void proc::AOLastMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::AOLastMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOLastMasterB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1430,7 +1446,7 @@ void proc::AOLastMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::AONumMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AONumMasterA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1456,7 +1472,7 @@ void proc::AONumMasterA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AONumMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AONumMasterB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -1477,7 +1493,7 @@ void proc::AONumMasterB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::AOSingleA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOSingleA(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.optionMulti == -1)
     {
@@ -1495,7 +1511,7 @@ void proc::AOSingleA(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAni
     }
 }
 
-void proc::AOSingleB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::AOSingleB(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1508,7 +1524,7 @@ void proc::AOSingleB(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAni
     }
 }
 
-void proc::MAEMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAEMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1) ErrorMessage(1146, format, behaviorFile, curAnimInfo.numline);
 
@@ -1516,13 +1532,13 @@ void proc::MAEMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
         blocks[blok.front] = curAnimInfo.curAnim->GetGroupAnimInfo()[curAnimInfo.animMulti]->mainAnimEvent;
 }
 
-void proc::MAEFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAEFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
         blocks[blok.front] = curAnimInfo.curAnim->GetGroupAnimInfo()[0]->mainAnimEvent;
 }
 
-void proc::MAENextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAENextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1533,7 +1549,7 @@ void proc::MAENextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::MAEBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAEBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1544,7 +1560,7 @@ void proc::MAEBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::MAELastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAELastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1552,7 +1568,7 @@ void proc::MAELastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::MAENumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAENumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -1567,7 +1583,7 @@ void proc::MAENumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
     }
 }
 
-void proc::MAEMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAEMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1)
     {
@@ -1587,7 +1603,7 @@ void proc::MAEMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::MAEFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAEFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1600,7 +1616,7 @@ void proc::MAEFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::MAELastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAELastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1615,7 +1631,7 @@ void proc::MAELastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::MAENumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAENumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1635,12 +1651,12 @@ void proc::MAENumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cur
     }
 }
 
-void proc::MAESingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::MAESingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo)) blocks[blok.front] = curAnimInfo.mainAnimEvent;
 }
 
-void proc::addOnMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1) ErrorMessage(1146, format, behaviorFile, curAnimInfo.numline);
 
@@ -1677,7 +1693,7 @@ void proc::addOnMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::addOnFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1712,7 +1728,7 @@ void proc::addOnFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::addOnNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnNextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1751,7 +1767,7 @@ void proc::addOnNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::addOnBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1790,7 +1806,7 @@ void proc::addOnBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::addOnLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnLastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -1826,7 +1842,7 @@ void proc::addOnLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::addOnNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnNumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -1868,7 +1884,7 @@ void proc::addOnNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& cu
     }
 }
 
-void proc::addOnMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.animMulti == -1) ErrorMessage(1146, format, behaviorFile, curAnimInfo.numline);
 
@@ -1910,7 +1926,7 @@ void proc::addOnMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::addOnFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1950,7 +1966,7 @@ void proc::addOnFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::addOnLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnLastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.groupMulti == -1)
     {
@@ -1990,7 +2006,7 @@ void proc::addOnLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::addOnNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnNumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     size_t num = blok.olddataint[0];
 
@@ -2032,7 +2048,7 @@ void proc::addOnNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& c
     }
 }
 
-void proc::addOnSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::addOnSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -2083,7 +2099,7 @@ void proc::addOnSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curA
     }
 }
 
-void proc::lastState(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::lastState(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (clearBlocks(blok, blocks, curAnimInfo))
     {
@@ -2108,7 +2124,7 @@ void proc::lastState(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAni
     }
 }
 
-void proc::eventID(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::eventID(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string eventname = combineBlocks(blok.olddataint[0], blok.olddataint[1], blocks);
 
@@ -2127,7 +2143,7 @@ void proc::eventID(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimI
     }
 }
 
-void proc::variableID(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::variableID(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string variablename = combineBlocks(blok.olddataint[0], blok.olddataint[1], blocks);
 
@@ -2146,14 +2162,14 @@ void proc::variableID(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAn
     }
 }
 
-void proc::crc32(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::crc32(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string crc32line = nemesis::to_lower_copy(combineBlocks(blok, blocks));
 
     if (clearBlocks(blok, blocks, curAnimInfo)) blocks[blok.front] = to_string(CRC32Convert(crc32line));
 }
 
-void proc::import(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::import(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string import = combineBlocks(blok, blocks);
 
@@ -2210,6 +2226,8 @@ void proc::import(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimIn
             {
             }
 
+            if (curAnimInfo.idJournal) curAnimInfo.idJournal->touch(tempID);
+
             if (tempID.length() == 0)
             {
                 tempID = (isMaster || isGroup ? curAnimInfo.curGroup->newID() : curAnimInfo.curAnim->newID());
@@ -2226,7 +2244,7 @@ void proc::import(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimIn
     }
 }
 
-void proc::motionDataMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2264,7 +2282,7 @@ void proc::motionDataMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadI
     }
 }
 
-void proc::motionDataFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2297,7 +2315,7 @@ void proc::motionDataFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadI
     }
 }
 
-void proc::motionDataNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataNextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2332,7 +2350,7 @@ void proc::motionDataNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadIn
     }
 }
 
-void proc::motionDataBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2367,7 +2385,7 @@ void proc::motionDataBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadIn
     }
 }
 
-void proc::motionDataLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataLastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2400,7 +2418,7 @@ void proc::motionDataLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadIn
     }
 }
 
-void proc::motionDataNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataNumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2440,7 +2458,7 @@ void proc::motionDataNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInf
     }
 }
 
-void proc::motionDataMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2484,7 +2502,7 @@ void proc::motionDataMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThread
     }
 }
 
-void proc::motionDataFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2522,7 +2540,7 @@ void proc::motionDataFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThread
     }
 }
 
-void proc::motionDataLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataLastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2561,7 +2579,7 @@ void proc::motionDataLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadI
     }
 }
 
-void proc::motionDataNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataNumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2606,7 +2624,7 @@ void proc::motionDataNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadIn
     }
 }
 
-void proc::motionDataSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::motionDataSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2644,7 +2662,7 @@ void proc::motionDataSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo&
     }
 }
 
-void proc::rotationDataMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataMultiGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2679,7 +2697,7 @@ void proc::rotationDataMultiGroup(nemesis::scope blok, VecStr& blocks, AnimThrea
     }
 }
 
-void proc::rotationDataFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataFirstGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2712,7 +2730,7 @@ void proc::rotationDataFirstGroup(nemesis::scope blok, VecStr& blocks, AnimThrea
     }
 }
 
-void proc::rotationDataNextGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataNextGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2747,7 +2765,7 @@ void proc::rotationDataNextGroup(nemesis::scope blok, VecStr& blocks, AnimThread
     }
 }
 
-void proc::rotationDataBackGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataBackGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2782,7 +2800,7 @@ void proc::rotationDataBackGroup(nemesis::scope blok, VecStr& blocks, AnimThread
     }
 }
 
-void proc::rotationDataLastGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataLastGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2815,7 +2833,7 @@ void proc::rotationDataLastGroup(nemesis::scope blok, VecStr& blocks, AnimThread
     }
 }
 
-void proc::rotationDataNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataNumGroup(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2855,7 +2873,7 @@ void proc::rotationDataNumGroup(nemesis::scope blok, VecStr& blocks, AnimThreadI
     }
 }
 
-void proc::rotationDataMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataMultiMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2899,7 +2917,7 @@ void proc::rotationDataMultiMaster(nemesis::scope blok, VecStr& blocks, AnimThre
     }
 }
 
-void proc::rotationDataFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataFirstMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2937,7 +2955,7 @@ void proc::rotationDataFirstMaster(nemesis::scope blok, VecStr& blocks, AnimThre
     }
 }
 
-void proc::rotationDataLastMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataLastMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -2976,7 +2994,7 @@ void proc::rotationDataLastMaster(nemesis::scope blok, VecStr& blocks, AnimThrea
     }
 }
 
-void proc::rotationDataNumMaster(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataNumMaster(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -3021,7 +3039,7 @@ void proc::rotationDataNumMaster(nemesis::scope blok, VecStr& blocks, AnimThread
     }
 }
 
-void proc::rotationDataSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::rotationDataSingle(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.fixedStateID.size() != 0 || curAnimInfo.eventid.size() != 0
         || curAnimInfo.variableid.size() != 0)
@@ -3059,7 +3077,7 @@ void proc::rotationDataSingle(nemesis::scope blok, VecStr& blocks, AnimThreadInf
     }
 }
 
-void proc::animOrder(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::animOrder(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string animPath = combineBlocks(blok.olddataint[0], blok.olddataint[1], blocks);
 
@@ -3081,26 +3099,31 @@ void proc::animOrder(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAni
     }
 }
 
-void proc::regisAnim(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::regisAnim(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string animPath = combineBlocks(blok, blocks);
     addUsedAnim(behaviorFile, animPath);
 }
 
-void proc::regisBehavior(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::regisBehavior(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     string behaviorName = combineBlocks(blok, blocks);
     nemesis::to_lower(behaviorName);
     behaviorJoints[behaviorName].push_back(nemesis::to_lower_copy(behaviorFile));
 }
 
-void proc::localNegative(nemesis::scope blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+void proc::localNegative(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (combineBlocks(blok, blocks)[0] == '-') curAnimInfo.negative = true;
 }
 
-void proc::blocksCompile(VecStr blocks, AnimThreadInfo& curAnimInfo) const
+void proc::blocksCompile(const VecStr& rawblocks, AnimThreadInfo& curAnimInfo) const
 {
+    // working copy of the template line, reused by every line this thread compiles
+    // the one character blocks are short strings, so refilling it does not allocate once it has grown
+    thread_local VecStr blocks;
+    blocks = rawblocks;
+
     auto bkitr = brackets.find(curAnimInfo.numline);
 
     if (bkitr != brackets.end())
@@ -3163,7 +3186,15 @@ void proc::blocksCompile(VecStr blocks, AnimThreadInfo& curAnimInfo) const
         curAnimInfo.captured.reset();
     }
 
+    size_t length = 0;
+
+    for (auto& each : blocks)
+    {
+        length += each.length();
+    }
+
     curAnimInfo.line->clear();
+    curAnimInfo.line->reserve(length);
 
     for (auto& each : blocks)
     {
@@ -3176,7 +3207,7 @@ bool proc::isThisMaster()
     return isMaster;
 }
 
-bool proc::clearBlocks(nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
+bool proc::clearBlocks(const nemesis::scope& blok, VecStr& blocks, AnimThreadInfo& curAnimInfo) const
 {
     if (curAnimInfo.failed.size() > 0)
     {
@@ -3215,7 +3246,7 @@ void proc::blockCheck(size_t front, size_t back, int numline)
     }
 }
 
-string proc::combineBlocks(nemesis::scope& blok, VecStr& blocks) const
+string proc::combineBlocks(const nemesis::scope& blok, VecStr& blocks) const
 {
     string option;
 
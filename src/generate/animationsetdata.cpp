@@ -564,24 +564,21 @@ void CRC32Process(vector<crc32>& storeline,
     storeline.insert(storeline.end(), newCRC.begin(), newCRC.end());
 }
 
-ASDFormat::position
-ASDPosition(VecStr animData, string project, string header, string modcode, int linecount, bool muteError)
+ASDLinePosition::ASDLinePosition(const VecStr& _animData, string _project, string _header, string _modcode)
+    : animData(_animData)
+    , project(move(_project))
+    , header(move(_header))
+    , modcode(move(_modcode))
+{
+}
+
+void ASDLinePosition::buildMarker()
 {
     // has function
     bool isOpen       = false;
-    int functionstart = -1;
     int conditionOpen = 0;
     unordered_map<int, bool> isCondition;
     unordered_map<int, bool> isConditionOri;
-    unordered_map<int, ASDFunct> marker;
-
-    if (linecount >= int(animData.size())) ErrorMessage(5010, modcode, project, header);
-
-    if (animData[linecount].find("<!-- ") != NOT_FOUND)
-    {
-        if (!muteError) ErrorMessage(3007, modcode, std::string("animationsetdatasinglefile.txt"), linecount, header);
-    }
-
     bool mod = false;
 
     for (uint i = 0; i < animData.size(); ++i)
@@ -673,7 +670,63 @@ ASDPosition(VecStr animData, string project, string header, string modcode, int
         }
     }
 
-    using namespace ASDFormat;
+    built = true;
+}
+
+void ASDLinePosition::buildTrace()
+{
+    // the walk is the search for the last line, which passes every other line on the way. it stays muted,
+    // errors are only raised for the lines they come before
+    trace = ASDLineTrace(animData.size());
+
+    try
+    {
+        int curline = 0;
+        int result  = PositionLineCondition(
+            curline, 0, int(animData.size()) - 1, animData, marker, modcode, header, true, true, &trace);
+
+        trace.finish(result == -2 ? -2 : 0);
+    }
+    catch (double curID)
+    {
+        trace.finish(static_cast<int>(curID));
+    }
+
+    traced = true;
+}
+
+ASDFormat::position ASDLinePosition::search(int linecount, bool muteError)
+{
+    int type = 0;
+
+    try
+    {
+        int curline = 0;
+        int result  = PositionLineCondition(curline, 0, linecount, animData, marker, modcode, header, true, muteError);
+
+        if (result == -2)
+        {
+            if (!muteError) ErrorMessage(5008, modcode, project, header);
+        }
+    }
+    catch (double curID)
+    {
+        type = static_cast<int>(curID);
+    }
+
+    return ASDConvert(type, muteError);
+}
+
+ASDFormat::position ASDLinePosition::at(int linecount, bool muteError)
+{
+    if (linecount >= int(animData.size())) ErrorMessage(5010, modcode, project, header);
+
+    if (animData[linecount].find("<!-- ") != NOT_FOUND)
+    {
+        if (!muteError) ErrorMessage(3007, modcode, std::string("animationsetdatasinglefile.txt"), linecount, header);
+    }
+
+    if (!built) buildMarker();
 
     if (linecount < 2 && functionstart < 1)
     {
@@ -681,32 +734,34 @@ ASDPosition(VecStr animData, string project, string header, string modcode, int
         // 1. V3
         // 2. equipcount
     }
-    else
-    {
-        int type = 0;
 
-        try
-        {
-            int curline = 0;
-            int result  = PositionLineCondition(
-                curline, 0, linecount, animData, marker, modcode, header, true, muteError);
+    // a target line inside a condition has the lines after it read from the original side of the condition,
+    // which the walk never does. those lines get their own search
+    if (marker[linecount].isCondition) return search(linecount, muteError);
 
-            if (result == -2)
-            {
-                if (!muteError) ErrorMessage(5008, modcode, project, header);
-            }
-        }
-        catch (double curID)
-        {
-            type = static_cast<int>(curID);
-        }
+    if (!traced) buildTrace();
+
+    int type = trace.type[linecount];
 
-        return ASDConvert(type, muteError);
+    if (trace.afterError[linecount] && !muteError)
+    {
+        ErrorMessage(5007, modcode, header, trace.errorLine < 0 ? linecount : trace.errorLine);
     }
 
-    if (!muteError) ErrorMessage(5009, project, header);
+    if (type == -2)
+    {
+        if (!muteError) ErrorMessage(5008, modcode, project, header);
 
-    return xerror;
+        type = 0;
+    }
+
+    return ASDConvert(type, muteError);
+}
+
+ASDFormat::position
+ASDPosition(const VecStr& animData, string project, string header, string modcode, int linecount, bool muteError)
+{
+    return ASDLinePosition(animData, project, header, modcode).at(linecount, muteError);
 }
 
 ASDFormat::position ASDConvert(int position, bool muteError)
@@ -773,15 +828,83 @@ ASDFormat::position ASDConvert(int position, bool muteError)
     return xerror;
 }
 
+ASDLineTrace::ASDLineTrace(size_t size)
+    : type(size, -1)
+    , afterError(size, false)
+{
+}
+
+void ASDLineTrace::leave(int line, double curType)
+{
+    if (line >= int(type.size()) || type[line] != -1) return;
+
+    type[line]       = static_cast<int>(curType);
+    afterError[line] = failed;
+}
+
+void ASDLineTrace::fail(int line)
+{
+    if (failed) return;
+
+    failed    = true;
+    errorLine = line;
+}
+
+void ASDLineTrace::finish(int curType)
+{
+    // the walk stopped early, every line it has not left gets the type it stopped with
+    for (size_t i = 0; i < type.size(); ++i)
+    {
+        if (type[i] != -1) continue;
+
+        type[i]       = curType;
+        afterError[i] = failed;
+    }
+}
+
+namespace
+{
+    // the search runs up to the target line. on a walk the target is the last line, and each line is given
+    // the type it would have been found with as the target, when the walk leaves it
+    bool inRange(int i, double type, int linecount, ASDLineTrace* trace)
+    {
+        if (trace && i > 0) trace->leave(i - 1, type);
+
+        return i < linecount + 1;
+    }
+
+    bool reached(int i, double type, int linecount, ASDLineTrace* trace)
+    {
+        if (trace) trace->leave(i, type);
+
+        return i == linecount;
+    }
+
+    // line < 0 is the target line
+    void positionError(
+        int line, int linecount, const string& modcode, const string& header, bool muteError, ASDLineTrace* trace)
+    {
+        if (trace)
+        {
+            trace->fail(line);
+        }
+        else if (!muteError)
+        {
+            ErrorMessage(5007, modcode, header, line < 0 ? linecount : line);
+        }
+    }
+}
+
 int PositionLineCondition(int& i,
                           double curID,
                           int linecount,
-                          VecStr animDataSet,
+                          const VecStr& animDataSet,
                           unordered_map<int, ASDFunct>& marker,
                           string modcode,
                           string header,
                           bool last,
-                          bool muteError)
+                          bool muteError,
+                          ASDLineTrace* trace)
 {
     using namespace ASDFormat;
     double type         = curID;
@@ -790,7 +913,7 @@ int PositionLineCondition(int& i,
 
     if (type < 3)
     {
-        while (i < linecount + 1)
+        while (inRange(i, type, linecount, trace))
         {
             if (!marker[i].skip)
             {
@@ -805,7 +928,7 @@ int PositionLineCondition(int& i,
                     if (conditionOpen < marker[i].conditionOpen)
                     {
                         int exit = PositionLineCondition(
-                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError);
+                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError, trace);
 
                         if (exit == -1 && !last) return -1;
                     }
@@ -837,7 +960,7 @@ int PositionLineCondition(int& i,
 
                 if (marker[i].isNew)
                 {
-                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                     return -1;
                 }
@@ -853,7 +976,7 @@ int PositionLineCondition(int& i,
 
     if (type == 3)
     {
-        while (i < linecount + 1)
+        while (inRange(i, type, linecount, trace))
         {
             if (!marker[i].skip)
             {
@@ -868,7 +991,7 @@ int PositionLineCondition(int& i,
                     if (conditionOpen < marker[i].conditionOpen)
                     {
                         int exit = PositionLineCondition(
-                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError);
+                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError, trace);
 
                         if (exit == -1 && !last) return -1;
                     }
@@ -892,7 +1015,7 @@ int PositionLineCondition(int& i,
 
                 if (marker[i].isNew && type != 3)
                 {
-                    if (!muteError) ErrorMessage(5007, modcode, header, linecount);
+                    positionError(-1, linecount, modcode, header, muteError, trace);
 
                     return -1;
                 }
@@ -910,7 +1033,7 @@ int PositionLineCondition(int& i,
     {
         if (isOnlyNumber(animDataSet[i]) && animDataSet[i] == "0")
         {
-            if (i == linecount) throw type;
+            if (reached(i, type, linecount, trace)) throw type;
 
             ++type;
             ++type;
@@ -918,7 +1041,7 @@ int PositionLineCondition(int& i,
         }
         else
         {
-            while (i < linecount + 1)
+            while (inRange(i, type, linecount, trace))
             {
                 if (!marker[i].skip)
                 {
@@ -934,7 +1057,7 @@ int PositionLineCondition(int& i,
                         if (conditionOpen < marker[i].conditionOpen)
                         {
                             int exit = PositionLineCondition(
-                                i, type, linecount, animDataSet, marker, modcode, header, false, muteError);
+                                i, type, linecount, animDataSet, marker, modcode, header, false, muteError, trace);
 
                             if (exit == -1 && !last) return -1;
                         }
@@ -958,7 +1081,7 @@ int PositionLineCondition(int& i,
 
                     if (marker[i].isNew)
                     {
-                        if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                        positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                         return -1;
                     }
@@ -981,7 +1104,7 @@ int PositionLineCondition(int& i,
             type   = 14;
         }
 
-        while (i < linecount + 1)
+        while (inRange(i, type, linecount, trace))
         {
             if (!marker[i].skip)
             {
@@ -1111,7 +1234,7 @@ int PositionLineCondition(int& i,
                     if (conditionOpen < marker[i].conditionOpen)
                     {
                         int exit = PositionLineCondition(
-                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError);
+                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError, trace);
 
                         if (exit == -1 && !last) return -1;
                     }
@@ -1130,7 +1253,7 @@ int PositionLineCondition(int& i,
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
@@ -1143,7 +1266,7 @@ int PositionLineCondition(int& i,
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
@@ -1156,14 +1279,14 @@ int PositionLineCondition(int& i,
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
                         }
                         else
                         {
-                            if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                            positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                             return -1;
                         }
@@ -1194,7 +1317,7 @@ int PositionLineCondition(int& i,
                                 }
                                 else
                                 {
-                                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                     return -1;
                                 }
@@ -1207,7 +1330,7 @@ int PositionLineCondition(int& i,
                                 }
                                 else
                                 {
-                                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                     return -1;
                                 }
@@ -1220,14 +1343,14 @@ int PositionLineCondition(int& i,
                                 }
                                 else
                                 {
-                                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                     return -1;
                                 }
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
@@ -1239,7 +1362,7 @@ int PositionLineCondition(int& i,
                 {
                     if (type != 5 && type != 13 && type != 14)
                     {
-                        if (!muteError) ErrorMessage(5007, modcode, header, linecount);
+                        positionError(-1, linecount, modcode, header, muteError, trace);
 
                         return -1;
                     }
@@ -1258,14 +1381,14 @@ int PositionLineCondition(int& i,
     {
         if (isOnlyNumber(animDataSet[i]) && animDataSet[i] == "0")
         {
-            if (i == linecount) throw type;
+            if (reached(i, type, linecount, trace)) throw type;
 
             type = 11;
             ++i;
         }
         else
         {
-            while (i < linecount + 1)
+            while (inRange(i, type, linecount, trace))
             {
                 if (!marker[i].skip)
                 {
@@ -1281,7 +1404,7 @@ int PositionLineCondition(int& i,
                         if (conditionOpen < marker[i].conditionOpen)
                         {
                             int exit = PositionLineCondition(
-                                i, type, linecount, animDataSet, marker, modcode, header, false, muteError);
+                                i, type, linecount, animDataSet, marker, modcode, header, false, muteError, trace);
 
                             if (exit == -1 && !last) return -1;
                         }
@@ -1292,7 +1415,7 @@ int PositionLineCondition(int& i,
                         }
                         else if (type != 6)
                         {
-                            if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                            positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                             return -1;
                         }
@@ -1312,7 +1435,7 @@ int PositionLineCondition(int& i,
                         }
                         else if (type != 6)
                         {
-                            if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                            positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                             return -1;
                         }
@@ -1320,7 +1443,7 @@ int PositionLineCondition(int& i,
 
                     if (marker[i].isNew)
                     {
-                        if (!muteError) ErrorMessage(5007, modcode, header, linecount);
+                        positionError(-1, linecount, modcode, header, muteError, trace);
 
                         return -1;
                     }
@@ -1343,7 +1466,7 @@ int PositionLineCondition(int& i,
             type   = 10;
         }
 
-        while (i < linecount + 1)
+        while (inRange(i, type, linecount, trace))
         {
             if (!marker[i].skip)
             {
@@ -1455,7 +1578,7 @@ int PositionLineCondition(int& i,
                     if (conditionOpen < marker[i].conditionOpen)
                     {
                         int exit = PositionLineCondition(
-                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError);
+                            i, type, linecount, animDataSet, marker, modcode, header, false, muteError, trace);
 
                         if (exit == -1 && !last) return -1;
                     }
@@ -1488,7 +1611,7 @@ int PositionLineCondition(int& i,
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
@@ -1501,7 +1624,7 @@ int PositionLineCondition(int& i,
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
@@ -1514,7 +1637,7 @@ int PositionLineCondition(int& i,
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
@@ -1527,14 +1650,14 @@ int PositionLineCondition(int& i,
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
                         }
                         else
                         {
-                            if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                            positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                             return -1;
                         }
@@ -1579,7 +1702,7 @@ int PositionLineCondition(int& i,
                                 }
                                 else
                                 {
-                                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                     return -1;
                                 }
@@ -1592,7 +1715,7 @@ int PositionLineCondition(int& i,
                                 }
                                 else
                                 {
-                                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                     return -1;
                                 }
@@ -1605,7 +1728,7 @@ int PositionLineCondition(int& i,
                                 }
                                 else
                                 {
-                                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                     return -1;
                                 }
@@ -1618,14 +1741,14 @@ int PositionLineCondition(int& i,
                                 }
                                 else
                                 {
-                                    if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                    positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                     return -1;
                                 }
                             }
                             else
                             {
-                                if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                                positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                                 return -1;
                             }
@@ -1637,7 +1760,7 @@ int PositionLineCondition(int& i,
                 {
                     if (type != 7 && type != 8 && type != 9 && type != 10)
                     {
-                        if (!muteError) ErrorMessage(5007, modcode, header, linecount);
+                        positionError(-1, linecount, modcode, header, muteError, trace);
 
                         return -1;
                     }
@@ -1656,13 +1779,13 @@ int PositionLineCondition(int& i,
     {
         if (isOnlyNumber(animDataSet[i]) && animDataSet[i] == "0")
         {
-            if (i == linecount) throw type;
+            if (reached(i, type, linecount, trace)) throw type;
 
             ++type;
         }
         else
         {
-            while (i < linecount + 1)
+            while (inRange(i, type, linecount, trace))
             {
                 bool invert = false;
 
@@ -1738,7 +1861,7 @@ int PositionLineCondition(int& i,
                         if (conditionOpen < marker[i].conditionOpen)
                         {
                             int exit = PositionLineCondition(
-                                i, type, linecount, animDataSet, marker, modcode, header, false, muteError);
+                                i, type, linecount, animDataSet, marker, modcode, header, false, muteError, trace);
 
                             if (exit == -1 && !last) return -1;
                         }
@@ -1749,7 +1872,7 @@ int PositionLineCondition(int& i,
                         }
                         else if (type != 11)
                         {
-                            if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                            positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                             return -1;
                         }
@@ -1769,7 +1892,7 @@ int PositionLineCondition(int& i,
                         }
                         else if (type != 11)
                         {
-                            if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+                            positionError(i + 1, linecount, modcode, header, muteError, trace);
 
                             return -1;
                         }
@@ -1777,7 +1900,7 @@ int PositionLineCondition(int& i,
 
                     if (marker[i].isNew)
                     {
-                        if (!muteError) ErrorMessage(5007, modcode, header, linecount);
+                        positionError(-1, linecount, modcode, header, muteError, trace);
 
                         return -1;
                     }
@@ -1796,7 +1919,7 @@ int PositionLineCondition(int& i,
     {
         if (!isOnlyNumber(animDataSet[i]))
         {
-            if (!muteError) ErrorMessage(5007, modcode, header, i + 1);
+            positionError(i + 1, linecount, modcode, header, muteError, trace);
 
             return -1;
         }
@@ -4,12 +4,23 @@
 
 using namespace std;
 
-AnimationUtility::AnimationUtility(string condition, ID neweventid, ID newvariableid, vector<int> newFixedStateID, vector<int> newStateCountMultiplier, bool newHasGroup,
+namespace
+{
+    const ID noID;
+}
+
+AnimationUtility::AnimationUtility()
+    : eventid(&noID)
+    , variableid(&noID)
+{
+}
+
+AnimationUtility::AnimationUtility(string condition, const ID& neweventid, const ID& newvariableid, vector<int> newFixedStateID, vector<int> newStateCountMultiplier, bool newHasGroup,
 	int newOptionMulti, int newAnimMulti, string newMultiOption)
 {
 	originalCondition = condition;
-	eventid = neweventid;
-	variableid = newvariableid;
+	eventid = &neweventid;
+	variableid = &newvariableid;
 	fixedStateID = newFixedStateID;
 	stateCountMultiplier = newStateCountMultiplier;
 	hasGroup = newHasGroup;
@@ -374,7 +374,7 @@ void BehaviorSub::CompilingAnimData()
                                     {
                                         string number
                                             = nemesis::regex_replace(string(catalyst[l + 1].second),
-                                                                   nemesis::regex("[a-zA-Z]+[$]([0-9]+)"),
+                                                                   nemesis::precompiled(nemesis::pattern::anim_data_id),
                                                                    string("\\1"));
 
                                         if (number != catalyst[l + 1].second && isOnlyNumber(number))
@@ -401,7 +401,7 @@ void BehaviorSub::CompilingAnimData()
                                     newline.clear();
                                     string number
                                         = nemesis::regex_replace(string(catalyst[++l].second),
-                                                                         nemesis::regex("[a-zA-Z]+[$]([0-9]+)"),
+                                                                         nemesis::precompiled(nemesis::pattern::anim_data_id),
                                                                          string("\\1"));
 
                                     if (number != catalyst[l].second && isOnlyNumber(number))
@@ -438,7 +438,7 @@ void BehaviorSub::CompilingAnimData()
                             else // new info added by mod
                             {
                                 string number = nemesis::regex_replace(
-                                    string(line), nemesis::regex("[a-zA-Z]+[$]([0-9]+)"), string("\\1"));
+                                    string(line), nemesis::precompiled(nemesis::pattern::anim_data_id), string("\\1"));
 
                                 if (number != line && isOnlyNumber(number))
                                 {
@@ -481,7 +481,7 @@ void BehaviorSub::CompilingAnimData()
                             else
                             {
                                 string number = nemesis::regex_replace(string(catalyst[l + 1].second),
-                                                                     nemesis::regex("[a-zA-Z]+[$]([0-9]+)"),
+                                                                     nemesis::precompiled(nemesis::pattern::anim_data_id),
                                                                      string("\\1"));
 
                                 if (number != catalyst[l + 1].second && isOnlyNumber(number))
@@ -942,7 +942,7 @@ void BehaviorSub::CompilingAnimData()
     string outpath = "new_behaviors\\"
                + behaviorPath[lowerBehaviorFile].substr(behaviorPath[lowerBehaviorFile].find("\\") + 1);
 #else
-    filesystem::path outpath = behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)];
+    filesystem::path outpath = behaviorPath[lowerBehaviorFile];
 #endif
     outpath.replace_extension(".txt");
     redirToStageDir(outpath, nemesisInfo);
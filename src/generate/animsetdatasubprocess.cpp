@@ -616,10 +616,10 @@ void BehaviorSub::CompilingASD()
 #ifdef DEBUG
         filesystem::path outpath
             = L"new_behaviors\\"
-                          + behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)].substr(
-                  behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)].find(L"\\") + 1);
+                          + behaviorPath[lowerBehaviorFile].substr(
+                  behaviorPath[lowerBehaviorFile].find(L"\\") + 1);
 #else
-        filesystem::path outpath = behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)];
+        filesystem::path outpath = behaviorPath[lowerBehaviorFile];
 #endif
         outpath.replace_extension(".txt");
         redirToStageDir(outpath, nemesisInfo);
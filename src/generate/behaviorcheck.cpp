@@ -125,17 +125,18 @@ void behaviorCheck(BehaviorStart* process)
     // test if anim file used has been registered
     for (auto& it : usedAnim)
     {
-        VecStr forwardPort = behaviorJoints[it.first];
+        VecStr forwardPort = behaviorJoints[it.first.str()];
 
         for (auto& behavior : forwardPort)
         {
-            auto& registBhvr = registeredAnim[nemesis::to_lower_copy(behavior)];
+            auto registBhvr = nemesis::find_key(registeredAnim, behavior);
 
             for (auto& path : it.second)
             {
                 string lowerfilename = nemesis::to_lower_copy(filesystem::path(path).filename().string());
 
-                if (registBhvr.find(lowerfilename) == registBhvr.end())
+                if (registBhvr == registeredAnim.end()
+                    || registBhvr->second.find(lowerfilename) == registBhvr->second.end())
                 {
                     WarningMessage(1013, behavior + ".hkx", path);
                 }
@@ -161,7 +162,7 @@ void behaviorCheck(BehaviorStart* process)
 
                     warning.pop_back();
                     warning.pop_back();
-                    WarningMessage(1014, animation.first, duplicatelist.first, warning);
+                    WarningMessage(1014, animation.first.str(), duplicatelist.first.str(), warning);
                 }
             }
             else
@@ -2,6 +2,7 @@
 #include "nemesisinfo.h"
 
 #include <atomic>
+#include <chrono>
 #include <filesystem>
 
 #include <QtCore/QProcess>
@@ -200,3 +201,150 @@ std::string HkxCompiler::xmlDecompile(fpath hkxfile, fpath xmlfile, const HkxCom
 
     return output;
 }
+
+HkxConversionQueue::HkxConversionQueue(const HkxCompiler& _compiler, size_t _threadCount)
+    : compiler(_compiler)
+    , threadCount(_threadCount != 0 ? _threadCount : max<size_t>(1, thread::hardware_concurrency()))
+{
+}
+
+HkxConversionQueue::~HkxConversionQueue()
+{
+    stop();
+}
+
+void HkxConversionQueue::push(fpath xmlfile, fpath hkxfile, function<void(bool)> done)
+{
+    {
+        lock_guard<mutex> lock(jobMutex);
+        jobs.push_back(Job{move(xmlfile), move(hkxfile), move(done)});
+
+        if (converters.size() == 0)
+        {
+            stopping = false;
+
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                converters.emplace_back(&HkxConversionQueue::run, this);
+            }
+        }
+    }
+
+    wake.notify_one();
+}
+
+void HkxConversionQueue::wait()
+{
+    unique_lock<mutex> lock(jobMutex);
+    idle.wait(lock, [&] { return jobs.empty() && running == 0; });
+}
+
+void HkxConversionQueue::stop()
+{
+    vector<thread> finished;
+
+    {
+        unique_lock<mutex> lock(jobMutex);
+        idle.wait(lock, [&] { return jobs.empty() && running == 0; });
+        stopping = true;
+        finished.swap(converters);
+    }
+
+    wake.notify_all();
+
+    for (auto& converter : finished)
+    {
+        converter.join();
+    }
+}
+
+// reports the job as failed unless it has reported back itself, so a conversion that throws still ends its behavior
+struct ConversionEnd
+{
+    function<void(bool)>& done;
+    bool reported = false;
+
+    ConversionEnd(function<void(bool)>& _done)
+        : done(_done)
+    {
+    }
+
+    ~ConversionEnd()
+    {
+        if (reported) return;
+
+        try
+        {
+            done(false);
+        }
+        catch (...)
+        {
+            // the error has been reported already
+        }
+    }
+};
+
+void HkxConversionQueue::run()
+{
+    while (true)
+    {
+        Job job;
+
+        {
+            unique_lock<mutex> lock(jobMutex);
+            wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+
+            if (jobs.empty()) return;
+
+            job = move(jobs.front());
+            jobs.pop_front();
+            ++running;
+        }
+
+        {
+            auto start   = chrono::steady_clock::now();
+            bool success = false;
+            ConversionEnd end(job.done);
+
+            try
+            {
+                try
+                {
+                    success = compiler.hkxcmdProcess(job.xmlfile, job.hkxfile);
+                    auto duration
+                        = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+                    DebugLogging(L"HKX conversion: " + job.hkxfile.wstring() + L" (" + to_wstring(duration.count())
+                                 + L"ms)");
+                    job.done(success);
+                    end.reported = true;
+                }
+                catch (exception& ex)
+                {
+                    ErrorMessage(6002, job.xmlfile, ex.what());
+                }
+            }
+            catch (nemesis::exception&)
+            {
+                // resolved exception
+            }
+            catch (...)
+            {
+                try
+                {
+                    ErrorMessage(6002, job.xmlfile, "Unknown");
+                }
+                catch (nemesis::exception&)
+                {
+                    // resolved exception
+                }
+            }
+        }
+
+        {
+            lock_guard<mutex> lock(jobMutex);
+            --running;
+
+            if (jobs.empty() && running == 0) idle.notify_all();
+        }
+    }
+}
@@ -185,6 +185,175 @@ void BehaviorStart::InitializeGeneration()
     EndAttempt();
 }
 
+namespace
+{
+    uint64_t hashList(const unordered_map<string, VecStr>& list, uint64_t seed)
+    {
+        map<string, const VecStr*> sorted;
+
+        for (auto& each : list)
+        {
+            sorted[each.first] = &each.second;
+        }
+
+        for (auto& each : sorted)
+        {
+            seed = nemesis::hash_content(each.first, seed);
+            seed = nemesis::hash_content(each.second->size(), seed);
+
+            for (auto& value : *each.second)
+            {
+                seed = nemesis::hash_content(value, seed);
+            }
+        }
+
+        return seed;
+    }
+
+    uint64_t hashList(const unordered_map<string, string>& list, uint64_t seed)
+    {
+        map<string, string> sorted(list.begin(), list.end());
+
+        for (auto& each : sorted)
+        {
+            seed = nemesis::hash_content(each.first, seed);
+            seed = nemesis::hash_content(each.second, seed);
+        }
+
+        return seed;
+    }
+
+    uint64_t hashList(const unordered_map<nemesis::InternedKey, string>& list, uint64_t seed)
+    {
+        map<string, string> sorted;
+
+        for (auto& each : list)
+        {
+            sorted[each.first.str()] = each.second;
+        }
+
+        for (auto& each : sorted)
+        {
+            seed = nemesis::hash_content(each.first, seed);
+            seed = nemesis::hash_content(each.second, seed);
+        }
+
+        return seed;
+    }
+}
+
+void BehaviorStart::hashGenerationInputs(const TemplateInfo* BehaviorTemplate,
+                                         const vector<unique_ptr<registerAnimation>>& animationList)
+{
+    generationCache.setInput("engine", nemesis::hash_content(GetNemesisVersion() + (SSE ? " SSE" : " LE")));
+
+    // behavior file, template codes that edit it
+    map<string, set<string>> behaviorCodes;
+
+    for (auto& behavior : BehaviorTemplate->grouplist)
+    {
+        behaviorCodes[behavior.first].insert(behavior.second.begin(), behavior.second.end());
+    }
+
+    for (auto& code : BehaviorTemplate->behaviortemplate)
+    {
+        string basecode = code.first;
+
+        for (string suffix : {"_group", "_master"})
+        {
+            if (basecode.length() > suffix.length()
+                && basecode.compare(basecode.length() - suffix.length(), suffix.length(), suffix) == 0)
+            {
+                basecode.resize(basecode.length() - suffix.length());
+                break;
+            }
+        }
+
+        for (auto& behavior : code.second)
+        {
+            behaviorCodes[behavior.first].insert(basecode);
+        }
+    }
+
+    for (auto& core : BehaviorTemplate->coreBehaviorCode)
+    {
+        behaviorCodes[core.first].insert(core.second);
+    }
+
+    // animation lists in the order they are registered, which is the order the animations are added
+    unordered_map<string, uint64_t> animHash;
+
+    for (auto& animList : animationList)
+    {
+        for (auto& code : animList->templateType)
+        {
+            uint64_t& hash = animHash.emplace(code.first, nemesis::hash_seed).first->second;
+            hash           = nemesis::hash_content(animList->modID, hash);
+            hash           = nemesis::hash_content(animList->contentHash, hash);
+        }
+    }
+
+    unordered_map<string, uint64_t> templateHash;
+
+    for (auto& behavior : behaviorCodes)
+    {
+        uint64_t hash = nemesis::hash_seed;
+
+        for (auto& code : behavior.second)
+        {
+            auto itr = templateHash.find(code);
+
+            if (itr == templateHash.end())
+            {
+                itr = templateHash.emplace(code, nemesis::hash_directory("behavior templates\\" + code)).first;
+            }
+
+            auto anim = animHash.find(code);
+            hash      = nemesis::hash_content(code, hash);
+            hash      = nemesis::hash_content(itr->second, hash);
+            hash      = nemesis::hash_content(anim != animHash.end() ? anim->second : 0, hash);
+        }
+
+        generationCache.setInput("behavior " + behavior.first, hash);
+    }
+
+    uint64_t aaHash = hashList(alternateAnim, nemesis::hash_seed);
+    aaHash          = hashList(groupAA, aaHash);
+    aaHash          = hashList(groupAAPrefix, aaHash);
+    aaHash          = hashList(AAEvent, aaHash);
+    aaHash          = hashList(AAHasEvent, aaHash);
+    aaHash          = hashList(AAGroup, aaHash);
+    generationCache.setInput("alternate animation", aaHash);
+
+    uint64_t pceaHash = nemesis::hash_content(pcealist.size(), nemesis::hash_seed);
+
+    for (auto& pcea : pcealist)
+    {
+        pceaHash = nemesis::hash_content(pcea.modFile, pceaHash);
+        pceaHash = hashList(pcea.animPathList, pceaHash);
+    }
+
+    map<string, const vector<PCEAData>*> replaced;
+
+    for (auto& each : animReplaced)
+    {
+        replaced[each.first] = &each.second;
+    }
+
+    for (auto& each : replaced)
+    {
+        pceaHash = nemesis::hash_content(each.first, pceaHash);
+
+        for (auto& data : *each.second)
+        {
+            pceaHash = nemesis::hash_content(data.modFile, pceaHash);
+            pceaHash = nemesis::hash_content(data.animPath, pceaHash);
+        }
+    }
+
+    generationCache.setInput("pcea", pceaHash);
+}
+
 void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
 {
     // register animation & organize AE n Var
@@ -217,6 +386,27 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
 
     DebugLogging("Registering new animations...");
 
+    // templates are examined once per template code and shared, read only, by every animation of that code
+    unordered_map<string, shared_ptr<const unordered_map<string, VecStr>>> sharedRawTemplate;
+    unordered_map<string, shared_ptr<unordered_map<string, AnimTemplate>>> sharedAnimTemplate;
+    unordered_map<string, shared_ptr<unordered_map<string, unordered_map<string, AnimTemplate>>>>
+        sharedAnimdataTemplate;
+    unordered_map<string, shared_ptr<unordered_map<string, map<string, AnimTemplate, alphanum_less>>>>
+        sharedAsdTemplate;
+    shared_ptr<const unordered_map<string, VecStr>> noRawTemplate
+        = make_shared<const unordered_map<string, VecStr>>();
+
+    auto getRawTemplate = [&](const string& code) {
+        auto& raw = sharedRawTemplate[code];
+
+        if (!raw)
+        {
+            raw = make_shared<const unordered_map<string, VecStr>>(BehaviorTemplate->behaviortemplate[code]);
+        }
+
+        return raw;
+    };
+
     // read each animation list file'
     for (uint i = 0; i < animationList.size(); ++i)
     {
@@ -234,18 +424,26 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
             string templatecode = it->first;
             DebugLogging("Registering " + templatecode + " animations");
             vector<shared_ptr<AnimationInfo>> animInfoGroup;
-            shared_ptr<unordered_map<string, AnimTemplate>> animTemplate
-                = make_shared<unordered_map<string, AnimTemplate>>(); // behavior file, template
+            // behavior file, template
+            shared_ptr<unordered_map<string, AnimTemplate>>& animTemplate = sharedAnimTemplate[templatecode];
 
             // project, header, template
-            shared_ptr<unordered_map<string, unordered_map<string, AnimTemplate>>> animdataTemplate
-                = make_shared<unordered_map<string, unordered_map<string, AnimTemplate>>>();
+            shared_ptr<unordered_map<string, unordered_map<string, AnimTemplate>>>& animdataTemplate
+                = sharedAnimdataTemplate[templatecode];
 
             // project, header, template
-            shared_ptr<unordered_map<string, map<string, AnimTemplate, alphanum_less>>> asdTemplate
-                = make_shared<unordered_map<string, map<string, AnimTemplate, alphanum_less>>>();
+            shared_ptr<unordered_map<string, map<string, AnimTemplate, alphanum_less>>>& asdTemplate
+                = sharedAsdTemplate[templatecode];
+
+            // templates already examined for another mod skip the examination below
+            if (!animTemplate)
+            {
+                animTemplate     = make_shared<unordered_map<string, AnimTemplate>>();
+                animdataTemplate = make_shared<unordered_map<string, unordered_map<string, AnimTemplate>>>();
+                asdTemplate = make_shared<unordered_map<string, map<string, AnimTemplate, alphanum_less>>>();
+            }
 
-            unordered_map<string, VecStr>* functionlines = &BehaviorTemplate->behaviortemplate[templatecode];
+            shared_ptr<const unordered_map<string, VecStr>> functionlines = getRawTemplate(templatecode);
             unordered_map<string, unordered_map<string, VecStr>>* animdatalines
                 = &BehaviorTemplate->animdatatemplate[templatecode];
             unordered_map<string, map<string, VecStr, alphanum_less>>* asdlines
@@ -259,7 +457,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
             if (BehaviorTemplate->coreTemplate[templatecode].length() > 0)
             {
                 coreModName     = "Nemesis_" + modID + "_";
-                wstring corepath = wstring(behaviorPath[nemesis::transform_to<wstring>(BehaviorTemplate->coreTemplate[templatecode])]);
+                wstring corepath = wstring(behaviorPath[BehaviorTemplate->coreTemplate[templatecode]]);
                 wstring corename = GetFileName(corepath);
                 corepath        = corepath.substr(0, corepath.length() - corename.length());
                 DebugLogging(L"Core behavior name: " + corename);
@@ -282,8 +480,8 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                     {
                         DebugLogging("Core Registration: " + corecode);
                         coreRegistered.insert(corecode);
-                        unordered_map<string, VecStr>* c_functionlines
-                            = &BehaviorTemplate->behaviortemplate[corecode];
+                        shared_ptr<const unordered_map<string, VecStr>> c_functionlines
+                            = getRawTemplate(corecode);
                         shared_ptr<AnimationInfo> dummy = make_shared<AnimationInfo>();
 
                         if (isFileExist(corepath + L"FNIS_" + nemesis::transform_to<wstring>(modID) + L"_"
@@ -315,7 +513,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                             newAnimation[corecode].emplace_back(
                                 make_unique<NewAnimation>(make_shared<unordered_map<string, AnimTemplate>>(),
                                                           corecode,
-                                                          *c_functionlines,
+                                                          c_functionlines,
                                                           animationCount[corecode],
                                                           "",
                                                           *dummy));
@@ -344,7 +542,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                             newAnimation[corecode].emplace_back(
                                 make_unique<NewAnimation>(c_animTemplate,
                                                           corecode,
-                                                          unordered_map<string, VecStr>(),
+                                                          noRawTemplate,
                                                           animationCount[corecode],
                                                           "",
                                                           *dummy));
@@ -429,13 +627,13 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                     newAnimation[templatecode].emplace_back(
                         make_unique<NewAnimation>(animTemplate,
                                                   templatecode,
-                                                  *functionlines,
+                                                  functionlines,
                                                   animationCount[templatecode],
                                                   modID + "\\",
                                                   *animationList[i]->animInfo[templatecode][j]));
 
-                    newAnimation[templatecode].back()->addAnimData(*animdataTemplate);
-                    newAnimation[templatecode].back()->addAnimSetData(*asdTemplate);
+                    newAnimation[templatecode].back()->addAnimData(animdataTemplate);
+                    newAnimation[templatecode].back()->addAnimSetData(asdTemplate);
 
                     newAnimation[templatecode].back()->coreModID = coreModName;
                     VecStr tempEventID    = newAnimation[templatecode].back()->GetEventID();
@@ -822,7 +1020,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
             --multi;
         }
 
-        filenum += (multi * 10);
+        filenum += (multi * BehaviorSub::milestoneCount);
         DebugLogging("Process count: " + to_string(filenum));
         emit progressMax(filenum);
     }
@@ -899,6 +1097,9 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
 
     if (error) throw nemesis::exception();
 
+    generationCache.load();
+    hashGenerationInputs(BehaviorTemplate.get(), animationList);
+
     VecWstr filelist;
     read_directory(directory, filelist);
     emit progressUp();
@@ -913,7 +1114,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
             if (coreModList.find(lowerFileName) != coreModList.end())
             {
                 int repeat = int(coreModList[lowerFileName].size()) - 1;
-                filenum += repeat * 10;
+                filenum += repeat * BehaviorSub::milestoneCount;
             }
         }
         else if (wordFind(file, L"_1stperson") != NOT_FOUND)
@@ -928,14 +1129,19 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                 if (coreModList.find(lowerFileName) != coreModList.end())
                 {
                     int repeat = int(coreModList[lowerFileName].size()) - 1;
-                    filenum += repeat * 10;
+                    filenum += repeat * BehaviorSub::milestoneCount;
                 }
             }
         }
     }
 
+#if defined(QUEUED_HKX_CONVERSION)
+    // declared before the task group so every conversion the generators pushed is finished before it is gone
+    HkxConversionQueue conversion(hkxCompiler, nemesisInfo->GetHkxConverters());
+    hkxConversion = &conversion;
+#endif
 #if defined(MULTITHREADED_UPDATE_2)
-    nemesis::ThreadPool tp;
+    nemesis::TaskGroup tp;
 #endif
     vector<BehaviorSub*> behaviorSubList;
 
@@ -1008,7 +1214,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                     if (lowerFileName == L"animationdatasinglefile.txt")
                     {
                         #if defined(MULTITHREADED_UPDATE_2)
-                        tp.enqueue(&BehaviorSub::AnimDataCompilation, worker); // 9 progress ups
+                        tp.run(&BehaviorSub::AnimDataCompilation, worker); // 9 progress ups
                         #else
                             worker->AnimDataCompilation(); // 9 progress ups
                         #endif
@@ -1016,7 +1222,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                     else if (lowerFileName == L"animationsetdatasinglefile.txt")
                     {
                         #if defined(MULTITHREADED_UPDATE_2)
-                        tp.enqueue(&BehaviorSub::ASDCompilation, worker);
+                        tp.run(&BehaviorSub::ASDCompilation, worker);
                         #else
                             worker->ASDCompilation();
                         #endif
@@ -1026,7 +1232,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                         if (temppath.find(L"characters") == 0) worker->isCharacter = true;
 
                         #if defined(MULTITHREADED_UPDATE_2)
-                        tp.enqueue(&BehaviorSub::BehaviorCompilation, worker);
+                        tp.run(&BehaviorSub::BehaviorCompilation, worker);
                         #else
                             worker->BehaviorCompilation();
                         #endif
@@ -1062,7 +1268,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                             repeat = int(coreModList[lowerFileName].size());
                             isCore = true;
 
-                            if (repeat > 1) filenum += (repeat - 1) * 10;
+                            if (repeat > 1) filenum += (repeat - 1) * BehaviorSub::milestoneCount;
                         }
 
                         while (repeatcount < repeat)
@@ -1073,7 +1279,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
 
                             bool skip           = false;
                             wstring tempfilename = lowerFileName.substr(0, lowerFileName.find_last_of(L"."));
-                            wstring temppath     = behaviorPath[nemesis::transform_to<wstring>(tempfilename)];
+                            wstring temppath     = behaviorPath[tempfilename];
 
                             if (temppath.length() != 0)
                             {
@@ -1112,7 +1318,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                             if (lowerFileName == L"animationdatasinglefile.txt")
                             {
                                 #if defined(MULTITHREADED_UPDATE_2)
-                                    tp.enqueue(&BehaviorSub::AnimDataCompilation, worker); // 9 progress ups
+                                    tp.run(&BehaviorSub::AnimDataCompilation, worker); // 9 progress ups
                                 #else
                                     worker->AnimDataCompilation();
                                 #endif
@@ -1120,7 +1326,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                             else if (lowerFileName == L"animationsetdatasinglefile.txt")
                             {
                                 #if defined(MULTITHREADED_UPDATE_2)
-                                    tp.enqueue(&BehaviorSub::ASDCompilation, worker);
+                                    tp.run(&BehaviorSub::ASDCompilation, worker);
                                 #else
                                     worker->ASDCompilation();
                                 #endif
@@ -1130,7 +1336,7 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
                                 if (temppath.find(L"characters") == 0) worker->isCharacter = true;
 
                                 #if defined(MULTITHREADED_UPDATE_2)
-                                    tp.enqueue(&BehaviorSub::BehaviorCompilation, worker);
+                                    tp.run(&BehaviorSub::BehaviorCompilation, worker);
                                 #else
                                     worker->BehaviorCompilation();
                                 #endif
@@ -1146,9 +1352,13 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
     catch (exception& ex)
     {
         #if defined(MULTITHREADED_UPDATE_2)
-        tp.join_all();
+        tp.wait();
         #endif
-        
+        #if defined(QUEUED_HKX_CONVERSION)
+        conversion.stop();
+        hkxConversion = nullptr;
+        #endif
+
         // TODO: check what code below does? simply emptying vector?
         for (auto& each : behaviorSubList)
         {
@@ -1168,9 +1378,15 @@ void BehaviorStart::GenerateBehavior(std::thread*& checkThread)
     #if defined(MULTITHREADED_UPDATE_2)
     cv2.notify_one();
 
-    tp.join_all();
+    tp.wait();
+    #endif
+    #if defined(QUEUED_HKX_CONVERSION)
+    conversion.stop();
+    hkxConversion = nullptr;
     #endif
 
+    if (!error) generationCache.save();
+
     for (auto& each : behaviorSubList)
     {
         delete each;
@@ -1233,7 +1449,7 @@ void BehaviorStart::milestoneStart()
         if (!sf::is_directory(directory + L"\\" + file) && file.find(L".txt") == file.length() - 4) ++include;
     }
 
-    filenum = (include * 10) + add;
+    filenum = (include * BehaviorSub::milestoneCount) + add;
 }
 
 void BehaviorStart::unregisterProcess(bool skip)
@@ -1308,11 +1524,20 @@ void BehaviorStart::EndAttempt()
 
         try
         {
-            for (int i = 0; i < failedBehaviors.size(); i += 2)
+            vector<pair<wstring, wstring>> retry;
+
+            for (size_t i = 0; i + 1 < failedBehaviors.size(); i += 2)
+            {
+                retry.emplace_back(failedBehaviors[i], failedBehaviors[i + 1]);
+            }
+
+            // conversions finish in any order, retry them in a fixed one
+            sort(retry.begin(), retry.end());
+
+            for (auto& each : retry)
             {
-                hkxCompiler.hkxcmdProcess(failedBehaviors[i], failedBehaviors[i + 1], true);
-                DebugLogging(L"Processing behavior: " + failedBehaviors[i]
-                             + L" (Check point #, Behavior compile complete)");
+                hkxCompiler.hkxcmdProcess(each.first, each.second, true);
+                DebugLogging(L"Processing behavior: " + each.first + L" (Check point #, Behavior compile complete)");
                 emit progressUp();
             }
 
@@ -2,6 +2,7 @@
 
 #include "utilities/algorithm.h"
 #include "utilities/atomiclock.h"
+#include "utilities/hkxpackfile.h"
 
 #include "generate/behaviorgenerator.h"
 #include "generate/behaviorprocess_utility.h"
@@ -24,14 +25,8 @@ void animThreadStart(shared_ptr<NewAnimArgs> args)
 	{
 		try
 		{
-			if (args->core)
-			{
-                Lockless lock(args->atomicLock.coreLock);
-
-				if (args->isCoreDone) return;
-
-				args->isCoreDone = true;
-			}
+			// core template ownership is settled before dispatch so the same job always produces it
+			if (args->skip) return;
 
 			// getlines from newAnination
 			args->dummyAnimation->setZeroEvent(args->ZeroEvent);
@@ -134,79 +129,51 @@ void unpackToCatalyst(map<int, VecStr>& catalystMap, unordered_map<int, shared_p
 
 int bonePatch(std::filesystem::path rigfile, int oribone, bool& newBone, const HkxCompiler& hkxCompiler)
 {
-    int bonenum;
+    // only the character skeleton counts, not the ragdoll or any other skeleton of the rig
+    const string rootSkeleton = "NPC Root [Root]";
+    int bonenum = 0;
+    int num     = 0;
 
-    if (SSE)
+    if (auto facts = nemesis::hkx_facts(rigfile); facts->packfile)
     {
-        FILE* bonefile;
-        _wfopen_s(&bonefile, rigfile.wstring().c_str(), L"r+b");
-
-        if (bonefile)
-        {
-            uint16_t num = 0;
-            vector<char> chlist;
-            string line;
-
-            while (!feof(bonefile))
-            {
-                char c = fgetc(bonefile);
-                chlist.push_back(c);
-                line.push_back(c);
-            }
-
-            fclose(bonefile);
-
-            using uchar     = unsigned char;
-            bool startCount = false;
-            bool start      = true;
-            string::size_type pos        = line.find("NPC Root [Root]");
-
-			if (pos != NOT_FOUND && pos > 64)
-            {
-                pos -= 64;
-                char* ch = reinterpret_cast<char*>(&num);
-                ch[0]    = chlist[pos];
-                ch[1]    = chlist[pos + 1];
-			}
-
-            if (error) throw nemesis::exception();
-
-            if (oribone < num)
-            {
-                bonenum = num - oribone;
-                newBone = true;
-            }
-        }
-        else
-        {
-            ErrorMessage(3002, rigfile);
-        }
+        if (auto skeleton = facts->findSkeleton(rootSkeleton)) num = skeleton->bones;
     }
-    else
+    else if (!SSE)
     {
         VecStr storeline;
         hkxCompiler.hkxcmdXmlInput(rigfile, storeline);
-        string bonemap = "<hkparam name=\"parentIndices\" numelements=\"";
+        string bonemap  = "<hkparam name=\"parentIndices\" numelements=\"";
+        bool inSkeleton = false;
+        bool isRoot     = false;
 
         for (auto& line : storeline)
         {
-            if (line.find(bonemap) != NOT_FOUND)
+            if (line.find("<hkobject name=\"") != NOT_FOUND)
+            {
+                inSkeleton = line.find("class=\"hkaSkeleton\"") != NOT_FOUND;
+                isRoot     = false;
+            }
+            else if (inSkeleton && line.find("<hkparam name=\"name\">") != NOT_FOUND)
+            {
+                isRoot = line.find(">" + rootSkeleton + "<") != NOT_FOUND;
+            }
+            else if (isRoot && line.find(bonemap) != NOT_FOUND)
             {
                 size_t pos = line.find(bonemap) + bonemap.length();
-                int num    = stoi(line.substr(pos, line.find("\">", pos) - pos));
-
-                if (oribone < num)
-                {
-                    bonenum = num - oribone;
-                    newBone = true;
-                    break;
-                }
+                num        = stoi(line.substr(pos, line.find("\">", pos) - pos));
+                break;
             }
         }
     }
 
     if (error) throw nemesis::exception();
 
+    if (oribone < num)
+    {
+        bonenum = num - oribone;
+        newBone = true;
+    }
+
     return bonenum;
 }
 
@@ -1,4 +1,5 @@
 #include <atomic>
+#include <cassert>
 #include <condition_variable>
 #include <stdexcept>
 
@@ -10,6 +11,7 @@
 #include "utilities/conditions.h"
 #include "utilities/threadpool.h"
 #include "utilities/atomiclock.h"
+#include "utilities/linearena.h"
 #include "utilities/stringsplit.h"
 #include "utilities/readtextfile.h"
 
@@ -26,6 +28,7 @@
 
 #include "generate/animation/import.h"
 #include "generate/animation/nodejoint.h"
+#include "generate/animation/nodeidledger.h"
 #include "generate/animation/templatetree.h"
 #include "generate/animation/grouptemplate.h"
 #include "generate/animation/singletemplate.h"
@@ -92,6 +95,33 @@ struct SubEnd
     }
 };
 
+struct BehaviorMilestones
+{
+    BehaviorStart* process;
+    int reached = 0;
+
+    BehaviorMilestones(BehaviorStart* _process)
+    {
+        process = _process;
+    }
+
+    // reports the step and every step before it that has not been reported yet
+    void reach(BehaviorStep step)
+    {
+        while (reached <= int(step))
+        {
+            process->newMilestone();
+            ++reached;
+        }
+    }
+
+    // for the paths that end the behavior early, the steps they skip are counted as done
+    void skipRest()
+    {
+        reach(BehaviorStep::Compiled);
+    }
+};
+
 BehaviorSub::BehaviorSub(const NemesisInfo* _ini)
 {
     nemesisInfo = _ini;
@@ -168,11 +198,11 @@ bool BehaviorSub::modPickProcess(unordered_map<string, vector<pair<uint, shared_
 
     if (hasDeleted || orig.size() <= 2) return false;
 
-    string templine = nemesis::regex_replace(*orig[0].second, nemesis::regex("^([\t]+).*$"), string("\\1"));
+    string templine = nemesis::regex_replace(*orig[0].second, nemesis::precompiled(nemesis::pattern::leading_tabs), string("\\1"));
     int counter     = count(templine.begin(), templine.end(), '\t');
 
     string lastline
-        = nemesis::regex_replace(*orig.back().second, nemesis::regex("^([\t]+).*$"), string("\\1"));
+        = nemesis::regex_replace(*orig.back().second, nemesis::precompiled(nemesis::pattern::leading_tabs), string("\\1"));
     int counter2    = count(lastline.begin(), lastline.end(), '\t');
 
     if (counter != counter2) return false;
@@ -182,7 +212,7 @@ bool BehaviorSub::modPickProcess(unordered_map<string, vector<pair<uint, shared_
     for (unsigned int i = 0; i < orig.size(); ++i)
     {
         string templine
-            = nemesis::regex_replace(*orig[i].second, nemesis::regex("^([\t]+).*$"), string("\\1"));
+            = nemesis::regex_replace(*orig[i].second, nemesis::precompiled(nemesis::pattern::leading_tabs), string("\\1"));
 
         if (*orig[i].second != templine)
         {
@@ -305,32 +335,76 @@ void BehaviorSub::CompilingBehavior()
 #else
     if (modID.length() > 0)
     {
-        outputdir = GetFileDirectory(behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)]).data()
+        outputdir = GetFileDirectory(behaviorPath[lowerBehaviorFile]).data()
                     + nemesis::transform_to<wstring>(modID)
                     + nemesis::transform_to<wstring>(lowerBehaviorFile);
     }
     else
     {
-        outputdir = behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)];
+        outputdir = behaviorPath[lowerBehaviorFile];
     }
 #endif
     if (error) throw nemesis::exception();
 
     DebugLogging(L"Processing behavior: " + filepath);
     DebugLogging(L"Behavior output path: " + outputdir.wstring());
-    process->newMilestone();
+    BehaviorMilestones milestones(process);
+    milestones.reach(BehaviorStep::Start);
 
     if (modID.length() > 0 && isFileExist(outputdir.wstring() + L".hkx"))
     {
-        int i = 0;
+        milestones.skipRest();
+        return;
+    }
+
+    // character behaviors register the animations and their bone data, they are always rebuilt
+    uint64_t cacheKey = 0;
+    VecStr cacheReplay;
+
+    if (!isCharacter)
+    {
+        nemesis::MappedFile content(filepath);
 
-        while (i < 9)
+        if (content.is_open())
         {
-            process->newMilestone();
-            ++i;
-        }
+            sf::path stagedir = outputdir;
+            redirToStageDir(stagedir, nemesisInfo);
+            cacheKey = generationKey(lowerBehaviorFile, content.view());
 
-        return;
+            if (process->generationCache.find(stagedir.wstring(), cacheKey, cacheReplay))
+            {
+                // a cached behavior only replays the clip and behavior references of its output
+                // what the full generation does besides is safe to skip:
+                // - registeredAnim, charAnimDataInfo, animModMatch and the animation count are only
+                //   written from an animationNames list, a behavior with one is never cached
+                // - checkBehaviorJoint only runs for character behaviors, they are never cached
+                // - the node, state and import IDs are local to this behavior
+                // - alternateAnim, AAGroup, AAEvent and pcealist are only read
+                assert(!isCharacter);
+                auto joint = behaviorJoints.find(lowerBehaviorFile);
+                VecStr characterFiles;
+                bool isClip     = false;
+                bool isBehavior = false;
+                string clipName;
+                wstring projectdir = stagedir.parent_path().parent_path().wstring();
+
+                if (joint != behaviorJoints.end()) characterFiles = joint->second;
+
+                for (auto& line : cacheReplay)
+                {
+                    checkClipAnimData(
+                        stagedir, projectdir, line, characterFiles, clipName, isClip, process, isBehavior);
+                }
+
+                milestones.skipRest();
+                DebugLogging(L"Processing behavior: " + filepath
+                             + L" (Check point 3.2, Unchanged since last generation)");
+                return;
+            }
+
+            process->generationCache.erase(stagedir.wstring());
+            cacheReplay.clear();
+        }
     }
 
     double duration;
@@ -372,13 +446,14 @@ void BehaviorSub::CompilingBehavior()
 
         if (sf::is_directory(filepath)) ErrorMessage(3001, filepath);
 
-        size_t size = fileLineCount(filepath);
-        catalyst.reserve(size);
-        modLine.reserve(size);
         FileReader BehaviorFormat(filepath);
 
         if (!BehaviorFormat.GetFile()) ErrorMessage(3002, filepath);
 
+        size_t size = BehaviorFormat.LineCount();
+        catalyst.reserve(size);
+        modLine.reserve(size);
+
         bool hasDeleted = false;
         uint numline    = 0;
 
@@ -397,7 +472,7 @@ void BehaviorSub::CompilingBehavior()
                 if (!hasDeleted
                     && line
                            == nemesis::regex_replace(
-                               line, nemesis::regex("^[\t]+<!-- \\*([\\w]+)\\* -->"), string("\\1")))
+                               line, nemesis::precompiled(nemesis::pattern::mod_edit_only), string("\\1")))
                     hasDeleted = true;
             }
             else if (line.find("\t<!-- original -->", 0) != NOT_FOUND)
@@ -424,13 +499,9 @@ void BehaviorSub::CompilingBehavior()
 
                 if (pos != NOT_FOUND && line.find("signature=\"", pos) != NOT_FOUND)
                 {
-                    string ID = nemesis::regex_replace(
-                        string(line),
-                        nemesis::regex(".*<hkobject name=\"#([0-9]+)\" class=\"[a-zA-Z]+\" "
-                                       "signature=\".*\">.*"),
-                        string("\\1"));
+                    string ID;
 
-                    if (ID != line)
+                    if (nemesis::number_between(line, "<hkobject name=\"#", "\" class=\"", ID))
                     {
                         curID = stoi(ID);
 
@@ -604,7 +675,7 @@ void BehaviorSub::CompilingBehavior()
 
         if (error) throw nemesis::exception();
 
-        process->newMilestone();
+        milestones.reach(BehaviorStep::Extracted);
 
         curID         = 0;
         bool isClip   = false;
@@ -736,8 +807,7 @@ void BehaviorSub::CompilingBehavior()
 
                     if (pos != NOT_FOUND)
                     {
-                        firstID = stoi(nemesis::regex_replace(
-                            string(vline.substr(pos)), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                        firstID = stoi(nemesis::first_number(string(vline.substr(pos))));
                         break;
                     }
                 }
@@ -746,9 +816,7 @@ void BehaviorSub::CompilingBehavior()
             }
             else
             {
-                firstID = stoi(nemesis::regex_replace(string(catalyst[1].second.substr(pos)),
-                                                      nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                      string("\\1")));
+                firstID = stoi(nemesis::first_number(string(catalyst[1].second.substr(pos))));
             }
         }
 
@@ -818,8 +886,7 @@ void BehaviorSub::CompilingBehavior()
                     if (nemesis::regex_search(
                             line,
                             match,
-                            nemesis::regex(
-                                "<hkobject name=\"#(.*)\" class=\"([a-zA-Z]+)\" signature=\".*\">")))
+                            nemesis::precompiled(nemesis::pattern::hkobject_header)))
                     {
                         curID       = stoi(match[1]);
                         elementLine = -1;
@@ -838,9 +905,7 @@ void BehaviorSub::CompilingBehavior()
                         for (size_t k = 0; k < reference; ++k)
                         {
                             nextpos      = line.find("#", nextpos) + 1;
-                            string numID = nemesis::regex_replace(string(line.substr(nextpos)),
-                                                                  nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                                  string("\\1"));
+                            string numID = nemesis::first_number(string(line.substr(nextpos)));
                             string ID    = line.substr(nextpos, line.find(numID) - nextpos + numID.length());
 
                             if (line.find(ID, 0) != NOT_FOUND && ID.find("$") != NOT_FOUND)
@@ -872,8 +937,7 @@ void BehaviorSub::CompilingBehavior()
                         for (unsigned int p = 0; p < generator.size(); p++)
                         {
                             string ID    = generator[p];
-                            string numID = nemesis::regex_replace(
-                                string(ID), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                            string numID = nemesis::first_number(ID);
 
                             if (ID.find("$") != NOT_FOUND)
                             {
@@ -917,7 +981,7 @@ void BehaviorSub::CompilingBehavior()
                     nemesis::smatch match;
 
                     if (nemesis::regex_search(
-                            line, match, nemesis::regex("<hkparam name=\"(.+?)\" numelements=\"(.+?)\">")))
+                            line, match, nemesis::precompiled(nemesis::pattern::hkparam_numelements)))
                     {
                         if (eventelements == -1)
                         {
@@ -954,7 +1018,7 @@ void BehaviorSub::CompilingBehavior()
                     nemesis::smatch match;
 
                     if (nemesis::regex_search(
-                            line, match, nemesis::regex("<hkparam name=\"(.+?)\" numelements=\"(.+?)\">")))
+                            line, match, nemesis::precompiled(nemesis::pattern::hkparam_numelements)))
                     {
                         if (attributeelements == -1)
                         {
@@ -987,7 +1051,7 @@ void BehaviorSub::CompilingBehavior()
                     nemesis::smatch match;
 
                     if (nemesis::regex_search(
-                            line, match, nemesis::regex("<hkparam name=\"(.+?)\" numelements=\"(.+?)\">")))
+                            line, match, nemesis::precompiled(nemesis::pattern::hkparam_numelements)))
                     {
                         if (characterelements == -1)
                         {
@@ -1023,7 +1087,7 @@ void BehaviorSub::CompilingBehavior()
                     nemesis::smatch match;
 
                     if (nemesis::regex_search(
-                            line, match, nemesis::regex("<hkparam name=\"(.+?)\" numelements=\"(.+?)\">")))
+                            line, match, nemesis::precompiled(nemesis::pattern::hkparam_numelements)))
                     {
                         if (variableelements == -1)
                         {
@@ -1057,12 +1121,15 @@ void BehaviorSub::CompilingBehavior()
                     nemesis::smatch match;
 
                     if (nemesis::regex_search(
-                            line, match, nemesis::regex("<hkparam name=\"(.+?)\" numelements=\"(.+?)\">")))
+                            line, match, nemesis::precompiled(nemesis::pattern::hkparam_numelements)))
                     {
                         if (line.find("</hkparam>") == NOT_FOUND)
                         {
                             counter         = 0;
                             animOpen        = true;
+
+                            // the animations registered here are not replayed on a cache hit
+                            cacheKey = 0;
                             elementCatch    = true;
                             string templine = line.substr(0, match.position(1));
                             openRange       = count(templine.begin(), templine.end(), '\t');
@@ -1099,7 +1166,7 @@ void BehaviorSub::CompilingBehavior()
                     nemesis::smatch match;
 
                     if (nemesis::regex_search(
-                            line, match, nemesis::regex("<hkparam name=\"(.+?)\" numelements=\"(.+?)\">")))
+                            line, match, nemesis::precompiled(nemesis::pattern::hkparam_numelements)))
                     {
                         if (line.find("</hkparam>") == NOT_FOUND)
                         {
@@ -1113,7 +1180,7 @@ void BehaviorSub::CompilingBehavior()
                     }
                 }
                 else if (nemesis::regex_search(
-                             line, check, nemesis::regex("<hkparam name=\"(.+?)\" numelements=\""))
+                             line, check, nemesis::precompiled(nemesis::pattern::hkparam_numelements_open))
                          && line.find("</hkparam>", check.position(1)) == NOT_FOUND)
                 {
                     counter         = 0;
@@ -1661,7 +1728,7 @@ void BehaviorSub::CompilingBehavior()
                         if (line.find("$eventID[", 0) != NOT_FOUND && line.find("]$", 0) != NOT_FOUND)
                         {
                             string change = nemesis::regex_replace(
-                                string(line), nemesis::regex(".*[$](eventID[[].*[]])[$].*"), string("\\1"));
+                                string(line), nemesis::precompiled(nemesis::pattern::event_id_tag), string("\\1"));
 
                             if (change != line)
                             {
@@ -1677,7 +1744,7 @@ void BehaviorSub::CompilingBehavior()
                         {
                             string change
                                 = nemesis::regex_replace(string(line),
-                                                         nemesis::regex(".*[$](variableID[[].*[]])[$].*"),
+                                                         nemesis::precompiled(nemesis::pattern::variable_id_tag),
                                                          string("\\1"));
 
                             if (change != line)
@@ -1700,7 +1767,7 @@ void BehaviorSub::CompilingBehavior()
                     {
                         string change = nemesis::regex_replace(
                             string(line),
-                            nemesis::regex(".*[$](stateID[[].*[]][[][0-9]+[]][[].*[]][[][0-9]+[]])[$].*"),
+                            nemesis::precompiled(nemesis::pattern::state_id_tag),
                             string("\\1"));
 
                         if (change != line)
@@ -1716,13 +1783,11 @@ void BehaviorSub::CompilingBehavior()
                             {
                                 string node = nemesis::regex_replace(
                                     string(line),
-                                    nemesis::regex(
-                                        ".*[$]stateID[[](.*)[]][[]([0-9]+)[]][[].*[]][[][0-9]+[]][$].*"),
+                                    nemesis::precompiled(nemesis::pattern::state_id_parts),
                                     string("\\1"));
                                 string base = nemesis::regex_replace(
                                     string(line),
-                                    nemesis::regex(
-                                        ".*[$]stateID[[](.*)[]][[]([0-9]+)[]][[].*[]][[][0-9]+[]][$].*"),
+                                    nemesis::precompiled(nemesis::pattern::state_id_parts),
                                     string("\\2"));
 
                                 if (stateStrID[node + base] == 0)
@@ -1794,7 +1859,7 @@ void BehaviorSub::CompilingBehavior()
                             + behaviorPath[lowerBehaviorFile].substr(
                                 behaviorPath[lowerBehaviorFile].find("\\") + 1);
 #else
-                outputdir = behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)] + L".hkx";
+                outputdir = behaviorPath[lowerBehaviorFile] + L".hkx";
 #endif
                 if (SSE) lowerBehaviorFile = "SSE\\" + lowerBehaviorFile;
 
@@ -1830,14 +1895,7 @@ void BehaviorSub::CompilingBehavior()
                     if (!sf::remove(outputdir)) WarningMessage(1005, outputdir);
                 }
 
-                int i = 0;
-
-                while (i < 8)
-                {
-                    process->newMilestone();
-                    ++i;
-                }
-
+                milestones.skipRest();
                 DebugLogging(L"Processing behavior: " + filepath + L" (Check point 3.4, No changes detected)");
                 return;
             }
@@ -1858,7 +1916,7 @@ void BehaviorSub::CompilingBehavior()
     }
 
     catalystMap[curID].shrink_to_fit();
-    process->newMilestone();
+    milestones.reach(BehaviorStep::Catalyst);
 
     // newAnimation ID in existing function
     if (catcher.size() != 0)
@@ -1892,16 +1950,34 @@ void BehaviorSub::CompilingBehavior()
 
     if (error) throw nemesis::exception();
 
-    process->newMilestone();
+    milestones.reach(BehaviorStep::Imported);
+
+    // generated lines and the AA and PCEA sections are only read back once the file is written
+    // their text is kept in one arena and released with it instead of line by line
+    nemesis::LineArena lineArena;
 
     // add new animation
+    // templates write into allEditLines, which moves into editLines once its node IDs are final
     vector<shared_ptr<VecStr>> allEditLines;
+    nemesis::ArenaLines editLines(lineArena);
     unordered_map<string, bool> isCoreDone;
     unordered_map<int, int> functionState;
     unordered_map<int, shared_ptr<NodeJoint>> existingNodes;
     int grouptimer = 0;
     int onetimer   = 0;
 
+    auto settleEditLines = [&]()
+    {
+        // release each list as soon as it is copied, so the strings and the arena never both hold everything
+        for (auto& lines : allEditLines)
+        {
+            editLines.append(lines->begin(), lines->end());
+            lines.reset();
+        }
+
+        allEditLines.clear();
+    };
+
     // check for having newAnimation for the file
     auto tempGp = BehaviorTemplate->grouplist.find(lowerBehaviorFile);
 
@@ -1998,15 +2074,17 @@ void BehaviorSub::CompilingBehavior()
 
                     if (newAnimCount > 0)
                     {
-                        DebugLogging(L"Processing behavior: " + filepath + L" (Check point 3.6, Mod code: "
-                                     + nemesis::transform_to<wstring>(templateCode) + L", Animation count: "
-                                     + to_wstring(newAnimCount) + L")");
+                        DEBUG_LOG(debug, L"Processing behavior: " + filepath + L" (Check point 3.6, Mod code: "
+                                         + nemesis::transform_to<wstring>(templateCode) + L", Animation count: "
+                                         + to_wstring(newAnimCount) + L")");
                         shared_ptr<NewAnimation> dummyAnimation;
                         //int IDMultiplier = newAnimCopy[0]->getNextID(lowerBehaviorFile);
                         NewAnimLock animLock;
+                        nemesis::NodeIDLedger animIDLedger;
+                        size_t firstAnimLine = allEditLines.size();
 
-                        #if defined(MULTITHREADED_UPDATE_2)
-                        nemesis::ThreadPool tp;
+                        #if defined(PARALLEL_ANIMATION_GENERATION)
+                        nemesis::TaskGroup tp;
                         #endif
 
                         auto start_time = chrono::steady_clock::now();
@@ -2044,7 +2122,6 @@ void BehaviorSub::CompilingBehavior()
                                             isCoreDone[newAnimCopy[k]
                                                            ->GetGroupAnimInfo()[0]
                                                            ->filename],
-                                            functionState,
                                             exportID,
                                             eventid,
                                             variableid,
@@ -2057,8 +2134,14 @@ void BehaviorSub::CompilingBehavior()
                                             subFunctionIDs->singlelist.back(),
                                             subFunctionIDs,
                                             groupFunctionIDs,
-                                            false,
-                                            groupAnimInfo);
+                                            false);
+                                        args->idJournal = animIDLedger.addJob();
+
+                                        if (args->core)
+                                        {
+                                            args->skip       = args->isCoreDone;
+                                            args->isCoreDone = true;
+                                        }
 
                                         if (newAnimCopy[k]->isLast())
                                         {
@@ -2087,8 +2170,8 @@ void BehaviorSub::CompilingBehavior()
 
                                         //lastID += IDMultiplier;
 
-                                        #if defined(MULTITHREADED_UPDATE_2)
-                                            tp.enqueue(animThreadStart, args);
+                                        #if defined(PARALLEL_ANIMATION_GENERATION)
+                                        tp.run(animThreadStart, args);
                                         #else
                                         animThreadStart(args);
                                         #endif
@@ -2130,7 +2213,6 @@ void BehaviorSub::CompilingBehavior()
                                             newAnimCopy[k],
                                             allEditLines.back(),
                                             isCoreDone[newAnimCopy[k]->GetGroupAnimInfo()[0]->filename],
-                                            functionState,
                                             exportID,
                                             eventid,
                                             variableid,
@@ -2143,8 +2225,14 @@ void BehaviorSub::CompilingBehavior()
                                             subFunctionIDs->singlelist.back(),
                                             subFunctionIDs,
                                             groupFunctionIDs,
-                                            ignoreGroup,
-                                            groupAnimInfo);
+                                            ignoreGroup);
+                                        args->idJournal = animIDLedger.addJob();
+
+                                        if (args->core)
+                                        {
+                                            args->skip       = args->isCoreDone;
+                                            args->isCoreDone = true;
+                                        }
 
                                         if (ignoreGroup)
                                         {
@@ -2178,8 +2266,8 @@ void BehaviorSub::CompilingBehavior()
 
                                         //lastID += IDMultiplier;
 
-                                        #if defined(MULTITHREADED_UPDATE_2)
-                                        tp.enqueue(animThreadStart, args);
+                                        #if defined(PARALLEL_ANIMATION_GENERATION)
+                                        tp.run(animThreadStart, args);
                                         #else
                                         animThreadStart(args);
                                         #endif
@@ -2192,10 +2280,12 @@ void BehaviorSub::CompilingBehavior()
                             }
                         }
 
-                        #if defined(MULTITHREADED_UPDATE_2)
-                        tp.join_all();
+                        #if defined(PARALLEL_ANIMATION_GENERATION)
+                        tp.wait();
                         #endif
 
+                        if (error) throw nemesis::exception();
+
                         if (!ignoreGroup && !hasGroup)
                         {
                             subFunctionIDs->singlelist.shrink_to_fit();
@@ -2213,6 +2303,23 @@ void BehaviorSub::CompilingBehavior()
                             groupAnimInfo = newGroupAnimInfo;
                         }
 
+                        // number the node IDs in animation order, same as a single threaded run
+                        animIDLedger.resolve(lastID);
+                        animIDLedger.patch(exportID);
+                        animIDLedger.patch(*groupFunctionIDs);
+
+                        for (size_t i = firstAnimLine; i < allEditLines.size(); ++i)
+                        {
+                            animIDLedger.patch(*allEditLines[i]);
+                        }
+
+                        settleEditLines();
+
+                        for (auto& anim : newAnimCopy)
+                        {
+                            anim->resolveIDs(animIDLedger);
+                        }
+
                         // check error before initialization
                         for (unsigned int curGroup = 0; curGroup < groupFunctionIDs->grouplist.size();
                              ++curGroup)
@@ -2261,9 +2368,12 @@ void BehaviorSub::CompilingBehavior()
                                       functionState);
                             size_t n_newAnimCount = groupFunctionIDs->grouplist.size();
 
+                            nemesis::NodeIDLedger groupIDLedger;
+                            size_t firstGroupLine = allEditLines.size();
+
                             // Execute group template from memory
-                            #if defined(MULTITHREADED_UPDATE_2)
-                            nemesis::ThreadPool tp2;
+                            #if defined(PARALLEL_ANIMATION_GENERATION)
+                            nemesis::TaskGroup tp2;
                             #endif
 
                             for (unsigned int k = 0; k < n_newAnimCount; ++k)
@@ -2276,6 +2386,7 @@ void BehaviorSub::CompilingBehavior()
                                         grouptemplate_pack);
                                     groupTemp->setZeroEvent(ZeroEvent);
                                     groupTemp->setZeroVariable(ZeroVariable);
+                                    groupTemp->setIDJournal(groupIDLedger.addJob());
                                     shared_ptr<newGroupArgs> args
                                         = make_shared<newGroupArgs>(templateCode,
                                                                     lowerBehaviorFile,
@@ -2303,8 +2414,8 @@ void BehaviorSub::CompilingBehavior()
 
                                     //lastID += IDMultiplier;
                                     
-                                    #if defined(MULTITHREADED_UPDATE_2)
-                                    tp2.enqueue(groupThreadStart, args);
+                                    #if defined(PARALLEL_ANIMATION_GENERATION)
+                                    tp2.run(groupThreadStart, args);
                                     #else
                                     groupThreadStart(args);
                                     #endif
@@ -2315,9 +2426,22 @@ void BehaviorSub::CompilingBehavior()
                                 }
                             }
 
-                            #if defined(MULTITHREADED_UPDATE_2)
-                            tp2.join_all();
+                            #if defined(PARALLEL_ANIMATION_GENERATION)
+                            tp2.wait();
                             #endif
+
+                            if (error) throw nemesis::exception();
+
+                            groupIDLedger.resolve(lastID);
+                            groupIDLedger.patch(exportID);
+                            groupIDLedger.patch(*groupFunctionIDs);
+
+                            for (size_t i = firstGroupLine; i < allEditLines.size(); ++i)
+                            {
+                                groupIDLedger.patch(*allEditLines[i]);
+                            }
+
+                            settleEditLines();
                         }
 
                         // master animation
@@ -2367,13 +2491,13 @@ void BehaviorSub::CompilingBehavior()
 
                         diff = chrono::steady_clock::now() - start_time;
                         grouptimer += chrono::duration_cast<chrono::milliseconds>(diff).count();
-                        DebugLogging(L"Processing behavior: " + filepath
-                                     + L" (Check point 3.8, Mod code: " + nemesis::transform_to<wstring>(templateCode)
-                                     + L", Animation count: " + to_wstring(newAnimCount) + L" COMPLETE)");
+                        DEBUG_LOG(debug, L"Processing behavior: " + filepath
+                                         + L" (Check point 3.8, Mod code: " + nemesis::transform_to<wstring>(templateCode)
+                                         + L", Animation count: " + to_wstring(newAnimCount) + L" COMPLETE)");
                     }
                 }
 
-                DebugLogging(
+                DEBUG_LOG(debug,
                     L"Processing behavior: " + filepath + L" (Check point 3.8, Mod code: "
                     + nemesis::transform_to<wstring>(templateCode) + L", Existing ID count: "
                     + to_wstring(BehaviorTemplate->existingFunctionID[templateCode][lowerBehaviorFile].size())
@@ -2397,7 +2521,7 @@ void BehaviorSub::CompilingBehavior()
                                    behaviorFile,
                                    existingNodes);
 
-                DebugLogging(
+                DEBUG_LOG(debug,
                     L"Processing behavior: " + filepath + L" (Check point 3.8, Mod code: "
                     + nemesis::transform_to<wstring>(templateCode) + L", Existing ID count: "
                     + to_wstring(BehaviorTemplate->existingFunctionID[templateCode][lowerBehaviorFile].size())
@@ -2407,7 +2531,7 @@ void BehaviorSub::CompilingBehavior()
             {
                 nalock.Unlock();
 
-                DebugLogging(
+                DEBUG_LOG(debug,
                     L"Processing behavior: " + filepath + L" (Check point 3.8, Mod code: "
                     + nemesis::transform_to<wstring>(templateCode) + L", Existing ID count: "
                     + to_wstring(BehaviorTemplate->existingFunctionID[templateCode][lowerBehaviorFile].size())
@@ -2431,7 +2555,7 @@ void BehaviorSub::CompilingBehavior()
                                    behaviorFile,
                                    existingNodes);
 
-                DebugLogging(
+                DEBUG_LOG(debug,
                     L"Processing behavior: " + filepath + L" (Check point 3.8, Mod code: "
                     + nemesis::transform_to<wstring>(templateCode) + L", Existing ID count: "
                     + to_wstring(BehaviorTemplate->existingFunctionID[templateCode][lowerBehaviorFile].size())
@@ -2443,6 +2567,7 @@ void BehaviorSub::CompilingBehavior()
                               + " TEMPLATE END ======================== -->");
             closing.push_back("");
             allEditLines.emplace_back(make_unique<VecStr>(closing));
+            settleEditLines();
         }
     }
 
@@ -2452,14 +2577,14 @@ void BehaviorSub::CompilingBehavior()
     // load to existing Nodes from behavior template
     unpackToCatalyst(catalystMap, existingNodes);
 
-    DebugLogging("Total single animation processing time for " + behaviorFile + ": " + to_string(onetimer));
-    DebugLogging("Total group animation processing time for " + behaviorFile + ": " + to_string(grouptimer));
+    DEBUG_LOG(debug, "Total single animation processing time for " + behaviorFile + ": " + to_string(onetimer));
+    DEBUG_LOG(debug, "Total group animation processing time for " + behaviorFile + ": " + to_string(grouptimer));
     DebugLogging(L"Processing behavior: " + filepath + L" (Check point 4, New animation inclusion complete)");
 
-    process->newMilestone();
+    milestones.reach(BehaviorStep::Animations);
 
     // AA animation installation
-    VecStr AAlines;
+    nemesis::ArenaLines AAlines(lineArena);
 
     if (clipAA.size() != 0)
     {
@@ -2624,8 +2749,9 @@ void BehaviorSub::CompilingBehavior()
 
                 for (unsigned int i = 0; i < children.size(); ++i)
                 {
-                    AAlines.push_back("		<hkobject name=\"#" + children[i]
-                                      + "\" class=\"hkbClipGenerator\" signature=\"0x333b85b9\">");
+                    AAlines.push_back({"		<hkobject name=\"#",
+                                       children[i],
+                                       "\" class=\"hkbClipGenerator\" signature=\"0x333b85b9\">"});
                     AAlines.push_back(catalystMap[iter->first][1]);
                     AAlines.push_back(catalystMap[iter->first][2]);
                     AAlines.push_back(catalystMap[iter->first][3]);
@@ -2635,8 +2761,9 @@ void BehaviorSub::CompilingBehavior()
                         ++num;
                     }
 
-                    AAlines.push_back("			<hkparam name=\"animationName\">Animations\\"
-                                      + it->second[num] + "</hkparam>");
+                    AAlines.push_back({"			<hkparam name=\"animationName\">Animations\\",
+                                       it->second[num],
+                                       "</hkparam>"});
                     string animFile = nemesis::to_lower_copy(
                         it->second[num].substr(it->second[num].find_last_of("\\") + 1));
                     auto aaEvent_itr = AAEvent.find(isFirstPerson ? animFile + "_1p*" : animFile);
@@ -2652,8 +2779,9 @@ void BehaviorSub::CompilingBehavior()
                                 tempID = "0" + tempID;
                             }
 
-                            AAlines.push_back("			<hkparam name=\"triggers\">#" + tempID
-                                              + "</hkparam>");
+                            AAlines.push_back({"			<hkparam name=\"triggers\">#",
+                                               tempID,
+                                               "</hkparam>"});
                             triggerID[tempID] = aaEvent_itr->second;
                             ++lastID;
 
@@ -2684,10 +2812,12 @@ void BehaviorSub::CompilingBehavior()
                 for (auto itera = triggerID.begin(); itera != triggerID.end(); ++itera)
                 {
                     AAlines.reserve(AAlines.size() + (itera->second.size() * 12) + 5);
-                    AAlines.push_back("		<hkobject name=\"#" + itera->first
-                                      + "\" class=\"hkbClipTriggerArray\" signature=\"0x59c23a0f\">");
-                    AAlines.push_back("			<hkparam name=\"triggers\" numelements=\""
-                                      + to_string(itera->second.size() / 2) + "\">");
+                    AAlines.push_back({"		<hkobject name=\"#",
+                                       itera->first,
+                                       "\" class=\"hkbClipTriggerArray\" signature=\"0x59c23a0f\">"});
+                    AAlines.push_back({"			<hkparam name=\"triggers\" numelements=\"",
+                                       to_string(itera->second.size() / 2),
+                                       "\">"});
 
                     for (unsigned int i = 0; i < itera->second.size(); ++i)
                     {
@@ -2703,8 +2833,9 @@ void BehaviorSub::CompilingBehavior()
                         }
 
                         AAlines.push_back("				<hkobject>");
-                        AAlines.push_back("					<hkparam name=\"localTime\">" + time
-                                          + "</hkparam>");
+                        AAlines.push_back({"					<hkparam name=\"localTime\">",
+                                           time,
+                                           "</hkparam>"});
                         AAlines.push_back("					<hkparam name=\"event\">");
                         AAlines.push_back("						<hkobject>");
 
@@ -2713,15 +2844,17 @@ void BehaviorSub::CompilingBehavior()
 
                         if (error) throw nemesis::exception();
 
-                        AAlines.push_back("							<hkparam name=\"id\">" + eventID
-                                          + "</hkparam>");
+                        AAlines.push_back({"							<hkparam name=\"id\">",
+                                           eventID,
+                                           "</hkparam>"});
                         AAlines.push_back(
                             "							<hkparam name=\"payload\">null</hkparam>");
                         AAlines.push_back("						</hkobject>");
                         AAlines.push_back("					</hkparam>");
 
-                        AAlines.push_back("					<hkparam name=\"relativeToEndOfClip\">"
-                                          + string(negative ? "true" : "false") + "</hkparam>");
+                        AAlines.push_back({"					<hkparam name=\"relativeToEndOfClip\">",
+                                           negative ? "true" : "false",
+                                           "</hkparam>"});
 
                         AAlines.push_back("					<hkparam name=\"acyclic\">false</hkparam>");
                         AAlines.push_back("					<hkparam name=\"isAnnotation\">false</hkparam>");
@@ -2747,7 +2880,7 @@ void BehaviorSub::CompilingBehavior()
                      + L" (Check point 4.4, AA count: " + to_wstring(clipAA.size()) + L" COMPLETE)");
     }
 
-    VecStr PCEALines;
+    nemesis::ArenaLines PCEALines(lineArena);
 
     if (pceaID.size() > 0)
     {
@@ -2757,7 +2890,7 @@ void BehaviorSub::CompilingBehavior()
 
         for (auto& datalist : pceaID)
         {
-            vector<VecStr> lineRe;
+            vector<nemesis::ArenaLines> lineRe;
             string importline = to_string(datalist.first);
 
             if (error) throw nemesis::exception();
@@ -2769,9 +2902,10 @@ void BehaviorSub::CompilingBehavior()
                 }
 
                 // populating manual selector generator
-                VecStr msglines;
-                msglines.push_back("		<hkobject name=\"#" + importline
-                                   + "\" class=\"hkbManualSelectorGenerator\" signature=\"0xd932fab8\">");
+                nemesis::ArenaLines msglines(lineArena);
+                msglines.push_back({"		<hkobject name=\"#",
+                                    importline,
+                                    "\" class=\"hkbManualSelectorGenerator\" signature=\"0xd932fab8\">"});
                 importline = "variableID[" + data->modFile + "]";
                 variableIDReplacer(importline, "PCEA", behaviorFile, variableid, ZeroVariable, 0);
 
@@ -2800,8 +2934,9 @@ void BehaviorSub::CompilingBehavior()
                 msglines.push_back(importline);
                 msglines.push_back("			<hkparam name=\"userData\">0</hkparam>");
                 ++replacerCount[data->modFile];
-                msglines.push_back("			<hkparam name=\"name\">Nemesis_PCEA_" + data->modFile
-                                   + "_MSG</hkparam>");
+                msglines.push_back({"			<hkparam name=\"name\">Nemesis_PCEA_",
+                                    data->modFile,
+                                    "_MSG</hkparam>"});
                 msglines.push_back("			<hkparam name=\"generators\" numelements=\"2\">");
 
                 importline = to_string(lastID);
@@ -2811,7 +2946,7 @@ void BehaviorSub::CompilingBehavior()
                     importline = "0" + importline;
                 }
 
-                msglines.push_back("				#" + importline);
+                msglines.push_back({"				#", importline});
                 ++lastID;
 
                 if (lastID == 9216) ++lastID;
@@ -2823,7 +2958,7 @@ void BehaviorSub::CompilingBehavior()
                     baseID = "0" + baseID;
                 }
 
-                msglines.push_back("				#" + baseID);
+                msglines.push_back({"				#", baseID});
                 ++lastID;
 
                 if (lastID == 9216) ++lastID;
@@ -2838,13 +2973,15 @@ void BehaviorSub::CompilingBehavior()
                 msglines.clear();
 
                 // populating clip generator
-                msglines.push_back("		<hkobject name=\"#" + baseID
-                                   + "\" class=\"hkbClipGenerator\" signature=\"0x333b85b9\">");
+                msglines.push_back({"		<hkobject name=\"#",
+                                    baseID,
+                                    "\" class=\"hkbClipGenerator\" signature=\"0x333b85b9\">"});
                 msglines.push_back(catalystMap[datalist.first][1]);
                 msglines.push_back(catalystMap[datalist.first][2]);
                 msglines.push_back(catalystMap[datalist.first][3]);
-                msglines.push_back("			<hkparam name=\"animationName\">" + data->animPath
-                                   + "</hkparam>");
+                msglines.push_back({"			<hkparam name=\"animationName\">",
+                                    data->animPath,
+                                    "</hkparam>"});
 
                 for (unsigned int j = 5; j < catalystMap[datalist.first].size(); ++j)
                 {
@@ -2858,18 +2995,18 @@ void BehaviorSub::CompilingBehavior()
                 lineRe.push_back(msglines);
             }
 
-            VecStr msglines;
-            msglines.push_back("		<hkobject name=\"#" + importline
-                               + "\" class=\"hkbClipGenerator\" signature=\"0x333b85b9\">");
-            msglines.insert(
-                msglines.end(), catalystMap[datalist.first].begin() + 1, catalystMap[datalist.first].end());
+            nemesis::ArenaLines msglines(lineArena);
+            msglines.push_back({"		<hkobject name=\"#",
+                                importline,
+                                "\" class=\"hkbClipGenerator\" signature=\"0x333b85b9\">"});
+            msglines.append(catalystMap[datalist.first].begin() + 1, catalystMap[datalist.first].end());
 
             if (msglines.back().length() != 0) msglines.push_back("");
 
             lineRe.push_back(msglines);
 
             for (auto it = lineRe.rbegin(); it != lineRe.rend(); ++it) {
-                PCEALines.insert(PCEALines.end(), it->begin(), it->end());
+                PCEALines.append(*it);
             }
 
             if (error) throw nemesis::exception();
@@ -2881,7 +3018,7 @@ void BehaviorSub::CompilingBehavior()
                      + to_wstring(pceaID.size()) + L" COMPLETE)");
     }
 
-    process->newMilestone();
+    milestones.reach(BehaviorStep::Extensions);
 
     size_t reserveSize = 0;
     VecStr behaviorlines;
@@ -2892,11 +3029,11 @@ void BehaviorSub::CompilingBehavior()
     groupExportID.push_back(exportID);
     VecStr additionallines = importOutput(groupExportID, 0, lastID);
 
-    process->newMilestone();
+    milestones.reach(BehaviorStep::Exported);
     DebugLogging(L"Processing behavior: " + filepath + L" (Check point 5, Prepare to output)");
-    process->newMilestone();
+    milestones.reach(BehaviorStep::Prepared);
 
-    if (behaviorPath[nemesis::transform_to<wstring>(lowerBehaviorFile)].size() == 0) ErrorMessage(1068, behaviorFile);
+    if (behaviorPath[lowerBehaviorFile].size() == 0) ErrorMessage(1068, behaviorFile);
 
     wstring filename = getTempBhvrPath(nemesisInfo).wstring() + L"\\xml\\" + nemesis::transform_to<wstring>(modID + lowerBehaviorFile) + L".xml";
 
@@ -2912,6 +3049,14 @@ void BehaviorSub::CompilingBehavior()
 
     if (!output.is_open()) ErrorMessage(1025, filename);
 
+    auto checkClip = [&](string_view eachline)
+    {
+        checkClipAnimData(
+            outputdir, projectdir, eachline, characterFiles, clipName, isClip, process, isBehavior);
+
+        if (cacheKey != 0 && isClipAnimDataLine(eachline)) cacheReplay.emplace_back(eachline);
+    };
+
     if (isCharacter)
     {
         for (int i = firstID; i < firstID + 4; ++i)
@@ -2951,7 +3096,7 @@ void BehaviorSub::CompilingBehavior()
 
             for (auto& eachline : PCEALines)
             {
-                output << eachline + "\n";
+                output << eachline << "\n";
                 checkBehaviorJoint(outputdir, projectdir, eachline, process, isBehavior);
             }
 
@@ -2968,7 +3113,7 @@ void BehaviorSub::CompilingBehavior()
 
             for (auto& eachline : AAlines)
             {
-                output << eachline + "\n";
+                output << eachline << "\n";
                 checkBehaviorJoint(outputdir, projectdir, eachline, process, isBehavior);
             }
 
@@ -2978,16 +3123,13 @@ void BehaviorSub::CompilingBehavior()
         output << "<!-- ======================== NEMESIS alternate animation TEMPLATE END "
                   "======================== -->\n\n";
 
-        for (unsigned int j = 0; j < allEditLines.size(); ++j)
+        for (auto& eachline : editLines)
         {
-            for (auto& eachline : (*allEditLines[j]))
-            {
-                output << eachline + "\n";
-                checkBehaviorJoint(outputdir, projectdir, eachline, process, isBehavior);
-            }
-
-            if (error) throw nemesis::exception();
+            output << eachline << "\n";
+            checkBehaviorJoint(outputdir, projectdir, eachline, process, isBehavior);
         }
+
+        if (error) throw nemesis::exception();
     }
     else
     {
@@ -2996,8 +3138,7 @@ void BehaviorSub::CompilingBehavior()
             for (auto& eachline : catalystMap[i])
             {
                 output << eachline + "\n";
-                checkClipAnimData(
-                    outputdir, projectdir, eachline, characterFiles, clipName, isClip, process, isBehavior);
+                checkClip(eachline);
             }
 
             if (error) throw nemesis::exception();
@@ -3013,8 +3154,7 @@ void BehaviorSub::CompilingBehavior()
             for (auto& eachline : additionallines)
             {
                 output << eachline + "\n";
-                checkClipAnimData(
-                    outputdir, projectdir, eachline, characterFiles, clipName, isClip, process, isBehavior);
+                checkClip(eachline);
             }
 
             if (error) throw nemesis::exception();
@@ -3030,9 +3170,8 @@ void BehaviorSub::CompilingBehavior()
 
             for (auto& eachline : PCEALines)
             {
-                output << eachline + "\n";
-                checkClipAnimData(
-                    outputdir, projectdir, eachline, characterFiles, clipName, isClip, process, isBehavior);
+                output << eachline << "\n";
+                checkClip(eachline);
             }
 
             if (error) throw nemesis::exception();
@@ -3048,9 +3187,8 @@ void BehaviorSub::CompilingBehavior()
 
             for (auto& eachline : AAlines)
             {
-                output << eachline + "\n";
-                checkClipAnimData(
-                    outputdir, projectdir, eachline, characterFiles, clipName, isClip, process, isBehavior);
+                output << eachline << "\n";
+                checkClip(eachline);
             }
 
             if (error) throw nemesis::exception();
@@ -3059,17 +3197,13 @@ void BehaviorSub::CompilingBehavior()
         output << "<!-- ======================== NEMESIS alternate animation TEMPLATE END "
                   "======================== -->\n\n";
 
-        for (unsigned int j = 0; j < allEditLines.size(); ++j)
+        for (auto& eachline : editLines)
         {
-            for (auto& eachline : (*allEditLines[j]))
-            {
-                output << eachline + "\n";
-                checkClipAnimData(
-                    outputdir, projectdir, eachline, characterFiles, clipName, isClip, process, isBehavior);
-            }
-
-            if (error) throw nemesis::exception();
+            output << eachline << "\n";
+            checkClip(eachline);
         }
+
+        if (error) throw nemesis::exception();
     }
 
     firstID     = firstID + 4;
@@ -3080,8 +3214,7 @@ void BehaviorSub::CompilingBehavior()
         for (auto& eachline : catalystMap[it])
         {
             output << eachline + "\n";
-            checkClipAnimData(
-                outputdir, projectdir, eachline, characterFiles, clipName, isClip, process, isBehavior);
+            checkClip(eachline);
         }
 
         if (error) throw nemesis::exception();
@@ -3095,14 +3228,48 @@ void BehaviorSub::CompilingBehavior()
 
     if (error) throw nemesis::exception();
 
+    DEBUG_LOG(debug,
+              "Line arena for " + behaviorFile + ": " + to_string(lineArena.bytes()) + " bytes in "
+                  + to_string(lineArena.blockCount()) + " blocks");
+    lineArena.clear();
     DebugLogging(L"Processing behavior: " + filepath + L" (Check point 6, Behavior output complete)");
-    process->newMilestone();
+    milestones.reach(BehaviorStep::Written);
+
+#if defined(QUEUED_HKX_CONVERSION)
+    if (process->hkxConversion)
+    {
+        // hand the xml over to the conversion stage and move on to the next behavior
+        // the generation only ends once the conversion has reported back
+        ++m_RunningThread;
+        BehaviorStart* curProcess = process;
+        process->hkxConversion->push(
+            nemesis::transform_to<wstring>(filename),
+            outputdir,
+            [curProcess, filepath, outputdir, cacheKey, milestones, replay = move(cacheReplay)](bool success) mutable
+            {
+                if (success)
+                {
+                    DebugLogging(L"Processing behavior: " + filepath
+                                 + L" (Check point 7, Behavior compile complete)");
+                    milestones.reach(BehaviorStep::Compiled);
+
+                    if (cacheKey != 0) curProcess->generationCache.update(outputdir.wstring(), cacheKey, move(replay));
+                }
+
+                curProcess->EndAttempt();
+            });
+        return;
+    }
+#endif
+
     --extraCore;
 
     if (process->hkxCompiler.hkxcmdProcess(nemesis::transform_to<wstring>(filename), outputdir))
     {
         DebugLogging(L"Processing behavior: " + filepath + L" (Check point 7, Behavior compile complete)");
-        process->newMilestone();
+        milestones.reach(BehaviorStep::Compiled);
+
+        if (cacheKey != 0) process->generationCache.update(outputdir.wstring(), cacheKey, move(cacheReplay));
     }
 
     ++extraCore;
@@ -3149,3 +3316,47 @@ void BehaviorSub::addAnimation()
 {
     process->increaseAnimCount();
 }
+
+uint64_t BehaviorSub::generationKey(const string& lowerBehaviorFile, string_view content) const
+{
+    const nemesis::GenerationCache& cache = process->generationCache;
+    uint64_t key = nemesis::hash_content(content, cache.getInput("engine"));
+    set<string> modlist;
+    size_t pos = content.find("<!-- *");
+
+    while (pos != string_view::npos)
+    {
+        size_t start = pos + 6;
+        size_t end   = content.find("* -->", start);
+
+        if (end == string_view::npos) break;
+
+        string_view mod = content.substr(start, end - start);
+
+        if (mod.find('\n') == string_view::npos) modlist.emplace(mod);
+
+        pos = content.find("<!-- *", end);
+    }
+
+    // only the relative priority of the mods that edit this file matters
+    for (auto& mod : process->behaviorPriority)
+    {
+        if (modlist.find(mod) != modlist.end()) key = nemesis::hash_content(mod, key);
+    }
+
+    for (auto& mod : modlist)
+    {
+        auto chosen = process->chosenBehavior.find(mod);
+        key         = nemesis::hash_content(mod, key);
+        key         = nemesis::hash_content(chosen == process->chosenBehavior.end() ? 0 : chosen->second + 1, key);
+    }
+
+    auto activated = activatedBehavior.find(lowerBehaviorFile);
+    key = nemesis::hash_content(activated != activatedBehavior.end() && activated->second, key);
+    key = nemesis::hash_content(cache.getInput("behavior " + lowerBehaviorFile), key);
+    key = nemesis::hash_content(cache.getInput("alternate animation"), key);
+    key = nemesis::hash_content(cache.getInput("pcea"), key);
+
+    // 0 means no key
+    return key != 0 ? key : 1;
+}
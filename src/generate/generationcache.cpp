@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cstring>
+
+#include "Global.h"
+#include "version.h"
+
+#include "utilities/mappedfile.h"
+#include "utilities/readtextfile.h"
+#include "utilities/writetextfile.h"
+
+#include "generate/generationcache.h"
+
+using namespace std;
+namespace sf = filesystem;
+
+namespace
+{
+    constexpr uint64_t prime = 1099511628211ull;
+
+    uint64_t mix(uint64_t hash, uint64_t word)
+    {
+        hash = (hash ^ word) * prime;
+        return hash ^ (hash >> 32);
+    }
+
+    string toHex(uint64_t value)
+    {
+        char buffer[17];
+        snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+}
+
+uint64_t nemesis::hash_content(string_view data, uint64_t seed)
+{
+    uint64_t hash = mix(seed, data.length());
+    const char* cur = data.data();
+    const char* end = cur + data.length();
+
+    for (; end - cur >= 8; cur += 8)
+    {
+        uint64_t word;
+        memcpy(&word, cur, 8);
+        hash = mix(hash, word);
+    }
+
+    for (; cur < end; ++cur)
+    {
+        hash = (hash ^ static_cast<unsigned char>(*cur)) * prime;
+    }
+
+    return hash;
+}
+
+uint64_t nemesis::hash_content(uint64_t value, uint64_t seed)
+{
+    return mix(seed, value);
+}
+
+uint64_t nemesis::hash_directory(const sf::path& directory, uint64_t seed)
+{
+    vector<sf::path> filelist;
+    error_code ec;
+
+    for (auto& entry : sf::recursive_directory_iterator(directory, ec))
+    {
+        if (entry.is_regular_file()) filelist.push_back(entry.path());
+    }
+
+    sort(filelist.begin(), filelist.end());
+
+    for (auto& file : filelist)
+    {
+        seed = hash_content(nemesis::to_lower_copy(file.lexically_relative(directory).string()), seed);
+        seed = hash_content(hash_file(file), seed);
+    }
+
+    return seed;
+}
+
+uint64_t nemesis::hash_file(const sf::path& filepath)
+{
+    MappedFile file;
+
+    if (!file.open(filepath)) return 0;
+
+    return hash_content(file.view());
+}
+
+nemesis::GenerationCache::GenerationCache(sf::path _filename)
+    : filename(move(_filename))
+{
+}
+
+void nemesis::GenerationCache::load()
+{
+    lock_guard<mutex> lock(entryMutex);
+    entries.clear();
+
+    if (!isFileExist(filename)) return;
+
+    FileReader input(filename);
+    string line;
+
+    if (!input.GetFile()) return;
+
+    // entries of another version were generated by different code
+    if (!input.GetLines(line) || line != GetNemesisVersion()) return;
+
+    while (input.GetLines(line))
+    {
+        VecStr part;
+        size_t pos  = 0;
+        size_t next = line.find(">>");
+
+        while (next != NOT_FOUND)
+        {
+            part.push_back(line.substr(pos, next - pos));
+            pos  = next + 2;
+            next = line.find(">>", pos);
+        }
+
+        part.push_back(line.substr(pos));
+
+        // a damaged cache only costs a full generation
+        if (part.size() != 4)
+        {
+            entries.clear();
+            return;
+        }
+
+        Entry entry;
+
+        try
+        {
+            entry.key    = stoull(part[1], nullptr, 16);
+            entry.output = stoull(part[2], nullptr, 16);
+            entry.replay.resize(stoul(part[3]));
+        }
+        catch (const exception&)
+        {
+            entries.clear();
+            return;
+        }
+
+        for (auto& each : entry.replay)
+        {
+            if (!input.GetLines(each))
+            {
+                entries.clear();
+                return;
+            }
+        }
+
+        entries[nemesis::transform_to<wstring>(part[0])] = move(entry);
+    }
+}
+
+void nemesis::GenerationCache::save() const
+{
+    lock_guard<mutex> lock(entryMutex);
+    FileWriter output(filename);
+
+    if (!output.is_open()) ErrorMessage(2009, filename);
+
+    output << GetNemesisVersion() << "\n";
+
+    for (auto& each : entries)
+    {
+        output << each.first << ">>" << toHex(each.second.key) << ">>" << toHex(each.second.output) << ">>"
+               << to_string(each.second.replay.size()) << "\n";
+
+        for (auto& line : each.second.replay)
+        {
+            output << line << "\n";
+        }
+    }
+}
+
+void nemesis::GenerationCache::setInput(const string& name, uint64_t hash)
+{
+    inputs[name] = hash;
+}
+
+uint64_t nemesis::GenerationCache::getInput(const string& name) const
+{
+    auto itr = inputs.find(name);
+    return itr != inputs.end() ? itr->second : 0;
+}
+
+bool nemesis::GenerationCache::find(const wstring& output, uint64_t key, VecStr& replay) const
+{
+    uint64_t written;
+
+    {
+        lock_guard<mutex> lock(entryMutex);
+        auto itr = entries.find(output);
+
+        if (itr == entries.end() || itr->second.key != key) return false;
+
+        written = itr->second.output;
+        replay  = itr->second.replay;
+    }
+
+    // the hkx may have been removed or replaced since it was generated
+    return hash_file(output + L".hkx") == written;
+}
+
+void nemesis::GenerationCache::update(const wstring& output, uint64_t key, VecStr replay)
+{
+    uint64_t written = hash_file(output + L".hkx");
+    lock_guard<mutex> lock(entryMutex);
+
+    if (written == 0)
+    {
+        entries.erase(output);
+        return;
+    }
+
+    entries[output] = Entry{key, written, move(replay)};
+}
+
+void nemesis::GenerationCache::erase(const wstring& output)
+{
+    lock_guard<mutex> lock(entryMutex);
+    entries.erase(output);
+}
@@ -8,8 +8,11 @@
 #include "utilities/conditions.h"
 #include "utilities/lastupdate.h"
 #include "utilities/atomiclock.h"
+#include "utilities/hkxpackfile.h"
+#include "utilities/threadpool.h"
 #include "utilities/stringsplit.h"
 #include "utilities/readtextfile.h"
+#include "utilities/writetextfile.h"
 
 #include "generate/behaviorprocess.h"
 #include "generate/playerexclusive.h"
@@ -32,7 +35,6 @@ extern VecWstr warningMsges;
 static bool* globalThrow;
 
 VecWstr fileCheckMsg;
-VecWstr hkxFiles;
 
 atomic_flag animdata_lock{};
 
@@ -44,7 +46,6 @@ void readList(sf::path directory,
               TemplateInfo& behaviortemplate,
               bool firstP);
 void fileArchitectureCheck(sf::path hkxfile);
-void checkFolder(sf::path filepath);
 
 bool FolderCreate(sf::path curBehaviorPath)
 {
@@ -111,9 +112,7 @@ std::vector<int> GetStateID(map<int, int> mainJoint, map<int, VecStr> functionli
 									if (line.find("<hkparam name=\"stateId\">", 0) != NOT_FOUND)
 									{
                                         int tempStateID
-                                            = stoi(nemesis::regex_replace(string(line),
-                                                                          nemesis::regex("[^0-9]*([0-9]+).*"),
-                                                                          string("\\1")));
+                                            = stoi(nemesis::first_number(line));
 
 										if (tempStateID >= curState) curState = tempStateID + 1;
 
@@ -154,11 +153,11 @@ bool GetStateCount(vector<int>& count, VecStr templatelines, string format, stri
 		{
             string ID = nemesis::regex_replace(
                 string(line),
-                nemesis::regex(".*<hkparam name=\"stateId\">[$]\\(S([0-9]*)(.*)\\)[$]</hkparam>.*"),
+                nemesis::precompiled(nemesis::pattern::template_state_id),
                 string("\\1"));
             string number = nemesis::regex_replace(
                 string(line),
-                nemesis::regex(".*<hkparam name=\"stateId\">[$]\\(S([0-9]*)(.*)\\)[$]</hkparam>.*"),
+                nemesis::precompiled(nemesis::pattern::template_state_id),
                 string("\\2"));
 
 			if (ID != line && number != line)
@@ -226,9 +225,9 @@ string behaviorLineChooser(const string& originalline, const unordered_map<strin
 			if (chosen == -1) chosen = i;
 
 			string line = nemesis::regex_replace(
-                string(clitr->second), nemesis::regex("[\t]+([^\t]+).*"), string("\\1"));
+                string(clitr->second), nemesis::precompiled(nemesis::pattern::tab_text), string("\\1"));
             string line2 = nemesis::regex_replace(
-                string(line), nemesis::regex("[^ ]+[ ]([^ ]+)[ ][^ ]+"), string("\\1"));
+                string(line), nemesis::precompiled(nemesis::pattern::middle_word), string("\\1"));
 
 			if (line2 != line && line.find("<!-- ") == 0)
 			{
@@ -237,7 +236,7 @@ string behaviorLineChooser(const string& originalline, const unordered_map<strin
 				if (out.find("<!-- ") != NOT_FOUND)
                 {
                     out = nemesis::regex_replace(string(clitr->second),
-                                                 nemesis::regex("[^\t]+([\t]+<!-- [^ ]+ -->).*"),
+                                                 nemesis::precompiled(nemesis::pattern::tab_comment),
                                                  string("\\1"));
                     out = clitr->second.substr(0, clitr->second.find(out));
 				}
@@ -256,7 +255,7 @@ string behaviorLineChooser(const string& originalline, const unordered_map<strin
 		if (out.find("<!-- ") != NOT_FOUND)
         {
             out = nemesis::regex_replace(
-                string(line), nemesis::regex("[^\t]+([\t]+<!-- [^ ]+ -->).*"), string("\\1"));
+                string(line), nemesis::precompiled(nemesis::pattern::tab_comment), string("\\1"));
             out = line.substr(0, line.find(out));
 		}
 
@@ -268,7 +267,7 @@ string behaviorLineChooser(const string& originalline, const unordered_map<strin
 	if (out.find("<!-- ") != NOT_FOUND)
 	{
         out = nemesis::regex_replace(
-            string(originalline), nemesis::regex("[^\t]+([\t]+<!-- [^ ]+ -->).*"), string("\\1"));
+            string(originalline), nemesis::precompiled(nemesis::pattern::tab_comment), string("\\1"));
 		out = originalline.substr(0, originalline.find(out));
 	}
 
@@ -329,7 +328,7 @@ vector<unique_ptr<registerAnimation>> openFile(TemplateInfo* behaviortemplate, c
 
 	for (auto& behaviorGroup : behaviortemplate->grouplist)
 	{
-		wstring path = behaviorPath[nemesis::transform_to<wstring>(behaviorGroup.first)];
+		wstring path = behaviorPath[behaviorGroup.first];
 
 		if (path.length() == 0) ErrorMessage(1050, behaviorGroup.first);
 
@@ -747,12 +746,9 @@ int getTemplateNextID(VecStr& templatelines)
 	{
 		if (line.find("<hkobject name=\"#MID$") != NOT_FOUND)
 		{
-            string number
-                = nemesis::regex_replace(string(line),
-                                       nemesis::regex(".*<hkobject name=\"#MID[$]([0-9]+)\" class=\".*"),
-                                       string("\\1"));
+            string number;
 
-			if (number != line && isOnlyNumber(number))
+			if (nemesis::number_between(line, "<hkobject name=\"#MID$", "\" class=\"", number))
 			{
 				int num = stoi(number);
 
@@ -828,7 +824,7 @@ bool newAnimSkip(vector<shared_ptr<NewAnimation>> newAnim, string modID)
 }
 
 void checkBehaviorJoint(
-    sf::path filepath, sf::path projectdir, string& line, BehaviorStart* process, bool& isBehavior)
+    sf::path filepath, sf::path projectdir, string_view line, BehaviorStart* process, bool& isBehavior)
 {
     if (isBehavior)
     {
@@ -840,7 +836,7 @@ void checkBehaviorJoint(
             {
                 isBehavior = false;
                 pos += 33;
-                string behaviorFile = line.substr(pos, line.find("</hkparam>", pos) - pos);
+                string behaviorFile(line.substr(pos, line.find("</hkparam>", pos) - pos));
                 Lockless nlock(process->postBehaviorFlag);
                 process
                     ->postBhvrRefBy[nemesis::to_lower_copy(projectdir.wstring() + L"\\"
@@ -859,7 +855,7 @@ void checkBehaviorJoint(
 
 void checkClipAnimData(sf::path filepath, 
 					   sf::path projectdir,
-					   string& line,
+					   string_view line,
                        VecStr& characterFiles,
                        string& clipName,
                        bool& isClip,
@@ -951,7 +947,7 @@ void checkClipAnimData(sf::path filepath,
         {
             isBehavior = false;
             pos += 29;
-            string behaviorFile = line.substr(pos, line.find("</hkparam>", pos) - pos);
+            string behaviorFile(line.substr(pos, line.find("</hkparam>", pos) - pos));
             Lockless nlock(process->postBehaviorFlag);
             process
                 ->postBhvrRefBy[nemesis::transform_to<wstring>(nemesis::to_lower_copy(
@@ -961,72 +957,201 @@ void checkClipAnimData(sf::path filepath,
     }
 }
 
-void fileArchitectureCheck(sf::path hkxfile)
+bool isClipAnimDataLine(string_view line)
+{
+    return line.find("class=\"hkbClipGenerator\" signature=\"0x333b85b9\">") != NOT_FOUND
+           || line.find("<hkparam name=\"animationName\">") != NOT_FOUND
+           || line.find("<hkparam name=\"name\">") != NOT_FOUND
+           || line.find("class=\"hkbBehaviorReferenceGenerator\" signature=\"0xfcb5423\">") != NOT_FOUND
+           || line.find("<hkparam name=\"behaviorName\">") != NOT_FOUND;
+}
+
+namespace
 {
-    FILE* f;
-    _wfopen_s(&f, hkxfile.wstring().c_str(), L"r+b");
+    // architecture of every hkx under meshes\actors from the last scan
+    const sf::path hkxIndexFile = "cache\\hkx_architecture";
+    const string hkxIndexFormat = "hkx architecture 1";
+
+    struct HkxRecord
+    {
+        uintmax_t size;
+        int64_t time;
+        uint8_t pointerSize;
+    };
 
-    if (f)
+    struct ScannedHkx
     {
-        fseek(f, 0x10, SEEK_SET);
-        unsigned char charcode;
-        fread(&charcode, sizeof(charcode), 1, f);
-        fclose(f);
+        wstring path;
+        uint8_t pointerSize;
+    };
+
+    vector<ScannedHkx> scannedHkx;
+
+    unordered_map<wstring, HkxRecord> loadHkxIndex()
+    {
+        unordered_map<wstring, HkxRecord> index;
+
+        if (!isFileExist(hkxIndexFile)) return index;
+
+        FileReader input(hkxIndexFile);
+        string line;
 
-        if (SSE)
+        if (!input.GetFile() || !input.GetLines(line) || line != hkxIndexFormat) return index;
+
+        while (input.GetLines(line))
         {
-            if (charcode == 0x4)
+            VecStr part;
+            size_t pos  = 0;
+            size_t next = line.find(">>");
+
+            while (next != NOT_FOUND)
+            {
+                part.push_back(line.substr(pos, next - pos));
+                pos  = next + 2;
+                next = line.find(">>", pos);
+            }
+
+            part.push_back(line.substr(pos));
+
+            // a damaged index only costs probing every file again
+            if (part.size() != 4) return {};
+
+            try
             {
-                WarningMessage(1027, "32bit", hkxfile);
-                fileCheckMsg.push_back(warningMsges.back());
+                index[nemesis::transform_to<wstring>(part[0])]
+                    = HkxRecord{stoull(part[1]), stoll(part[2]), static_cast<uint8_t>(stoi(part[3]))};
+            }
+            catch (const exception&)
+            {
+                return {};
             }
         }
-        else if (charcode == 0x8)
+
+        return index;
+    }
+
+    void saveHkxIndex(const vector<pair<wstring, HkxRecord>>& records)
+    {
+        FileWriter output(hkxIndexFile);
+
+        if (!output.is_open()) return;
+
+        output << hkxIndexFormat << "\n";
+
+        for (auto& record : records)
         {
-            WarningMessage(1027, "64bit", hkxfile);
-            fileCheckMsg.push_back(warningMsges.back());
+            output << record.first << ">>" << to_string(record.second.size) << ">>"
+                   << to_string(record.second.time) << ">>" << to_string(record.second.pointerSize) << "\n";
         }
     }
-}
 
-void fileArchitectureCheck(wstring hkxfile)
-{
-    fileArchitectureCheck(nemesis::transform_to<string>(hkxfile));
+    // Walks a directory tree with one task per directory. Entries keep the file type, size and time found
+    // while listing the directory, so unchanged files cost no more than their directory listing
+    class HkxScanner
+    {
+        const unordered_map<wstring, HkxRecord>& index;
+        nemesis::TaskGroup group;
+        mutex resultMutex;
+
+    public:
+        vector<pair<wstring, HkxRecord>> records;
+        size_t probed = 0;
+
+        HkxScanner(const unordered_map<wstring, HkxRecord>& _index)
+            : index(_index)
+        {
+        }
+
+        void scan(const sf::path& root)
+        {
+            group.run([this, root] { walk(root); });
+            group.wait();
+
+            // tasks finish in any order
+            sort(records.begin(), records.end(), [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+        }
+
+        void walk(const sf::path& directory)
+        {
+            vector<pair<wstring, HkxRecord>> found;
+            size_t newProbe = 0;
+            error_code ec;
+
+            for (auto& entry : sf::directory_iterator(directory, ec))
+            {
+                if (error) throw nemesis::exception();
+
+                if (entry.is_directory(ec))
+                {
+                    sf::path subdirectory = entry.path();
+                    group.run([this, subdirectory] { walk(subdirectory); });
+                    continue;
+                }
+
+                if (!nemesis::iequals(entry.path().extension().wstring(), L".hkx")) continue;
+
+                HkxRecord record;
+                record.size = entry.file_size(ec);
+
+                if (ec) continue;
+
+                record.time = entry.last_write_time(ec).time_since_epoch().count();
+
+                if (ec) continue;
+
+                wstring path = entry.path().wstring();
+                auto itr     = index.find(path);
+
+                if (itr != index.end() && itr->second.size == record.size && itr->second.time == record.time)
+                {
+                    record.pointerSize = itr->second.pointerSize;
+                }
+                else
+                {
+                    record.pointerSize = nemesis::hkx_facts(path)->pointerSize;
+                    ++newProbe;
+                }
+
+                found.emplace_back(move(path), record);
+            }
+
+            lock_guard<mutex> lock(resultMutex);
+            probed += newProbe;
+            move(found.begin(), found.end(), back_inserter(records));
+        }
+    };
+
+    bool wrongArchitecture(uint8_t pointerSize)
+    {
+        return SSE ? pointerSize == 4 : pointerSize == 8;
+    }
 }
 
-void checkAllStoredHKX()
+void fileArchitectureCheck(sf::path hkxfile)
 {
-	for (auto& file : hkxFiles)
-	{
-		if (isFileExist(file))
-		{
-			fileArchitectureCheck(file);
-		}
-	}
+    if (!wrongArchitecture(nemesis::hkx_facts(hkxfile)->pointerSize)) return;
 
-	hkxFiles.clear();
+    WarningMessage(1027, SSE ? "32bit" : "64bit", hkxfile);
+    fileCheckMsg.push_back(warningMsges.back());
 }
 
-void checkFolder(sf::path filepath)
+void fileArchitectureCheck(wstring hkxfile)
 {
-    VecWstr list;
-    read_directory(filepath, list);
+    fileArchitectureCheck(sf::path(hkxfile));
+}
 
-    for (auto& each : list)
+void checkAllStoredHKX()
+{
+    // only files that looked wrong during the scan are probed again, they may have been replaced since
+    for (auto& file : scannedHkx)
     {
-        std::filesystem::path file(filepath.wstring() + L"\\" + each);
-
-        if (std::filesystem::is_directory(file))
+        if (wrongArchitecture(file.pointerSize) && isFileExist(file.path))
         {
-            checkFolder(file);
+            fileArchitectureCheck(file.path);
         }
-        else if (nemesis::iequals(file.extension().wstring(), L".hkx"))
-        {
-            hkxFiles.push_back(file.wstring());
-        }
-
-        if (error) throw nemesis::exception();
     }
+
+    scannedHkx.clear();
 }
 
 void checkAllFiles(sf::path filepath)
@@ -1038,9 +1163,23 @@ void checkAllFiles(sf::path filepath)
 			try
 			{
 				DebugLogging("Background hkx file architecture check: INITIALIZED");
-				hkxFiles.clear();
-				checkFolder(filepath);
-				DebugLogging("Background hkx file architecture check: COMPLETED");
+				scannedHkx.clear();
+
+				auto index = loadHkxIndex();
+				HkxScanner scanner(index);
+				scanner.scan(filepath);
+
+				// the scan reads every hkx under the data path once, their facts are not needed again
+				nemesis::clear_hkx_facts();
+
+				for (auto& record : scanner.records)
+				{
+					scannedHkx.push_back(ScannedHkx{record.first, record.second.pointerSize});
+				}
+
+				saveHkxIndex(scanner.records);
+				DebugLogging("Background hkx file architecture check: COMPLETED (" + to_string(scanner.records.size())
+				             + " files, " + to_string(scanner.probed) + " probed)");
 			}
 			catch (const exception& ex)
 			{
@@ -1070,11 +1209,11 @@ void ClearGlobal(bool all)
 	{
 		DebugLogging("Global reset all: TRUE");
 
-		usedAnim = unordered_map<string, SetStr>();
+		usedAnim = unordered_map<nemesis::InternedKey, SetStr>();
 
-		registeredAnim = unordered_map<string, SetStr>();
+		registeredAnim = unordered_map<nemesis::InternedKey, SetStr>();
 
-		animModMatch = unordered_map<string, unordered_map<string, vector<SetStr>>>();
+		animModMatch = unordered_map<nemesis::InternedKey, unordered_map<nemesis::InternedKey, vector<SetStr>>>();
 
 		behaviorJoints = unordered_map<string, VecStr>();
 
@@ -1089,11 +1228,11 @@ void ClearGlobal(bool all)
 	charAnimDataInfo = map<string, map<string, shared_ptr<AnimationDataTracker>>>();
 
 	behaviorProjectPath = unordered_map<wstring, wstring>();
-	behaviorPath = unordered_map<wstring, wstring>();
-	AAGroup = unordered_map<string, string>();
+	behaviorPath = unordered_map<nemesis::InternedKey, wstring>();
+	AAGroup = unordered_map<nemesis::InternedKey, string>();
 	crc32Cache = unordered_map<string, string>();
 	
-	behaviorProject = unordered_map<string, VecStr>();
+	behaviorProject = unordered_map<nemesis::InternedKey, VecStr>();
 	alternateAnim = unordered_map<string, VecStr>();
 	groupAA = unordered_map<string, VecStr>();
 	groupAAPrefix = unordered_map<string, VecStr>();
@@ -1,5 +1,7 @@
 #include "Global.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <regex>
 #include <unordered_set>
@@ -8,6 +10,8 @@
 #include "nemesisinfo.h"
 
 #include "utilities/regex.h"
+#include "utilities/threadpool.h"
+#include "utilities/readtextfile.h"
 #include "utilities/writetextfile.h"
 
 #include "generate/papyruscompile.h"
@@ -67,7 +71,218 @@ void forcedCopy(sf::path animFile, sf::path newAnimFile, int count = 0)
     }
 }
 
-void PCEASubFolder(string path, unsigned short number, string pceafolder, string subpath, PCEA& mod)
+namespace
+{
+    // what the last run placed in PCEA_animations, so unchanged animations are left where they are
+    const sf::path pceaManifestFile = "cache\\pcea_animations";
+    const string pceaManifestFormat = "pcea animations 1";
+
+    struct PCEASource
+    {
+        wstring path;
+        uintmax_t size;
+        int64_t time;
+    };
+
+    struct PCEAPlacement
+    {
+        sf::path target;
+        PCEASource source;
+    };
+
+    unordered_map<wstring, PCEASource> loadPCEAManifest()
+    {
+        unordered_map<wstring, PCEASource> manifest;
+
+        if (!isFileExist(pceaManifestFile)) return manifest;
+
+        FileReader input(pceaManifestFile);
+        string line;
+
+        if (!input.GetFile() || !input.GetLines(line) || line != pceaManifestFormat) return manifest;
+
+        while (input.GetLines(line))
+        {
+            VecStr part;
+            size_t pos  = 0;
+            size_t next = line.find(">>");
+
+            while (next != NOT_FOUND)
+            {
+                part.push_back(line.substr(pos, next - pos));
+                pos  = next + 2;
+                next = line.find(">>", pos);
+            }
+
+            part.push_back(line.substr(pos));
+
+            // a damaged manifest only costs placing every animation again
+            if (part.size() != 4) return {};
+
+            try
+            {
+                manifest[nemesis::transform_to<wstring>(part[0])]
+                    = PCEASource{nemesis::transform_to<wstring>(part[1]), stoull(part[2]), stoll(part[3])};
+            }
+            catch (const exception&)
+            {
+                return {};
+            }
+        }
+
+        return manifest;
+    }
+
+    void savePCEAManifest(const vector<PCEAPlacement>& placements)
+    {
+        FileWriter output(pceaManifestFile);
+
+        if (!output.is_open()) return;
+
+        output << pceaManifestFormat << "\n";
+
+        for (auto& placement : placements)
+        {
+            output << nemesis::to_lower_copy(placement.target.wstring()) << ">>" << placement.source.path << ">>"
+                   << to_string(placement.source.size) << ">>" << to_string(placement.source.time) << "\n";
+        }
+    }
+
+    bool isPlaced(const PCEAPlacement& placement, const unordered_map<wstring, PCEASource>& manifest)
+    {
+        auto itr = manifest.find(nemesis::to_lower_copy(placement.target.wstring()));
+
+        if (itr == manifest.end() || placement.source.time == 0) return false;
+
+        const PCEASource& last = itr->second;
+
+        if (last.path != placement.source.path || last.size != placement.source.size
+            || last.time != placement.source.time)
+        {
+            return false;
+        }
+
+        error_code ec;
+        return sf::file_size(placement.target, ec) == placement.source.size && !ec;
+    }
+
+    // hard link when the pack and the data folder share a volume, copy otherwise. returns true if linked
+    bool placePCEAAnimation(const PCEAPlacement& placement)
+    {
+        sf::path source(placement.source.path);
+        error_code ec;
+
+        if (isFileExist(placement.target) && !sf::is_directory(placement.target)) tryDelete(placement.target.string());
+
+        // other workers may create the same folder at the same time, an existing folder is not an error
+        sf::create_directories(placement.target.parent_path(), ec);
+        sf::create_hard_link(source, placement.target, ec);
+
+        if (!ec) return true;
+
+        forcedCopy(source, placement.target);
+
+        if (!sf::exists(source)) ErrorMessage(1185, placement.target.string());
+
+        return false;
+    }
+
+    // removes every file of PCEA_animations that no pack places anymore, then the empty folders no pack
+    // places into
+    void removeStalePCEA(const sf::path& pceafolder, const vector<PCEAPlacement>& placements)
+    {
+        unordered_set<wstring> planned;
+        unordered_set<wstring> plannedFolders;
+        vector<sf::path> stale;
+        vector<sf::path> folders;
+        error_code ec;
+
+        for (auto& placement : placements)
+        {
+            planned.insert(nemesis::to_lower_copy(placement.target.wstring()));
+
+            for (sf::path folder = placement.target.parent_path(); folder.has_relative_path();
+                 folder          = folder.parent_path())
+            {
+                if (!plannedFolders.insert(nemesis::to_lower_copy(folder.wstring())).second) break;
+            }
+        }
+
+        for (auto& entry : sf::recursive_directory_iterator(pceafolder, ec))
+        {
+            if (entry.is_directory(ec))
+            {
+                if (plannedFolders.find(nemesis::to_lower_copy(entry.path().wstring())) == plannedFolders.end())
+                {
+                    folders.push_back(entry.path());
+                }
+            }
+            else if (planned.find(nemesis::to_lower_copy(entry.path().wstring())) == planned.end())
+            {
+                stale.push_back(entry.path());
+            }
+        }
+
+        for (auto& file : stale)
+        {
+            tryDelete(file.string());
+        }
+
+        // deepest first, folders still in use fail to be removed and are kept
+        sort(folders.begin(), folders.end(), [](auto& lhs, auto& rhs) {
+            return lhs.wstring().length() > rhs.wstring().length();
+        });
+
+        for (auto& folder : folders)
+        {
+            sf::remove(folder, ec);
+        }
+    }
+
+    void syncPCEAAnimations(const sf::path& pceafolder, const vector<PCEAPlacement>& placements)
+    {
+        auto manifest = loadPCEAManifest();
+        removeStalePCEA(pceafolder, placements);
+
+        nemesis::TaskGroup group;
+        atomic<size_t> linked = 0;
+        atomic<size_t> copied = 0;
+        size_t kept           = 0;
+
+        for (auto& placement : placements)
+        {
+            if (isPlaced(placement, manifest))
+            {
+                ++kept;
+                continue;
+            }
+
+            group.run([&placement, &linked, &copied] {
+                if (placePCEAAnimation(placement))
+                {
+                    ++linked;
+                }
+                else
+                {
+                    ++copied;
+                }
+            });
+        }
+
+        group.wait();
+        savePCEAManifest(placements);
+        DebugLogging("PCEA animations: " + to_string(kept) + " unchanged, " + to_string(linked.load())
+                     + " linked, " + to_string(copied.load()) + " copied");
+    }
+}
+
+void PCEASubFolder(string path,
+                   unsigned short number,
+                   string pceafolder,
+                   string subpath,
+                   PCEA& mod,
+                   vector<PCEAPlacement>& placements,
+                   unordered_set<wstring>& taken)
 {
     VecStr animlist;
     read_directory(path, animlist);
@@ -80,11 +295,15 @@ void PCEASubFolder(string path, unsigned short number, string pceafolder, string
         {
             if (!nemesis::iequals(animFile.extension().string(), ".hkx")) continue;
 
+            // earlier packs with the same animation in this folder took the lower numbers
             int numb           = 0;
             string newFileName = "fp2" + to_string(numb++) + "_" + anim;
 
-            while (isFileExist(pceafolder + "\\" + newFileName))
+            while (!taken.insert(nemesis::transform_to<wstring>(nemesis::to_lower_copy(pceafolder + "\\" + newFileName)))
+                        .second)
+            {
                 newFileName = "fp2" + to_string(numb++) + "_" + anim;
+            }
 
             sf::path newAnimFile(pceafolder + "\\" + newFileName);
             string lowerAnim            = nemesis::to_lower_copy(anim);
@@ -92,13 +311,25 @@ void PCEASubFolder(string path, unsigned short number, string pceafolder, string
 
             if (!isFileExist(pceafolder)) sf::create_directories(pceafolder);
 
-            forcedCopy(animFile, newAnimFile);
+            error_code ec;
+            PCEASource source{animFile.wstring(), sf::file_size(animFile, ec), 0};
+
+            if (!ec) source.time = sf::last_write_time(animFile, ec).time_since_epoch().count();
 
-            if (!sf::exists(animFile)) ErrorMessage(1185, newAnimFile.string());
+            // unknown sources are always placed again
+            if (ec) source.time = 0;
+
+            placements.push_back(PCEAPlacement{newAnimFile, move(source)});
         }
         else
         {
-            PCEASubFolder(animFile.string(), number, pceafolder + "\\" + anim, subpath + "\\" + anim, mod);
+            PCEASubFolder(animFile.string(),
+                          number,
+                          pceafolder + "\\" + anim,
+                          subpath + "\\" + anim,
+                          mod,
+                          placements,
+                          taken);
         }
     }
 }
@@ -113,13 +344,13 @@ void ReadPCEA(const NemesisInfo* nemesisInfo)
     wstring datapath = nemesisInfo->GetDataPath() + L"meshes\\actors\\character\\Animations\\Nemesis_PCEA";
     sf::path pceafolder(datapath + L"\\PCEA_animations");
 
-    if (isFileExist(pceafolder.string())) Delete(pceafolder);
-
     if (!FolderCreate(datapath + L"\\PCEA_animations\\")) return;
 
     read_directory(datapath, folderlist);
     map<unsigned short, PCEA> modlist;
     map<unsigned short, wstring> pceaFolderMapList;
+    vector<PCEAPlacement> placements;
+    unordered_set<wstring> taken;
 
     for (auto& folder : folderlist)
     {
@@ -144,13 +375,20 @@ void ReadPCEA(const NemesisInfo* nemesisInfo)
         {
             PCEA mod;
             mod.modFile = folder.substr(folder.find("|") + 1);
-            PCEASubFolder(
-                folder.substr(0, folder.find("|")), number, pceafolder.string(), "PCEA_animations", mod);
+            PCEASubFolder(folder.substr(0, folder.find("|")),
+                          number,
+                          pceafolder.string(),
+                          "PCEA_animations",
+                          mod,
+                          placements,
+                          taken);
 
             if (mod.animPathList.size() > 0) modlist[number] = mod;
         }
     }
 
+    syncPCEAAnimations(pceafolder, placements);
+
     // limitation lifts
     // if (modlist.size() > 10) ErrorMessage(7000);
 
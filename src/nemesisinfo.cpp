@@ -31,6 +31,7 @@ void NemesisInfo::iniFileUpdate()
         file.PutLine("modNameWidth=" + to_string(modNameWidth));
         file.PutLine("authorWidth=" + to_string(authorWidth));
         file.PutLine("priorityWidth=" + to_string(priorityWidth));
+        file.PutLine("hkxConverters=" + to_string(hkxConverters));
         file.Flush();
         file.Close();
     }
@@ -111,6 +112,11 @@ void NemesisInfo::setup()
                                 L"priorityWidth", 
                                 [&] { priorityWidth = stoi(path); }
                             },
+                            {
+                                L"hkxconverters",
+                                // 0 runs one converter per core, a negative count must not wrap around to a huge one
+                                [&] { hkxConverters = max(stoi(path), 0); }
+                            },
                         };
 
                         if (input == L"skyrimdatadirectory")
@@ -374,6 +380,11 @@ const uint& NemesisInfo::GetPriorityWidth() const
     return priorityWidth;
 }
 
+const uint& NemesisInfo::GetHkxConverters() const
+{
+    return hkxConverters;
+}
+
 void NemesisInfo::setFirst(bool _first)
 {
     first = _first;
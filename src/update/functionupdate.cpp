@@ -27,10 +27,8 @@ bool ClassCheck(vector<int>& modEditCoordinate,
                 unordered_map<string, int>& modEditLine,
                 unordered_map<int, int>& NewCoordinate,
                 int linecount,
-                VecStr& storeline,
+                ASDLinePosition& storePosition,
                 string filepath,
-                string projectfile,
-                string filename,
                 string modcode);
 void addAnimDataPack(const string& projectfile,
                      const string& filename,
@@ -43,7 +41,7 @@ void addInfoDataPack(const string& filepath,
                      const MasterAnimData::ProjectPtr& projData,
                      const VecStr& storeline);
 
-bool GetFunctionEdits(string& line, VecStr storeline, int numline)
+bool GetFunctionEdits(string& line, const VecStr& storeline, int numline)
 {
     if (numline < int(storeline.size()))
     {
@@ -55,7 +53,7 @@ bool GetFunctionEdits(string& line, VecStr storeline, int numline)
     return false;
 }
 
-VecStr GetFunctionEdits(string filename, VecStr storeline, int startline, int endline)
+VecStr GetFunctionEdits(string filename, const VecStr& storeline, int startline, int endline)
 {
     VecStr storage;
     storage.reserve(endline);
@@ -92,7 +90,9 @@ bool NodeU::NodeUpdate(string modcode,
 #endif
 )
 {
-    if (behaviorPath[nemesis::transform_to<wstring>(nemesis::to_lower_copy(behaviorfile))].empty())
+    auto path = nemesis::find_key(behaviorPath, behaviorfile);
+
+    if (path == behaviorPath.end() || path->second.empty())
     {
         ErrorMessage(2006, behaviorfile);
     }
@@ -178,12 +178,9 @@ bool NodeU::NodeUpdate(string modcode,
                 }
                 else if (!originalopen && line.find("<hkparam name=\"stateId\">") != NOT_FOUND)
                 {
-                    string stateIDStr = nemesis::regex_replace(
-                        string(line),
-                        nemesis::regex(".*<hkparam name=\"stateId\">([0-9]+)</hkparam>.*"),
-                        string("\\1"));
+                    string stateIDStr;
 
-                    if (stateIDStr != line)
+                    if (nemesis::number_between(line, "<hkparam name=\"stateId\">", "</hkparam>", stateIDStr))
                     {
 #if MULTITHREADED_UPDATE
                         Lockless lock(stateLock);
@@ -242,31 +239,27 @@ bool NodeU::NodeUpdate(string modcode,
                         if (line.find("<hkparam name=\"eventNames\" numelements=", 0) != NOT_FOUND
                             || line.find("<hkparam name=\"eventInfos\" numelements=", 0) != NOT_FOUND)
                         {
-                            eventcount = stoi(nemesis::regex_replace(
-                                string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                            eventcount = stoi(nemesis::first_number(line));
                         }
                         else if (line.find("<hkparam name=\"attributeNames\" numelements=", 0) != NOT_FOUND
                                  || line.find("<hkparam name=\"attributeDefaults\" numelements=", 0)
                                         != NOT_FOUND)
                         {
-                            attributecount = stoi(nemesis::regex_replace(
-                                string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                            attributecount = stoi(nemesis::first_number(line));
                         }
                         else if (line.find("<hkparam name=\"variableNames\" numelements=", 0) != NOT_FOUND
                                  || line.find("<hkparam name=\"wordVariableValues\" numelements=", 0)
                                         != NOT_FOUND
                                  || line.find("<hkparam name=\"variableInfos\" numelements=", 0) != NOT_FOUND)
                         {
-                            variablecount = stoi(nemesis::regex_replace(
-                                string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                            variablecount = stoi(nemesis::first_number(line));
                         }
                         else if (line.find("<hkparam name=\"characterPropertyNames\" numelements=", 0)
                                      != NOT_FOUND
                                  || line.find("<hkparam name=\"characterPropertyInfos\" numelements=", 0)
                                         != NOT_FOUND)
                         {
-                            characterpropertycount = stoi(nemesis::regex_replace(
-                                string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                            characterpropertycount = stoi(nemesis::first_number(line));
                         }
                     }
 
@@ -336,8 +329,7 @@ bool NodeU::NodeUpdate(string modcode,
                         {
                             int tempint
                                 = eventcount
-                                  - stoi(nemesis::regex_replace(
-                                      string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                                  - stoi(nemesis::first_number(line));
 
                             if (line.find("<!-- EVENT numelement ", 0) != NOT_FOUND)
                             {
@@ -357,8 +349,7 @@ bool NodeU::NodeUpdate(string modcode,
                         {
                             int tempint
                                 = attributecount
-                                  - stoi(nemesis::regex_replace(
-                                      string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                                  - stoi(nemesis::first_number(line));
 
                             if (line.find("<!-- ATTRIBUTE numelement ", 0) != NOT_FOUND)
                             {
@@ -381,8 +372,7 @@ bool NodeU::NodeUpdate(string modcode,
                         {
                             int tempint
                                 = variablecount
-                                  - stoi(nemesis::regex_replace(
-                                      string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                                  - stoi(nemesis::first_number(line));
 
                             if (line.find("<!-- VARIABLE numelement ", 0) != NOT_FOUND)
                             {
@@ -405,8 +395,7 @@ bool NodeU::NodeUpdate(string modcode,
                         {
                             int tempint
                                 = characterpropertycount
-                                  - stoi(nemesis::regex_replace(
-                                      string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                                  - stoi(nemesis::first_number(line));
 
                             if (line.find("<!-- CHARACTER numelement ", 0) != NOT_FOUND)
                             {
@@ -435,10 +424,8 @@ bool NodeU::NodeUpdate(string modcode,
                             }
 
                             int difference
-                                = stoi(nemesis::regex_replace(
-                                      string(templine), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")))
-                                  - stoi(nemesis::regex_replace(
-                                      string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1")));
+                                = stoi(nemesis::first_number(templine))
+                                  - stoi(nemesis::first_number(line));
 
                             if (line.find("<!-- numelement *", 0) != NOT_FOUND)
                                 line.append(" <!-- numelement *" + modcode + "* +"
@@ -545,12 +532,9 @@ bool NodeU::NodeUpdate(string modcode,
         {
             if (line.find("<hkparam name=\"stateId\">") != NOT_FOUND)
             {
-                string stateIDStr = nemesis::regex_replace(
-                    string(line),
-                    nemesis::regex(".*<hkparam name=\"stateId\">([0-9]+)</hkparam>.*"),
-                    string("\\1"));
+                string stateIDStr;
 
-                if (stateIDStr != line)
+                if (nemesis::number_between(line, "<hkparam name=\"stateId\">", "</hkparam>", stateIDStr))
                 {
 #if MULTITHREADED_UPDATE
                     Lockless lock(stateLock);
@@ -631,7 +615,9 @@ bool AnimDataUpdate(string modcode,
                     bool& openAnim,
                     bool& openInfo)
 {
-    if (behaviorPath[nemesis::transform_to<wstring>(nemesis::to_lower_copy(animdatafile))].empty())
+    auto path = nemesis::find_key(behaviorPath, animdatafile);
+
+    if (path == behaviorPath.end() || path->second.empty())
     {
         ErrorMessage(2007, animdatafile);
     }
@@ -1147,7 +1133,9 @@ bool AnimSetDataUpdate(string modcode,
                        bool isNewProject,
                        unordered_map<wstring, wstring>& lastUpdate)
 {
-    if (behaviorPath[nemesis::transform_to<wstring>(nemesis::to_lower_copy(animdatasetfile))].empty())
+    auto path = nemesis::find_key(behaviorPath, animdatasetfile);
+
+    if (path == behaviorPath.end() || path->second.empty())
     {
         ErrorMessage(2007, animdatasetfile);
     }
@@ -1255,6 +1243,7 @@ bool AnimSetDataUpdate(string modcode,
             VecStr newline = animSetData.newAnimSetData[projectfile][lowerfile];
             VecStr functionline;
             VecStr headerline;
+            ASDLinePosition storePosition(storeline, projectfile, filename, modcode);
 
             int editcount = 0;
 
@@ -1290,12 +1279,8 @@ bool AnimSetDataUpdate(string modcode,
                         }
 
                         using namespace ASDFormat;
-                        position curPosition = ASDPosition(storeline,
-                                                           projectfile,
-                                                           filename,
-                                                           modcode,
-                                                           modEditLine[std::to_string(linecount)],
-                                                           false);
+                        position curPosition
+                            = storePosition.at(modEditLine[std::to_string(linecount)], false);
 
                         if (curPosition != equipcount && curPosition != typecount
                             && curPosition != animpackcount && curPosition != attackcount
@@ -1338,10 +1323,8 @@ bool AnimSetDataUpdate(string modcode,
                                             modEditLine,
                                             NewCoordinate,
                                             linecount,
-                                            storeline,
+                                            storePosition,
                                             filepath,
-                                            projectfile,
-                                            filename,
                                             modcode))
                                 return false;
 
@@ -1409,19 +1392,15 @@ bool ClassCheck(vector<int>& modEditCoordinate,
                 unordered_map<string, int>& modEditLine,
                 unordered_map<int, int>& NewCoordinate,
                 int linecount,
-                VecStr& storeline,
+                ASDLinePosition& storePosition,
                 string filepath,
-                string projectfile,
-                string filename,
                 string modcode)
 {
     unsigned int endline = modEditLine[std::to_string(linecount) + "R"] + NewCoordinate[linecount];
     bool attacknew       = false;
     bool islast          = false;
 
-    if (ASDFormat::animpackname
-        == ASDPosition(
-            storeline, projectfile, filename, modcode, modEditLine[std::to_string(linecount) + "R"], true))
+    if (ASDFormat::animpackname == storePosition.at(modEditLine[std::to_string(linecount) + "R"], true))
     {
         attacknew = true;
     }
@@ -1436,7 +1415,7 @@ bool ClassCheck(vector<int>& modEditCoordinate,
 
         if (!islast)
         {
-            curPosition = ASDPosition(storeline, projectfile, filename, modcode, k, false);
+            curPosition = storePosition.at(k, false);
 
             if (error) throw nemesis::exception();
 
@@ -0,0 +1,174 @@
+#include "Global.h"
+#include "version.h"
+
+#include "utilities/readtextfile.h"
+#include "utilities/writetextfile.h"
+
+#include "generate/generationcache.h"
+
+#include "update/updateindex.h"
+
+using namespace std;
+namespace sf = filesystem;
+
+namespace
+{
+    string toHex(uint64_t value)
+    {
+        char buffer[17];
+        snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+}
+
+nemesis::UpdateIndex::UpdateIndex(sf::path _filename)
+    : filename(move(_filename))
+{
+}
+
+void nemesis::UpdateIndex::load()
+{
+    last.clear();
+    current.clear();
+    kept.clear();
+
+    if (!isFileExist(filename)) return;
+
+    FileReader input(filename);
+    string line;
+
+    if (!input.GetFile()) return;
+
+    // outputs of another version were merged by different code
+    if (!input.GetLines(line) || line != GetNemesisVersion()) return;
+
+    while (input.GetLines(line))
+    {
+        VecStr part;
+        size_t pos  = 0;
+        size_t next = line.find(">>");
+
+        while (next != NOT_FOUND)
+        {
+            part.push_back(line.substr(pos, next - pos));
+            pos  = next + 2;
+            next = line.find(">>", pos);
+        }
+
+        part.push_back(line.substr(pos));
+
+        // a damaged index only costs a full update
+        if (part.size() != 6)
+        {
+            last.clear();
+            return;
+        }
+
+        Output entry;
+
+        try
+        {
+            entry.key     = stoull(part[1], nullptr, 16);
+            entry.written = stoull(part[2], nullptr, 16);
+            entry.crc     = stoull(part[3]);
+            entry.joints.resize(stoul(part[4]));
+            entry.sources.resize(stoul(part[5]));
+        }
+        catch (const exception&)
+        {
+            last.clear();
+            return;
+        }
+
+        for (auto& each : entry.joints)
+        {
+            if (!input.GetLines(each))
+            {
+                last.clear();
+                return;
+            }
+        }
+
+        for (auto& each : entry.sources)
+        {
+            if (!input.GetLines(each))
+            {
+                last.clear();
+                return;
+            }
+        }
+
+        last[part[0]] = move(entry);
+    }
+}
+
+void nemesis::UpdateIndex::save() const
+{
+    FileWriter output(filename);
+
+    if (!output.is_open()) ErrorMessage(2009, filename);
+
+    output << GetNemesisVersion() << "\n";
+
+    for (auto& each : current)
+    {
+        output << each.first << ">>" << toHex(each.second.key) << ">>" << toHex(each.second.written) << ">>"
+               << to_string(each.second.crc) << ">>" << to_string(each.second.joints.size()) << ">>"
+               << to_string(each.second.sources.size()) << "\n";
+
+        for (auto& joint : each.second.joints)
+        {
+            output << joint << "\n";
+        }
+
+        for (auto& source : each.second.sources)
+        {
+            output << source << "\n";
+        }
+    }
+}
+
+bool nemesis::UpdateIndex::keep(const string& output, const sf::path& filepath, uint64_t key)
+{
+    auto itr = last.find(output);
+
+    if (itr == last.end() || itr->second.key != key) return false;
+
+    // the file may have been removed or replaced since it was written
+    if (hash_file(filepath) != itr->second.written) return false;
+
+    current[output] = itr->second;
+    kept.insert(output);
+    return true;
+}
+
+bool nemesis::UpdateIndex::isKept(const string& output) const
+{
+    return kept.find(output) != kept.end();
+}
+
+const nemesis::UpdateIndex::Output* nemesis::UpdateIndex::find(const string& output) const
+{
+    auto itr = current.find(output);
+    return itr != current.end() ? &itr->second : nullptr;
+}
+
+void nemesis::UpdateIndex::update(const string& output, const sf::path& filepath, Output entry)
+{
+    entry.written = hash_file(filepath);
+
+    if (entry.written == 0)
+    {
+        current.erase(output);
+        return;
+    }
+
+    current[output] = move(entry);
+}
+
+void nemesis::UpdateIndex::setSources(const string& output, vector<wstring> sources)
+{
+    auto itr = current.find(output);
+
+    if (itr != current.end()) itr->second.sources = move(sources);
+}
@@ -23,8 +23,10 @@
 
 #include "update/dataunification.h"
 #include "update/updateprocess.h"
+#include "update/vanillasnapshot.h"
 
 #include "generate/behaviorprocess_utility.h"
+#include "generate/generationcache.h"
 
 using namespace std;
 namespace sf = filesystem;
@@ -45,8 +47,6 @@ mutex admtx;
 mutex asdmtx;
 #endif
 
-void writeSave(FileWriter& writer, const string& line, string& store);
-void writeSave(FileWriter& writer, const char* line, string& store);
 void stateCheck(SSMap& parent,
                 string parentID,
                 string lowerbehaviorfile,
@@ -171,9 +171,8 @@ void UpdateFilesStart::startUpdatingFile()
         RunScript("scripts\\update\\start\\");
         DebugLogging("External script run complete");
 
-        // clear the temp_behaviors folder to prevent it from bloating
-        ClearTempBehaviors(nemesisInfo);
-        DebugLogging("Temp behavior clearance complete");
+        // temp_behaviors is kept, outputs no longer produced are removed once the update is done
+        updateIndex.load();
 
         // create "temp_behaviors" folder
         if (!isFileExist(directory)) sf::create_directory(directory);
@@ -332,14 +331,14 @@ bool UpdateFilesStart::VanillaUpdate()
     if (error) throw nemesis::exception();
 
 #if MULTITHREADED_UPDATE
-    nemesis::ThreadPool mt;
+    nemesis::TaskGroup mt;
 
     for (shared_ptr<RegisterQueue>& curBehavior : registeredFiles)
     {
-        mt.enqueue(&UpdateFilesStart::RegisterBehavior, this, curBehavior);
+        mt.run(&UpdateFilesStart::RegisterBehavior, this, curBehavior);
     }
 
-    mt.join();
+    mt.wait();
 #else
     for (shared_ptr<RegisterQueue>& curBehavior : registeredFiles)
     {
@@ -357,7 +356,7 @@ bool UpdateFilesStart::VanillaUpdate()
         {
             for (auto it = behaviorPath.begin(); it != behaviorPath.end(); ++it)
             {
-                output << it->first << "=" << it->second << "\n";
+                output << it->first.wstr() << "=" << it->second << "\n";
             }
         }
         else
@@ -374,7 +373,7 @@ bool UpdateFilesStart::VanillaUpdate()
         {
             for (auto it = behaviorProject.begin(); it != behaviorProject.end(); ++it)
             {
-                output << it->first.data() << "\n";
+                output << it->first.str() << "\n";
 
                 for (unsigned int i = 0; i < it->second.size(); ++i)
                 {
@@ -465,12 +464,20 @@ void UpdateFilesStart::RegisterBehavior(shared_ptr<RegisterQueue> curBehavior)
 #if MULTITHREADED_UPDATE
                 Lockless lock(behaviorPathLock);
 #endif
-                behaviorPath[nemesis::to_lower_copy(curFileName)]
+                behaviorPath[curFileName]
                     = nemesis::to_lower_copy(curBehavior->file.parent_path().wstring() + L"\\" + curFileName);
             }
 
             if (!AnimDataDisassemble(newPath, animData)) return;
 
+            {
+                uint64_t fileHash = nemesis::hash_file(newPath);
+#if MULTITHREADED_UPDATE
+                Lockless lock(newFileLock);
+#endif
+                vanillaHash["animationdatasinglefile"] = fileHash;
+            }
+
             saveLastUpdate(nemesis::to_lower_copy(newPath), lastUpdate);
 
             DebugLogging(L"AnimData Disassemble complete (File: " + newPath + L")");
@@ -485,12 +492,20 @@ void UpdateFilesStart::RegisterBehavior(shared_ptr<RegisterQueue> curBehavior)
 #if MULTITHREADED_UPDATE
                 Lockless lock(behaviorPathLock);
 #endif
-                behaviorPath[nemesis::to_lower_copy(curFileName)]
+                behaviorPath[curFileName]
                     = nemesis::to_lower_copy(curBehavior->file.parent_path().wstring() + L"\\" + curFileName);
             }
 
             if (!AnimSetDataDisassemble(newPath, animSetData)) return;
 
+            {
+                uint64_t fileHash = nemesis::hash_file(newPath);
+#if MULTITHREADED_UPDATE
+                Lockless lock(newFileLock);
+#endif
+                vanillaHash["animationsetdatasinglefile"] = fileHash;
+            }
+
             saveLastUpdate(nemesis::to_lower_copy(newPath), lastUpdate);
 
             DebugLogging(L"AnimSetData Disassemble complete (File: " + newPath + L")");
@@ -526,7 +541,19 @@ void UpdateFilesStart::RegisterBehavior(shared_ptr<RegisterQueue> curBehavior)
             unique_ptr<SSMap> _stateID = make_unique<SSMap>();
             unique_ptr<SSMap> _parent  = make_unique<SSMap>();
 
-            VanillaDisassemble(newPath, _curNewFile, _childrenState, _stateID, _parent);
+            uint64_t fileHash = nemesis::hash_file(newPath);
+
+            if (nemesis::load_vanilla_snapshot(
+                    newPath, fileHash, *_curNewFile, *_childrenState, *_stateID, *_parent))
+            {
+                DebugLogging(L"Behavior Disassemble loaded from snapshot (File: " + newPath + L")");
+            }
+            else
+            {
+                VanillaDisassemble(newPath, _curNewFile, _childrenState, _stateID, _parent);
+                nemesis::save_vanilla_snapshot(
+                    newPath, fileHash, *_curNewFile, *_childrenState, *_stateID, *_parent);
+            }
 
             {
 #if MULTITHREADED_UPDATE
@@ -536,6 +563,7 @@ void UpdateFilesStart::RegisterBehavior(shared_ptr<RegisterQueue> curBehavior)
                 childrenState[curFileNameA] = move(_childrenState);
                 stateID[curFileNameA]       = move(_stateID);
                 parent[curFileNameA]        = move(_parent);
+                vanillaHash[curFileNameA]   = fileHash;
             }
 
             saveLastUpdate(nemesis::to_lower_copy(newPath), lastUpdate);
@@ -546,7 +574,7 @@ void UpdateFilesStart::RegisterBehavior(shared_ptr<RegisterQueue> curBehavior)
             if (nemesis::to_lower_copy(curBehavior->file.parent_path().filename().wstring()).find(L"characters")
                 == 0)
             {
-                registeredAnim[nemesis::to_lower_copy(curFileNameA)] = SetStr();
+                registeredAnim[curFileNameA] = SetStr();
             }
         }
         else if (wordFind(curFileName, L"Nemesis_") == 0
@@ -786,12 +814,10 @@ bool UpdateFilesStart::VanillaDisassemble(const wstring& path,
 
                     if (curline.find("<hkparam name=\"stateId\">") != NOT_FOUND)
                     {
-                        string stateIDStr = nemesis::regex_replace(
-                            string(curline),
-                            nemesis::regex(".*<hkparam name=\"stateId\">([0-9]+)</hkparam>.*"),
-                            string("\\1"));
+                        string stateIDStr;
 
-                        if (stateIDStr != curline)
+                        if (nemesis::number_between(
+                                curline, "<hkparam name=\"stateId\">", "</hkparam>", stateIDStr))
                         {
                             (*stateID)[curID] = stateIDStr;
                         }
@@ -845,7 +871,7 @@ bool UpdateFilesStart::VanillaDisassemble(const wstring& path,
                                 if (curline.find("<!-- Bone$N -->") == NOT_FOUND)
                                 {
                                     for (auto it = nemesis::regex_iterator(
-                                             curline, nemesis::regex("([0-9]+(\\.[0-9]+)?)"));
+                                             curline, nemesis::precompiled(nemesis::pattern::decimal));
                                          it != nemesis::regex_iterator();
                                          ++it)
                                     {
@@ -997,8 +1023,7 @@ bool UpdateFilesStart::AnimDataDisassemble(const wstring& path, MasterAnimData&
     if (!GetFunctionLines(path, storeline)) return false;
 
     {
-        string strnum = nemesis::regex_replace(
-            string(storeline[0]), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+        string strnum = nemesis::first_number(storeline[0]);
 
         if (!isOnlyNumber(strnum) || stoi(strnum) < 10) ErrorMessage(3014);
 
@@ -1093,8 +1118,7 @@ bool UpdateFilesStart::AnimSetDataDisassemble(const wstring& path, MasterAnimSet
     if (!GetFunctionLines(path, storeline)) return false;
 
     {
-        string strnum = nemesis::regex_replace(
-            string(storeline[0]), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+        string strnum = nemesis::first_number(storeline[0]);
 
         if (!isOnlyNumber(strnum) || stoi(strnum) < 10) ErrorMessage(3014);
 
@@ -1619,6 +1643,147 @@ void UpdateFilesStart::SeparateMod(const string& directory,
     }
 }
 
+void UpdateFilesStart::IndexOutputs(const string& directory)
+{
+    wstring compilingfolder = getTempBhvrPath(nemesisInfo).wstring() + L"\\";
+    uint64_t global         = nemesis::hash_content(GetNemesisVersion());
+    global                  = nemesis::hash_content(nemesis::transform_to<string>(compilingfolder), global);
+    global                  = nemesis::hash_directory("behavior templates", global);
+    VecStr outputs          = {"animationdatasinglefile", "animationsetdatasinglefile"};
+    size_t kept             = 0;
+
+    for (auto& behavior : newFile)
+    {
+        outputs.push_back(behavior.first);
+    }
+
+    for (auto& output : outputs)
+    {
+        uint64_t key = nemesis::hash_content(output, global);
+        auto vanilla = vanillaHash.find(output);
+        key          = nemesis::hash_content(vanilla != vanillaHash.end() ? vanilla->second : 0, key);
+        VecStr modlist;
+
+        for (auto& modcode : modFileList)
+        {
+            if (modcode.second.find(output) != modcode.second.end()) modlist.push_back(modcode.first);
+        }
+
+        // mods are merged in folder order
+        sort(modlist.begin(), modlist.end());
+
+        for (auto& modcode : modlist)
+        {
+            key = nemesis::hash_content(modcode, key);
+            key = nemesis::hash_directory(directory + modcode + "\\" + output, key);
+        }
+
+        outputKey[output] = key;
+
+        if (updateIndex.keep(output, compilingfolder + nemesis::transform_to<wstring>(output) + L".txt", key))
+        {
+            ++kept;
+        }
+    }
+
+    DebugLogging("Unchanged outputs kept from last update: " + to_string(kept) + "/" + to_string(outputs.size()));
+}
+
+void UpdateFilesStart::IndexSources()
+{
+    // kept outputs were not merged, the files that went into them are stamped again as they are now
+    for (auto& output : newFile)
+    {
+        if (!updateIndex.isKept(output.first)) continue;
+
+        for (auto& source : updateIndex.find(output.first)->sources)
+        {
+            saveLastUpdate(source, lastUpdate);
+        }
+    }
+
+    for (auto& output : {"animationdatasinglefile", "animationsetdatasinglefile"})
+    {
+        if (!updateIndex.isKept(output)) continue;
+
+        for (auto& source : updateIndex.find(output)->sources)
+        {
+            saveLastUpdate(source, lastUpdate);
+        }
+    }
+
+    // mod\\<modcode>\\<behavior>\\..., or mod\\<modcode>\\_1stperson\\<behavior>\\...
+    unordered_map<string, vector<wstring>> sources;
+
+    for (auto& stamp : lastUpdate)
+    {
+        const wstring& path = stamp.first;
+
+        if (path.find(L"mod\\") != 0) continue;
+
+        size_t start = path.find(L"\\", 4);
+
+        if (start == NOT_FOUND) continue;
+
+        size_t end = path.find(L"\\", ++start);
+
+        if (end == NOT_FOUND) continue;
+
+        if (path.compare(start, end - start, L"_1stperson") == 0) end = path.find(L"\\", end + 1);
+
+        if (end == NOT_FOUND) continue;
+
+        sources[nemesis::transform_to<string>(path.substr(start, end - start))].push_back(path);
+    }
+
+    for (auto& output : sources)
+    {
+        sort(output.second.begin(), output.second.end());
+        updateIndex.setSources(output.first, move(output.second));
+    }
+}
+
+void UpdateFilesStart::RemoveStaleOutputs(const wstring& compilingfolder)
+{
+    unordered_set<string> outputs = {"animationdatasinglefile", "animationsetdatasinglefile"};
+    vector<sf::path> stale;
+    error_code ec;
+
+    for (auto& behavior : newFile)
+    {
+        outputs.insert(behavior.first);
+    }
+
+    for (auto itr = sf::recursive_directory_iterator(compilingfolder, ec); itr != sf::recursive_directory_iterator();
+         itr.increment(ec))
+    {
+        // generated behaviors are cleared by the generation
+        if (itr->is_directory(ec))
+        {
+            if (itr.depth() == 0 && nemesis::iequals(itr->path().filename().wstring(), L"xml"))
+            {
+                itr.disable_recursion_pending();
+            }
+
+            continue;
+        }
+
+        sf::path relative = itr->path().lexically_relative(compilingfolder);
+
+        if (!nemesis::iequals(relative.extension().wstring(), L".txt")
+            || outputs.find(nemesis::to_lower_copy(relative.replace_extension().string())) == outputs.end())
+        {
+            stale.push_back(itr->path());
+        }
+    }
+
+    for (auto& file : stale)
+    {
+        DebugLogging(L"Stale output removed: " + file.wstring());
+        sf::remove(file, ec);
+    }
+}
+
 void UpdateFilesStart::JoiningEdits(string directory)
 {
     try
@@ -1722,8 +1887,13 @@ void UpdateFilesStart::JoiningEdits(string directory)
                     }
                 }
 
+                IndexOutputs(directory);
+
                 for (auto& behavior : modQueue)
                 {
+                    // nothing merged into it changed since the last update
+                    if (updateIndex.isKept(behavior.first)) continue;
+
                     for (auto& node : behavior.second)
                     {
                         processQueue.push_back(TargetQueue(behavior.first, node.first));
@@ -1744,14 +1914,14 @@ void UpdateFilesStart::JoiningEdits(string directory)
                 {
                     // Using non-multithreading method due to heap corruption upon using solution below
 #if MULTITHREADED_UPDATE
-                    nemesis::ThreadPool multiThreads;
+                    nemesis::TaskGroup multiThreads;
 
                     for (auto& each : processQueue)
                     {
-                        multiThreads.enqueue(&UpdateFilesStart::SeparateMod, this, directory, each, std::ref(pack));
+                        multiThreads.run(&UpdateFilesStart::SeparateMod, this, directory, each, std::ref(pack));
                     }
 
-                    multiThreads.join();
+                    multiThreads.wait();
 #else
                     for (auto& each : processQueue)
                     {
@@ -1814,7 +1984,6 @@ void UpdateFilesStart::JoiningEdits(string directory)
 
 void UpdateFilesStart::CombiningFiles()
 {
-    VecStr fileline;
     wstring compilingfolder    = getTempBhvrPath(nemesisInfo).wstring() + L"\\";
     unsigned long long bigNum  = CRC32Convert(GetNemesisVersion());
     unsigned long long bigNum2 = bigNum;
@@ -1833,34 +2002,23 @@ void UpdateFilesStart::CombiningFiles()
 
     for (auto& behavior : newFile) // behavior file name
     {
-        string rootID;
-        bool isOpen = false;
-        string OpeningMod;
-        VecStr fileline;
-        fileline.reserve(behavior.second->size());
-
-        for (auto& node : (*behavior.second)) // behavior node ID
+        if (updateIndex.isKept(behavior.first))
         {
-            size_t pos = node.first.find("$");
+            const nemesis::UpdateIndex::Output* kept = updateIndex.find(behavior.first);
 
-            if (pos != NOT_FOUND)
+            for (auto& behaviorName : kept->joints)
             {
-                string modID = node.first.substr(1, pos - 1);
+                behaviorJoints[behaviorName].push_back(behavior.first);
+            }
 
-                if (OpeningMod != modID && isOpen)
-                {
-                    fileline.push_back("<!-- CLOSE -->");
-                    isOpen = false;
-                }
+            (behavior.first.find("_1stperson\\") == 0 ? bigNum2 : bigNum) += kept->crc;
+            continue;
+        }
 
-                if (!isOpen)
-                {
-                    fileline.push_back("<!-- NEW *" + modID + "* -->");
-                    OpeningMod = modID;
-                    isOpen     = true;
-                }
-            }
+        string rootID;
 
+        for (auto& node : (*behavior.second)) // behavior node ID
+        {
             if (node.second.size() == 0) ErrorMessage(2008, behavior.first + " (" + node.first + ")");
 
             for (string& line : node.second)
@@ -1868,20 +2026,11 @@ void UpdateFilesStart::CombiningFiles()
                 if (line.find("class=\"hkRootLevelContainer\" signature=\"0x2772c11e\">", 0) != NOT_FOUND)
                 {
                     rootID = "#"
-                             + nemesis::regex_replace(
-                                 string(line), nemesis::regex("[^0-9]*([0-9]+).*"), string("\\1"));
+                             + nemesis::first_number(line);
                 }
-
-                fileline.push_back(line);
             }
         }
 
-        if (isOpen)
-        {
-            fileline.push_back("<!-- CLOSE -->");
-            isOpen = false;
-        }
-
         if (CreateFolder(compilingfolder))
         {
             string lowerBehaviorFile = behavior.first;
@@ -1895,19 +2044,16 @@ void UpdateFilesStart::CombiningFiles()
             if (output.is_open())
             {
                 bool behaviorRef = false;
-                string total     = nemesis::transform_to<string>(filepath) + "\n";
-
-                writeSave(output, "<?xml version=\"1.0\" encoding=\"ascii\"?>\n", total);
-                writeSave(
-                    output,
-                    "<hkpackfile classversion=\"8\" contentsversion=\"hk_2010.2.0 - r1\" toplevelobject=\""
-                        + rootID + "\">\n\n",
-                    total);
-                writeSave(output, "	<hksection name=\"__data__\">\n\n", total);
-
-                for (auto& line : fileline)
+                bool isOpen      = false;
+                string OpeningMod;
+                nemesis::UpdateIndex::Output entry;
+                entry.key = outputKey[lowerBehaviorFile];
+                CRCWriter writer(output);
+                writer.Checksum(nemesis::transform_to<string>(filepath) + "\n");
+
+                auto writeLine = [&](const string& line)
                 {
-                    writeSave(output, line + "\n", total);
+                    writer << line << "\n";
                     size_t pos = line.find("<hkobject name=\"");
 
                     if (pos != NOT_FOUND && line.find("signature=\"", pos) != NOT_FOUND)
@@ -1929,6 +2075,7 @@ void UpdateFilesStart::CombiningFiles()
                         }
 
                         behaviorJoints[behaviorName].push_back(lowerBehaviorFile);
+                        entry.joints.push_back(behaviorName);
                         behaviorRef = false;
                     }
                     else if (line.find("<hkparam name=\"behaviorFilename\">") != NOT_FOUND)
@@ -1945,13 +2092,53 @@ void UpdateFilesStart::CombiningFiles()
                         }
 
                         behaviorJoints[behaviorName].push_back(lowerBehaviorFile);
+                        entry.joints.push_back(behaviorName);
+                    }
+                };
+
+                writer << "<?xml version=\"1.0\" encoding=\"ascii\"?>\n";
+                writer << "<hkpackfile classversion=\"8\" contentsversion=\"hk_2010.2.0 - r1\" toplevelobject=\""
+                       << rootID << "\">\n\n";
+                writer << "	<hksection name=\"__data__\">\n\n";
+
+                // nodes are written as they are stored, no copy of the whole file is made
+                for (auto& node : (*behavior.second)) // behavior node ID
+                {
+                    size_t pos = node.first.find("$");
+
+                    if (pos != NOT_FOUND)
+                    {
+                        string modID = node.first.substr(1, pos - 1);
+
+                        if (OpeningMod != modID && isOpen)
+                        {
+                            writeLine("<!-- CLOSE -->");
+                            isOpen = false;
+                        }
+
+                        if (!isOpen)
+                        {
+                            writeLine("<!-- NEW *" + modID + "* -->");
+                            OpeningMod = modID;
+                            isOpen     = true;
+                        }
+                    }
+
+                    for (string& line : node.second)
+                    {
+                        writeLine(line);
                     }
                 }
 
-                writeSave(output, "	</hksection>\n\n", total);
-                writeSave(output, "</hkpackfile>\n", total);
-                fileline.clear();
-                (firstPerson ? bigNum2 : bigNum) += CRC32Convert(total);
+                if (isOpen) writeLine("<!-- CLOSE -->");
+
+                writer << "	</hksection>\n\n";
+                writer << "</hkpackfile>\n";
+                writer.Flush();
+                entry.crc = writer.GetCRC();
+                (firstPerson ? bigNum2 : bigNum) += entry.crc;
+                output.close();
+                updateIndex.update(lowerBehaviorFile, filepath, move(entry));
             }
             else
             {
@@ -1963,7 +2150,7 @@ void UpdateFilesStart::CombiningFiles()
     emit progressUp(); // 28
     behaviorJointsOutput();
 
-    if (CreateFolder(compilingfolder))
+    if (!updateIndex.isKept("animationdatasinglefile") && CreateFolder(compilingfolder))
     {
         wstring filepath = compilingfolder + L"animationdatasinglefile.txt";
         FileWriter output(filepath);
@@ -1973,8 +2160,12 @@ void UpdateFilesStart::CombiningFiles()
         {
             if (outputlist.is_open())
             {
-                string total = nemesis::transform_to<string>(filepath) + "\n";
                 animData.writelines(output);
+                output.close();
+
+                nemesis::UpdateIndex::Output entry;
+                entry.key = outputKey["animationdatasinglefile"];
+                updateIndex.update("animationdatasinglefile", filepath, move(entry));
             }
             else
             {
@@ -1988,7 +2179,11 @@ void UpdateFilesStart::CombiningFiles()
     }
     emit progressUp(); // 29
 
-    if (CreateFolder(compilingfolder))
+    if (updateIndex.isKept("animationsetdatasinglefile"))
+    {
+        bigNum2 += updateIndex.find("animationsetdatasinglefile")->crc;
+    }
+    else if (CreateFolder(compilingfolder))
     {
         wstring filepath = compilingfolder + L"animationsetdatasinglefile.txt";
         FileWriter output(filepath);
@@ -1998,12 +2193,13 @@ void UpdateFilesStart::CombiningFiles()
         {
             if (outputlist.is_open())
             {
-                string total = nemesis::transform_to<string>(filepath) + "\n";
-                writeSave(output, to_string(animSetData.projectList.size() - 1) + "\n", total);
+                CRCWriter writer(output);
+                writer.Checksum(nemesis::transform_to<string>(filepath) + "\n");
+                writer << to_string(animSetData.projectList.size() - 1) << "\n";
 
                 for (string& header : animSetData.newAnimSetData["$header$"]["$header$"])
                 {
-                    writeSave(output, header + "\n", total);
+                    writer << header << "\n";
                 }
 
                 for (unsigned int i = 1; i < animSetData.projectList.size(); ++i)
@@ -2014,7 +2210,7 @@ void UpdateFilesStart::CombiningFiles()
 
                     for (string& line : animSetData.newAnimSetData[project]["$header$"])
                     {
-                        writeSave(output, line + "\n", total);
+                        writer << line << "\n";
                     }
 
                     for (auto it = animSetData.newAnimSetData[project].begin();
@@ -2029,7 +2225,7 @@ void UpdateFilesStart::CombiningFiles()
 
                             for (unsigned int k = 0; k < it->second.size(); ++k)
                             {
-                                writeSave(output, it->second[k] + "\n", total);
+                                writer << it->second[k] << "\n";
                             }
                         }
                     }
@@ -2037,7 +2233,14 @@ void UpdateFilesStart::CombiningFiles()
                     outputlist << "\n";
                 }
 
-                bigNum2 += CRC32Convert(total);
+                writer.Flush();
+                bigNum2 += writer.GetCRC();
+                output.close();
+
+                nemesis::UpdateIndex::Output entry;
+                entry.key = outputKey["animationsetdatasinglefile"];
+                entry.crc = writer.GetCRC();
+                updateIndex.update("animationsetdatasinglefile", filepath, move(entry));
             }
             else
             {
@@ -2052,6 +2255,10 @@ void UpdateFilesStart::CombiningFiles()
 
     emit progressUp(); // 30
 
+    IndexSources();
+    RemoveStaleOutputs(compilingfolder);
+    updateIndex.save();
+
     FileWriter lastmod("cache\\engine_update");
 
     if (lastmod.is_open())
@@ -2225,14 +2432,14 @@ void UpdateFilesStart::newAnimProcess(string sourcefolder)
         read_directory(sourcefolder, codelist);
 
 #if MULTITHREADED_UPDATE
-        nemesis::ThreadPool multiThreads;
+        nemesis::TaskGroup multiThreads;
 
         for (auto& curCode : codelist)
         {
-            multiThreads.enqueue(&UpdateFilesStart::newAnimUpdate, this, sourcefolder, curCode);
+            multiThreads.run(&UpdateFilesStart::newAnimUpdate, this, sourcefolder, curCode);
         }
 
-        multiThreads.join();
+        multiThreads.wait();
 #else
         for (auto& curCode : codelist)
         {
@@ -2440,15 +2647,3 @@ void stateCheck(SSMap& parent,
         duplicatedStateList[filename][ID][sID].insert("Vanilla");
     }
 }
-
-void writeSave(FileWriter& writer, const string& line, string& store)
-{
-    writer << line;
-    store.append(line);
-}
-
-void writeSave(FileWriter& writer, const char* line, string& store)
-{
-    writer << line;
-    store.append(line);
-}
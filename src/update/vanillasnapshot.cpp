@@ -0,0 +1,323 @@
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+#include "Global.h"
+#include "version.h"
+
+#include "utilities/mappedfile.h"
+
+#include "generate/generationcache.h"
+
+#include "update/vanillasnapshot.h"
+
+using namespace std;
+namespace sf = filesystem;
+
+namespace
+{
+    const string snapshotMagic        = "nemesis vanilla snapshot";
+    constexpr uint32_t snapshotFormat = 1;
+
+    sf::path snapshotPath(const sf::path& behaviorFile)
+    {
+        char buffer[17];
+        uint64_t name = nemesis::hash_content(nemesis::to_lower_copy(behaviorFile.string()));
+        snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(name));
+        return sf::path("cache\\vanilla_snapshot") / buffer;
+    }
+
+    // every line, node ID and state ID is stored once, the tables refer to them by index
+    class SnapshotWriter
+    {
+        unordered_map<string_view, uint32_t> index;
+        vector<string_view> pool;
+
+    public:
+        string table;
+
+        void put(uint32_t value)
+        {
+            table.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void put(const string& text)
+        {
+            auto itr = index.find(text);
+
+            if (itr == index.end())
+            {
+                itr = index.emplace(text, static_cast<uint32_t>(pool.size())).first;
+                pool.push_back(text);
+            }
+
+            put(itr->second);
+        }
+
+        void write(ofstream& output, uint64_t fileHash) const
+        {
+            string header;
+            auto append = [&header](const void* data, size_t length) {
+                header.append(reinterpret_cast<const char*>(data), length);
+            };
+
+            string version = GetNemesisVersion();
+            uint32_t size  = static_cast<uint32_t>(snapshotMagic.length());
+            append(&size, sizeof(size));
+            header.append(snapshotMagic);
+            append(&snapshotFormat, sizeof(snapshotFormat));
+            size = static_cast<uint32_t>(version.length());
+            append(&size, sizeof(size));
+            header.append(version);
+            append(&fileHash, sizeof(fileHash));
+            size = static_cast<uint32_t>(pool.size());
+            append(&size, sizeof(size));
+
+            for (auto& text : pool)
+            {
+                size = static_cast<uint32_t>(text.length());
+                append(&size, sizeof(size));
+                header.append(text);
+            }
+
+            output.write(header.data(), header.size());
+            output.write(table.data(), table.size());
+        }
+    };
+
+    class SnapshotReader
+    {
+        string_view data;
+        vector<string_view> pool;
+
+    public:
+        bool failed = false;
+
+        SnapshotReader(string_view _data)
+            : data(_data)
+        {
+        }
+
+        bool done() const
+        {
+            return !failed && data.empty();
+        }
+
+        uint32_t number()
+        {
+            uint32_t value = 0;
+
+            if (failed || data.length() < sizeof(value))
+            {
+                failed = true;
+                return 0;
+            }
+
+            memcpy(&value, data.data(), sizeof(value));
+            data.remove_prefix(sizeof(value));
+            return value;
+        }
+
+        uint64_t number64()
+        {
+            uint64_t value = 0;
+
+            if (failed || data.length() < sizeof(value))
+            {
+                failed = true;
+                return 0;
+            }
+
+            memcpy(&value, data.data(), sizeof(value));
+            data.remove_prefix(sizeof(value));
+            return value;
+        }
+
+        string_view raw()
+        {
+            uint32_t length = number();
+
+            if (failed || data.length() < length)
+            {
+                failed = true;
+                return string_view();
+            }
+
+            string_view text = data.substr(0, length);
+            data.remove_prefix(length);
+            return text;
+        }
+
+        bool readPool()
+        {
+            uint32_t size = number();
+
+            if (size > data.length()) failed = true;
+
+            pool.reserve(failed ? 0 : size);
+
+            for (uint32_t i = 0; i < size && !failed; ++i)
+            {
+                pool.push_back(raw());
+            }
+
+            return !failed;
+        }
+
+        const string_view& text()
+        {
+            static const string_view empty;
+            uint32_t i = number();
+
+            if (failed || i >= pool.size())
+            {
+                failed = true;
+                return empty;
+            }
+
+            return pool[i];
+        }
+
+        // count of the next table, bounded by what is left so a damaged count cannot run away
+        uint32_t count()
+        {
+            uint32_t size = number();
+
+            if (size > data.length()) failed = true;
+
+            return failed ? 0 : size;
+        }
+    };
+}
+
+bool nemesis::load_vanilla_snapshot(const sf::path& behaviorFile,
+                                    uint64_t fileHash,
+                                    VanillaNodes& nodes,
+                                    VanillaChildState& childrenState,
+                                    VanillaIDMap& stateID,
+                                    VanillaIDMap& parent)
+{
+    sf::path filename = snapshotPath(behaviorFile);
+
+    if (fileHash == 0 || !isFileExist(filename)) return false;
+
+    nemesis::MappedFile file;
+
+    if (!file.open(filename)) return false;
+
+    SnapshotReader reader(file.view());
+
+    if (reader.raw() != snapshotMagic || reader.number() != snapshotFormat
+        || reader.raw() != GetNemesisVersion() || reader.number64() != fileHash || !reader.readPool())
+    {
+        return false;
+    }
+
+    uint32_t size = reader.count();
+
+    for (uint32_t i = 0; i < size && !reader.failed; ++i)
+    {
+        VecStr& lines  = nodes[string(reader.text())];
+        uint32_t count = reader.count();
+        lines.reserve(count);
+
+        for (uint32_t j = 0; j < count && !reader.failed; ++j)
+        {
+            lines.emplace_back(reader.text());
+        }
+    }
+
+    size = reader.count();
+
+    for (uint32_t i = 0; i < size && !reader.failed; ++i)
+    {
+        auto& states   = childrenState[string(reader.text())];
+        uint32_t count = reader.count();
+
+        for (uint32_t j = 0; j < count && !reader.failed; ++j)
+        {
+            string sid  = string(reader.text());
+            states[sid] = reader.number() != 0;
+        }
+    }
+
+    for (VanillaIDMap* idmap : {&stateID, &parent})
+    {
+        size = reader.count();
+        idmap->reserve(size);
+
+        for (uint32_t i = 0; i < size && !reader.failed; ++i)
+        {
+            string key    = string(reader.text());
+            (*idmap)[key] = string(reader.text());
+        }
+    }
+
+    if (reader.done()) return true;
+
+    nodes.clear();
+    childrenState.clear();
+    stateID.clear();
+    parent.clear();
+    return false;
+}
+
+void nemesis::save_vanilla_snapshot(const sf::path& behaviorFile,
+                                    uint64_t fileHash,
+                                    const VanillaNodes& nodes,
+                                    const VanillaChildState& childrenState,
+                                    const VanillaIDMap& stateID,
+                                    const VanillaIDMap& parent)
+{
+    if (fileHash == 0) return;
+
+    SnapshotWriter writer;
+    writer.put(static_cast<uint32_t>(nodes.size()));
+
+    for (auto& node : nodes)
+    {
+        writer.put(node.first);
+        writer.put(static_cast<uint32_t>(node.second.size()));
+
+        for (auto& line : node.second)
+        {
+            writer.put(line);
+        }
+    }
+
+    writer.put(static_cast<uint32_t>(childrenState.size()));
+
+    for (auto& state : childrenState)
+    {
+        writer.put(state.first);
+        writer.put(static_cast<uint32_t>(state.second.size()));
+
+        for (auto& child : state.second)
+        {
+            writer.put(child.first);
+            writer.put(child.second ? 1u : 0u);
+        }
+    }
+
+    for (const VanillaIDMap* idmap : {&stateID, &parent})
+    {
+        writer.put(static_cast<uint32_t>(idmap->size()));
+
+        for (auto& each : *idmap)
+        {
+            writer.put(each.first);
+            writer.put(each.second);
+        }
+    }
+
+    error_code ec;
+    sf::path filename = snapshotPath(behaviorFile);
+    sf::create_directories(filename.parent_path(), ec);
+
+    // a snapshot that is cut short fails to load and the file is disassembled again
+    ofstream output(filename, ios::binary | ios::trunc);
+
+    if (!output.is_open()) return;
+
+    writer.write(output, fileHash);
+}
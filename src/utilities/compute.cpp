@@ -1,29 +1,311 @@
 #include "Global.h"
 
+#include <algorithm>
+#include <cctype>
 #include <external/exprtk/exprtk.hpp>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "utilities/compute.h"
 
 using namespace std;
 
-namespace nemesis
+namespace
 {
-    bool calculate(string& equation, string format, string filename, int linecount, bool noDecimal)
+    using expression_t   = exprtk::expression<double>;
+    using parser_t       = exprtk::parser<double>;
+    using symbol_table_t = exprtk::symbol_table<double>;
+
+    // upper bound on the shapes, and on the failed equations, a thread keeps. The cache starts over once it is reached
+    constexpr size_t maxCachedShapes = 512;
+
+    // Evaluator for plain arithmetic made of numbers, + - * /, unary sign and parentheses.
+    // Operations are done on double in the same order exprtk does them, so the result is identical
+    class SimpleArithmetic
     {
-        using expression_t = exprtk::expression<double>;
-        using parser_t     = exprtk::parser<double>;
+        const string& text;
+        size_t pos = 0;
+
+        void skipSpace()
+        {
+            while (pos < text.length() && isspace(static_cast<unsigned char>(text[pos])))
+            {
+                ++pos;
+            }
+        }
+
+        bool number(double& value)
+        {
+            skipSpace();
+            size_t start = pos;
+
+            while (pos < text.length() && isdigit(static_cast<unsigned char>(text[pos])))
+            {
+                ++pos;
+            }
+
+            if (pos == start) return false;
+
+            value = 0;
+
+            for (size_t i = start; i < pos; ++i)
+            {
+                value = value * 10 + (text[i] - '0');
+            }
+
+            return true;
+        }
+
+        bool primary(double& value)
+        {
+            skipSpace();
+
+            if (pos >= text.length()) return false;
+
+            char ch = text[pos];
+
+            if (ch == '-' || ch == '+')
+            {
+                ++pos;
+
+                if (!primary(value)) return false;
+
+                if (ch == '-') value = -value;
+
+                return true;
+            }
+
+            if (ch == '(')
+            {
+                ++pos;
+
+                if (!sum(value)) return false;
+
+                skipSpace();
+
+                if (pos >= text.length() || text[pos] != ')') return false;
+
+                ++pos;
+                return true;
+            }
+
+            return number(value);
+        }
+
+        bool product(double& value)
+        {
+            if (!primary(value)) return false;
+
+            while (true)
+            {
+                skipSpace();
+
+                if (pos >= text.length() || (text[pos] != '*' && text[pos] != '/')) return true;
+
+                char op = text[pos++];
+                double rhs;
+
+                if (!primary(rhs)) return false;
+
+                if (op == '*')
+                {
+                    value *= rhs;
+                }
+                else
+                {
+                    if (rhs == 0) return false;
+
+                    value /= rhs;
+                }
+            }
+        }
+
+        bool sum(double& value)
+        {
+            if (!product(value)) return false;
+
+            while (true)
+            {
+                skipSpace();
+
+                if (pos >= text.length() || (text[pos] != '+' && text[pos] != '-')) return true;
+
+                char op = text[pos++];
+                double rhs;
+
+                if (!product(rhs)) return false;
+
+                value = op == '+' ? value + rhs : value - rhs;
+            }
+        }
+
+    public:
+        SimpleArithmetic(const string& _text)
+            : text(_text)
+        {
+        }
 
-        string expression_string = equation;
+        // false when the text is not plain arithmetic, the caller falls back to exprtk
+        bool evaluate(double& value)
+        {
+            if (!sum(value)) return false;
+
+            skipSpace();
+            return pos == text.length();
+        }
+    };
+
+    struct CompiledShape
+    {
+        vector<double> values;
+        symbol_table_t symbols;
         expression_t expression;
+    };
+
+    // Splits equation into its shape, where every number literal is replaced by a variable, and the values
+    // of those literals. Equations that differ only by their numbers share the same compiled expression
+    bool getShape(const string& equation, string& shape, vector<double>& values)
+    {
+        shape.reserve(equation.length());
+
+        for (size_t i = 0; i < equation.length();)
+        {
+            unsigned char ch = equation[i];
+
+            if (isalpha(ch) || ch == '_')
+            {
+                // identifiers such as log10 or atan2 keep their digits
+                size_t start = i;
+
+                while (i < equation.length()
+                       && (isalnum(static_cast<unsigned char>(equation[i])) || equation[i] == '_'))
+                {
+                    ++i;
+                }
+
+                shape.append(equation, start, i - start);
+            }
+            else if (isdigit(ch)
+                     || (ch == '.' && i + 1 < equation.length()
+                         && isdigit(static_cast<unsigned char>(equation[i + 1]))))
+            {
+                size_t start = i;
+
+                while (i < equation.length()
+                       && (isdigit(static_cast<unsigned char>(equation[i])) || equation[i] == '.'))
+                {
+                    ++i;
+                }
+
+                // exponent notation or a number glued to a name is left to an uncached compile
+                if (i < equation.length()
+                    && (isalpha(static_cast<unsigned char>(equation[i])) || equation[i] == '_'))
+                {
+                    return false;
+                }
+
+                char* end;
+                string literal = equation.substr(start, i - start);
+                double value   = strtod(literal.c_str(), &end);
+
+                if (*end != '\0') return false;
+
+                shape.append("nmsv" + to_string(values.size()));
+                values.push_back(value);
+            }
+            else
+            {
+                shape.push_back(static_cast<char>(ch));
+                ++i;
+            }
+        }
+
+        return true;
+    }
+
+    // shapes that failed to compile are kept as null, so they are not compiled again
+    CompiledShape* getCompiledShape(const string& shape, size_t valueCount)
+    {
+        thread_local unordered_map<string, unique_ptr<CompiledShape>> cache;
+
+        auto itr = cache.find(shape);
+
+        if (itr != cache.end()) return itr->second.get();
+
+        if (cache.size() >= maxCachedShapes) cache.clear();
+
+        auto compiled = make_unique<CompiledShape>();
+        compiled->values.resize(valueCount);
+
+        for (size_t i = 0; i < valueCount; ++i)
+        {
+            compiled->symbols.add_variable("nmsv" + to_string(i), compiled->values[i]);
+        }
+
+        compiled->expression.register_symbol_table(compiled->symbols);
         parser_t parser;
 
-        if (!parser.compile(expression_string, expression))
+        if (!parser.compile(shape, compiled->expression)) compiled.reset();
+
+        return (cache[shape] = move(compiled)).get();
+    }
+
+    // equations that exprtk could not compile on this thread
+    unordered_set<string>& getFailedEquations()
+    {
+        thread_local unordered_set<string> failed;
+        return failed;
+    }
+}
+
+namespace nemesis
+{
+    bool calculate(string& equation, string format, string filename, int linecount, bool noDecimal)
+    {
+        double result;
+
+        if (!SimpleArithmetic(equation).evaluate(result))
         {
-            ErrorMessage(1151, std::move(format), std::move(filename), linecount, equation);
+            string shape;
+            vector<double> values;
+            CompiledShape* compiled;
+
+            if (getShape(equation, shape, values) && (compiled = getCompiledShape(shape, values.size())))
+            {
+                // the symbol table holds references to the stored values, they are overwritten in place
+                copy(values.begin(), values.end(), compiled->values.begin());
+                result = compiled->expression.value();
+            }
+            else
+            {
+                auto& failed = getFailedEquations();
+
+                if (failed.find(equation) != failed.end())
+                {
+                    // already reported by the evaluation that failed to compile it
+                    if (error) throw nemesis::exception();
+
+                    ErrorMessage(1151, std::move(format), std::move(filename), linecount, equation);
+                }
+
+                expression_t expression;
+                parser_t parser;
+
+                if (!parser.compile(equation, expression))
+                {
+                    if (failed.size() >= maxCachedShapes) failed.clear();
+
+                    failed.insert(equation);
+                    ErrorMessage(1151, std::move(format), std::move(filename), linecount, equation);
+                }
+
+                result = expression.value();
+            }
         }
 
-        equation = to_string(noDecimal ? static_cast<int>(expression.value()) : expression.value());
+        equation = to_string(noDecimal ? static_cast<int>(result) : result);
         return true;
     }
 } // namespace nemesis
@@ -11,6 +11,16 @@ using namespace std;
 VecStr GetOptionInfo(string line, string format, string filename, int numline);
 VecStr GetOptionInfo(string line, string format, string masterformat, string filename, string multiOption, int numline);
 
+namespace
+{
+    // same as name == format + suffix, without building the string
+    bool isFormatName(const string& name, const string& format, const char* suffix)
+    {
+        return name.length() > format.length() && name.compare(0, format.length(), format) == 0
+               && name.compare(format.length(), string::npos, suffix) == 0;
+    }
+}
+
 void ProcessFunction(proc& process,
                      string change,
                      string line,
@@ -181,16 +191,16 @@ bool nemesis::Condt::isTrue(AnimThreadInfo& animthrinfo,
             size_t groupSize;
             bool g_multi = false;
 
-            if ((*optioncondt)[3] == format + "_group" || (*optioncondt)[3] == format)
+            if (isFormatName((*optioncondt)[3], format, "_group") || (*optioncondt)[3] == format)
             {
                 result = true;
             }
             else
             {
-                if ((*optioncondt)[1].length() == 0)
+                if (groupPick == Pick::All)
                 {
                     if (animthrinfo.groupMulti == -1 || animthrinfo.multiOption != format
-                        || animthrinfo.multiOption == format + "_group")
+                        || isFormatName(animthrinfo.multiOption, format, "_group"))
                     {
                         g_multi    = true;
                         groupMulti = 0;
@@ -203,7 +213,7 @@ bool nemesis::Condt::isTrue(AnimThreadInfo& animthrinfo,
                 }
                 else
                 {
-                    groupMulti = stoi((*optioncondt)[1]);
+                    groupMulti = groupPick == Pick::Number ? groupNum : stoi((*optioncondt)[1]);
                 }
 
                 if (!g_multi)
@@ -218,7 +228,7 @@ bool nemesis::Condt::isTrue(AnimThreadInfo& animthrinfo,
                     size_t animMulti = 0;
                     bool a_multi     = false;
 
-                    if ((*optioncondt)[2].length() == 0)
+                    if (animPick == Pick::All)
                     {
                         if (animthrinfo.animMulti == -1 || animthrinfo.multiOption != format)
                         {
@@ -226,10 +236,8 @@ bool nemesis::Condt::isTrue(AnimThreadInfo& animthrinfo,
 
                             while (animMulti < a_size)
                             {
-                                auto& opt  = mtOptPick[groupMulti][animMulti];
-                                auto pick = opt.find((*optioncondt)[3]);
-
-                                result = isNot ? pick == opt.end() : pick != opt.end();
+                                bool pick = animthrinfo.masterOptionSet(groupMulti, animMulti).test(optionBit);
+                                result    = isNot ? !pick : pick;
 
                                 if (!result) break;
 
@@ -243,20 +251,23 @@ bool nemesis::Condt::isTrue(AnimThreadInfo& animthrinfo,
                             animMulti = animthrinfo.animMulti;
                         }
                     }
-                    else if ((*optioncondt)[2] == "L")
+                    else if (animPick == Pick::Last)
                     {
                         animMulti = mtOptPick[groupMulti].size() - 1;
                     }
-                    else if ((*optioncondt)[2] != "F")
+                    else if (animPick == Pick::Number)
+                    {
+                        animMulti = animNum;
+                    }
+                    else if (animPick != Pick::First)
                     {
                         animMulti = stoi((*optioncondt)[2]);
                     }
 
                     if (!a_multi)
                     {
-                        auto& opt  = mtOptPick[groupMulti][animMulti];
-                        auto pick = opt.find((*optioncondt)[3]);
-                        result     = isNot ? pick == opt.end() : pick != opt.end();
+                        bool pick = animthrinfo.masterOptionSet(groupMulti, animMulti).test(optionBit);
+                        result    = isNot ? !pick : pick;
                     }
 
                     ++groupMulti;
@@ -272,63 +283,59 @@ bool nemesis::Condt::isTrue(AnimThreadInfo& animthrinfo,
             size_t animMulti;
             bool multi = false;
 
-            if ((*optioncondt)[1].length() == 0)
-            {
-                animthrinfo.animMulti == -1 || animthrinfo.multiOption != format
-                    ? multi     = true
-                    : animMulti = animthrinfo.animMulti;
-            }
-            else if ((*optioncondt)[1] == "order")
-            {
-                animthrinfo.animMulti == -1 || animthrinfo.multiOption != format
-                    ? animMulti = animthrinfo.order
-                    : animMulti = animthrinfo.animMulti;
-            }
-            else if ((*optioncondt)[1] == "F")
-            {
-                animMulti = 0;
-            }
-            else if ((*optioncondt)[1] == "N")
-            {
-                animMulti = animthrinfo.order;
-
-                if (!animthrinfo.curAnim->isLast()) ++animMulti;
-            }
-            else if ((*optioncondt)[1] == "B")
-            {
-                animMulti = animthrinfo.order;
-
-                if (animMulti > 0) --animMulti;
-            }
-            else if ((*optioncondt)[1] == "L")
-            {
-                animMulti = animthrinfo.lastorder;
-            }
-            else
+            switch (animPick)
             {
-                animMulti = stoi((*optioncondt)[1]);
+                case Pick::All:
+                    animthrinfo.animMulti == -1 || animthrinfo.multiOption != format
+                        ? multi     = true
+                        : animMulti = animthrinfo.animMulti;
+                    break;
+                case Pick::Order:
+                    animthrinfo.animMulti == -1 || animthrinfo.multiOption != format
+                        ? animMulti = animthrinfo.order
+                        : animMulti = animthrinfo.animMulti;
+                    break;
+                case Pick::First:
+                    animMulti = 0;
+                    break;
+                case Pick::Next:
+                    animMulti = animthrinfo.order;
+
+                    if (!animthrinfo.curAnim->isLast()) ++animMulti;
+
+                    break;
+                case Pick::Back:
+                    animMulti = animthrinfo.order;
+
+                    if (animMulti > 0) --animMulti;
+
+                    break;
+                case Pick::Last:
+                    animMulti = animthrinfo.lastorder;
+                    break;
+                case Pick::Number:
+                    animMulti = animNum;
+                    break;
+                default:
+                    animMulti = stoi((*optioncondt)[1]);
             }
 
-            auto& gpOptPick = animthrinfo.groupOptionPicked;
-
             if (multi)
             {
-                animMulti = gpOptPick.size();
+                animMulti = animthrinfo.groupOptionPicked.size();
 
                 for (size_t i = 0; i < animMulti; ++i)
                 {
-                    auto& opt  = gpOptPick[i];
-                    auto pick = opt.find((*optioncondt)[2]);
-                    result     = isNot ? pick == opt.end() : pick != opt.end();
+                    bool pick = animthrinfo.groupOptionSet(i).test(optionBit);
+                    result    = isNot ? !pick : pick;
 
                     if (!result) break;
                 }
             }
             else
             {
-                auto& opt  = gpOptPick[animMulti];
-                auto pick = opt.find((*optioncondt)[2]);
-                result     = isNot ? pick == opt.end() : pick != opt.end();
+                bool pick = animthrinfo.groupOptionSet(animMulti).test(optionBit);
+                result    = isNot ? !pick : pick;
             }
         }
     }
@@ -471,7 +478,7 @@ bool nemesis::Condt::isMultiTrue(AnimThreadInfo& animinfo,
 			}
 			else
 			{
-				animMulti = stoi((*optioncondt)[1]);
+				animMulti = animPick == Pick::Number ? animNum : stoi((*optioncondt)[1]);
 			}
 
 			if (original == format)
@@ -480,9 +487,7 @@ bool nemesis::Condt::isMultiTrue(AnimThreadInfo& animinfo,
 				return true;
 			}
 
-            auto& opt  = animinfo.groupOptionPicked[animMulti];
-            auto pick = opt.find((*optioncondt)[2]);
-			return pick != opt.end();
+            return animinfo.groupOptionSet(animMulti).test(optionBit);
 		}
 		else
 		{
@@ -878,7 +883,7 @@ void nemesis::Condt::specialCondition(string condition, string format, string be
 	if (error) throw nemesis::exception();
 }
 
-void nemesis::Condt::conditionProcess(string condition, string format, string behaviorFile, string multiOption, int numline, bool isGroup, bool isMaster)
+void nemesis::Condt::conditionProcess(string condition, string format, string behaviorFile, string multiOption, int numline, bool isGroup, bool isMaster, OptionList& optionlist)
 {
 	if (condition[0] == '^' && condition.back() == '^')
 	{
@@ -886,7 +891,7 @@ void nemesis::Condt::conditionProcess(string condition, string format, string be
 
 		if (isalpha(condition[1]))
 		{
-			conditionOrder = nemesis::regex_replace(string(condition), nemesis::regex("\\^([A-Za-z]+)\\^"), string("\\1"));
+			conditionOrder = nemesis::regex_replace(string(condition), nemesis::precompiled(nemesis::pattern::condition_order), string("\\1"));
 
 			if (nemesis::iequals(conditionOrder, "last"))
 			{
@@ -920,11 +925,49 @@ void nemesis::Condt::conditionProcess(string condition, string format, string be
 		optioncondt = isGroup ? (isMaster ? make_shared<VecStr>(GetOptionInfo(condition, format + "_master", format, behaviorFile, multiOption, numline)) :
 			make_shared<VecStr>(GetOptionInfo(condition, format + "_group", format, behaviorFile, multiOption, numline))) :
 			make_shared<VecStr>(GetOptionInfo(condition, format, behaviorFile, numline));
+
+		auto& info = *optioncondt;
+
+		if (isGroup)
+		{
+			if (info.size() > 3)
+			{
+				groupPick = parsePick(info[1], groupNum);
+				animPick  = parsePick(info[2], animNum);
+				optionBit = optionlist.optionIndex->bit(info[3]);
+			}
+		}
+		else if (info.size() > 2)
+		{
+			animPick  = parsePick(info[1], animNum);
+			optionBit = optionlist.optionIndex->bit(info[2]);
+		}
 	}
 
 	if (error) throw nemesis::exception();
 }
 
+nemesis::Condt::Pick nemesis::Condt::parsePick(const string& selector, int& number)
+{
+	if (selector.length() == 0) return Pick::All;
+
+	if (selector == "order") return Pick::Order;
+
+	if (selector == "F") return Pick::First;
+
+	if (selector == "N") return Pick::Next;
+
+	if (selector == "B") return Pick::Back;
+
+	if (selector == "L") return Pick::Last;
+
+	// anything else is left to stoi at evaluation, which reports it as before
+	if (!isOnlyNumber(selector)) return Pick::Other;
+
+	number = stoi(selector);
+	return Pick::Number;
+}
+
 nemesis::MultiChoice::MultiChoice(string cond, string format, string behaviorFile, string multiOption, int numline, bool isGroup, bool isMaster, OptionList& optionlist,
 	size_t posA, size_t posB)
 {
@@ -958,7 +1001,7 @@ void nemesis::Condt::singleCondition(string condition, string format, string beh
 			conditionOrder = conditionOrder.substr(1);
 		}
 
-		conditionProcess(conditionOrder, format, behaviorFile, multiOption, numline, isGroup, isMaster);
+		conditionProcess(conditionOrder, format, behaviorFile, multiOption, numline, isGroup, isMaster, optionlist);
 	}
 }
 
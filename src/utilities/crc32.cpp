@@ -2,26 +2,48 @@
 #include <cstring>
 
 nemesis::CRC32::CRC32(void)
+    : iTable(BuildTable(iPolynomial))
 {
-    memset(&iTable, 0, sizeof(iTable)); 
+}
+
+nemesis::CRC32::~CRC32(void)
+{
+}
+
+const nemesis::CRC32& nemesis::CRC32::instance()
+{
+    static const CRC32 crc32;
+    return crc32;
+}
+
+nemesis::CRC32::Table nemesis::CRC32::BuildTable(uint iPolynomial)
+{
+    Table iTable{};
 
     // 256 values representing ASCII character codes.
     for (int iCodes = 0; iCodes <= 0xFF; iCodes++)
     {
-        iTable[iCodes] = Reflect(iCodes, 8) << 24;
+        iTable[0][iCodes] = Reflect(iCodes, 8) << 24;
 
         for (int iPos = 0; iPos < 8; iPos++)
         {
-            iTable[iCodes]
-                = (iTable[iCodes] << 1) ^ ((iTable[iCodes] & (1 << 31)) ? iPolynomial : 0);
+            iTable[0][iCodes]
+                = (iTable[0][iCodes] << 1) ^ ((iTable[0][iCodes] & (1u << 31)) ? iPolynomial : 0);
         }
 
-        iTable[iCodes] = Reflect(iTable[iCodes], 32);
+        iTable[0][iCodes] = Reflect(iTable[0][iCodes], 32);
     }
-}
 
-nemesis::CRC32::~CRC32(void)
-{
+    for (int iSlice = 1; iSlice < 8; iSlice++)
+    {
+        for (int iCodes = 0; iCodes <= 0xFF; iCodes++)
+        {
+            uint iPrev              = iTable[iSlice - 1][iCodes];
+            iTable[iSlice][iCodes] = (iPrev >> 8) ^ iTable[0][iPrev & 0xFF];
+        }
+    }
+
+    return iTable;
 }
 
 uint nemesis::CRC32::Reflect(uint iReflect, const char cChar)
@@ -39,15 +61,39 @@ uint nemesis::CRC32::Reflect(uint iReflect, const char cChar)
     return iValue;
 }
 
-void nemesis::CRC32::PartialCRC(uint* iCRC, const unsigned char* sData, size_t iDataLength)
+void nemesis::CRC32::PartialCRC(uint* iCRC, const unsigned char* sData, size_t iDataLength) const
 {
+    uint iValue = *iCRC;
+
+    while (iDataLength >= 8)
+    {
+        // bytes are assembled explicitly so the result does not depend on the byte order of the machine
+        uint iLow = iValue
+                    ^ (uint(sData[0]) | (uint(sData[1]) << 8) | (uint(sData[2]) << 16) | (uint(sData[3]) << 24));
+        uint iHigh = uint(sData[4]) | (uint(sData[5]) << 8) | (uint(sData[6]) << 16) | (uint(sData[7]) << 24);
+
+        iValue = iTable[7][iLow & 0xFF] ^ iTable[6][(iLow >> 8) & 0xFF] ^ iTable[5][(iLow >> 16) & 0xFF]
+                 ^ iTable[4][iLow >> 24] ^ iTable[3][iHigh & 0xFF] ^ iTable[2][(iHigh >> 8) & 0xFF]
+                 ^ iTable[1][(iHigh >> 16) & 0xFF] ^ iTable[0][iHigh >> 24];
+
+        sData += 8;
+        iDataLength -= 8;
+    }
+
     while (iDataLength--)
     {
-        *iCRC = (*iCRC >> 8) ^ iTable[(*iCRC & 0xFF) ^ *sData++];
+        iValue = (iValue >> 8) ^ iTable[0][(iValue & 0xFF) ^ *sData++];
     }
+
+    *iCRC = iValue;
+}
+
+void nemesis::CRC32::PartialCRC(uint* iCRC, std::string_view sData) const
+{
+    PartialCRC(iCRC, reinterpret_cast<const unsigned char*>(sData.data()), sData.length());
 }
 
-void nemesis::CRC32::FullCRC(const unsigned char* sData, size_t iDataLength, uint* iOutCRC)
+void nemesis::CRC32::FullCRC(const unsigned char* sData, size_t iDataLength, uint* iOutCRC) const
 {
     *iOutCRC = initial;
 
@@ -56,17 +102,17 @@ void nemesis::CRC32::FullCRC(const unsigned char* sData, size_t iDataLength, uin
     *iOutCRC ^= finalxor;
 }
 
-void nemesis::CRC32::FullCRC(const char* sData, size_t iLength, uint* iOutCRC) 
+void nemesis::CRC32::FullCRC(const char* sData, size_t iLength, uint* iOutCRC) const
 {
     FullCRC((unsigned char*) sData, iLength, iOutCRC);
 }
 
-void nemesis::CRC32::FullCRC(const std::string& sData, uint* iOutCRC) 
+void nemesis::CRC32::FullCRC(std::string_view sData, uint* iOutCRC) const
 {
-    FullCRC((unsigned char*) sData.c_str(), sData.length());
+    FullCRC((unsigned char*) sData.data(), sData.length(), iOutCRC);
 }
 
-uint nemesis::CRC32::FullCRC(const unsigned char* sData, size_t iDataLength)
+uint nemesis::CRC32::FullCRC(const unsigned char* sData, size_t iDataLength) const
 {
     uint iCRC = initial;
 
@@ -75,17 +121,17 @@ uint nemesis::CRC32::FullCRC(const unsigned char* sData, size_t iDataLength)
     return (iCRC ^ finalxor);
 }
 
-uint nemesis::CRC32::FullCRC(const char* sData, size_t iDataLength)
+uint nemesis::CRC32::FullCRC(const char* sData, size_t iDataLength) const
 {
     return FullCRC((unsigned char*) sData, iDataLength);
 }
 
-uint nemesis::CRC32::FullCRC(const std::string& sData)
+uint nemesis::CRC32::FullCRC(std::string_view sData) const
 {
-    return FullCRC((unsigned char*) sData.c_str(), sData.length());
+    return FullCRC((unsigned char*) sData.data(), sData.length());
 }
 
-bool nemesis::CRC32::FileCRC(const char* sFileName, uint* iOutCRC, size_t iBufferSize)
+bool nemesis::CRC32::FileCRC(const char* sFileName, uint* iOutCRC, size_t iBufferSize) const
 {
     *iOutCRC = initial;
 
@@ -117,7 +163,7 @@ bool nemesis::CRC32::FileCRC(const char* sFileName, uint* iOutCRC, size_t iBuffe
     return true;
 }
 
-uint nemesis::CRC32::FileCRC(const char* sFileName)
+uint nemesis::CRC32::FileCRC(const char* sFileName) const
 {
     uint iCRC;
 
@@ -129,7 +175,7 @@ uint nemesis::CRC32::FileCRC(const char* sFileName)
     return 0xffffffff;
 }
 
-uint nemesis::CRC32::FileCRC(const char* sFileName, size_t iBufferSize)
+uint nemesis::CRC32::FileCRC(const char* sFileName, size_t iBufferSize) const
 {
     uint iCRC;
 
@@ -141,7 +187,7 @@ uint nemesis::CRC32::FileCRC(const char* sFileName, size_t iBufferSize)
     return 0xffffffff;
 }
 
-bool nemesis::CRC32::FileCRC(const char* sFileName, uint* iOutCRC)
+bool nemesis::CRC32::FileCRC(const char* sFileName, uint* iOutCRC) const
 {
     return FileCRC(sFileName, iOutCRC, 1048576);
 }
\ No newline at end of file
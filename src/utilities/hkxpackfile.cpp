@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "Global.h"
+
+#include "utilities/hkxpackfile.h"
+#include "utilities/mappedfile.h"
+
+using namespace std;
+namespace sf = filesystem;
+
+namespace
+{
+    constexpr uint32_t magic0 = 0x57e0e057;
+    constexpr uint32_t magic1 = 0x10c0c010;
+
+    constexpr size_t headerSize     = 0x40;
+    constexpr size_t contentsLength = 16;
+
+    struct CachedFacts
+    {
+        uintmax_t size;
+        sf::file_time_type time;
+        shared_ptr<const nemesis::HkxFacts> facts;
+    };
+
+    mutex factsMutex;
+    unordered_map<wstring, CachedFacts> factsCache;
+}
+
+nemesis::HkxPackfile::HkxPackfile(string_view _data)
+    : data(_data)
+{
+    if (!readHeader() || !readObjects() || !readLocalFixups())
+    {
+        facts = HkxFacts();
+        return;
+    }
+
+    readSkeletons();
+}
+
+const nemesis::HkxSkeleton* nemesis::HkxFacts::findSkeleton(string_view name) const
+{
+    for (auto& skeleton : skeletons)
+    {
+        if (skeleton.name == name) return &skeleton;
+    }
+
+    return nullptr;
+}
+
+const nemesis::HkxFacts& nemesis::HkxPackfile::getFacts() const
+{
+    return facts;
+}
+
+bool nemesis::HkxPackfile::readInt(size_t pos, int32_t& value) const
+{
+    if (pos + sizeof(value) > data.length()) return false;
+
+    memcpy(&value, data.data() + pos, sizeof(value));
+    return true;
+}
+
+string_view nemesis::HkxPackfile::readName(size_t pos) const
+{
+    if (pos >= data.length()) return string_view();
+
+    string_view rest = data.substr(pos);
+    return rest.substr(0, min(rest.find('\0'), rest.length()));
+}
+
+string_view nemesis::HkxPackfile::readPointedName(size_t section, uint32_t source) const
+{
+    auto& list = localFixups[section];
+    auto itr   = lower_bound(list.begin(), list.end(), source, [](const Fixup& fixup, uint32_t value) {
+        return fixup.source < value;
+    });
+
+    if (itr == list.end() || itr->source != source) return string_view();
+
+    return readName(size_t(sections[section].start) + itr->target);
+}
+
+bool nemesis::HkxPackfile::readHeader()
+{
+    int32_t first;
+    int32_t second;
+
+    if (!readInt(0, first) || !readInt(4, second) || data.length() < headerSize) return false;
+
+    if (static_cast<uint32_t>(first) != magic0 || static_cast<uint32_t>(second) != magic1) return false;
+
+    int32_t version;
+    readInt(0x0c, version);
+
+    // layout rules: pointer size, little endian, padding reuse, empty base class optimization
+    uint8_t pointerSize = data[0x10];
+
+    if (data[0x11] != 1 || (pointerSize != 4 && pointerSize != 8)) return false;
+
+    facts.packfile    = true;
+    facts.fileVersion = version;
+    facts.pointerSize = pointerSize;
+
+    string_view contents = data.substr(0x28, contentsLength);
+    facts.contentsVersion = string(contents.substr(0, min(contents.find('\0'), contents.length())));
+
+    size_t tableStart = headerSize;
+
+    // hk_2014 files carry a predicate array between the header and the section table
+    if (version >= 11)
+    {
+        int16_t padding;
+        memcpy(&padding, data.data() + 0x3e, sizeof(padding));
+        tableStart += padding;
+    }
+
+    return readSections(tableStart);
+}
+
+bool nemesis::HkxPackfile::readSections(size_t tableStart)
+{
+    int32_t count;
+
+    if (!readInt(0x14, count) || count <= 0 || count > 64) return false;
+
+    size_t entrySize = facts.fileVersion >= 11 ? 0x40 : 0x30;
+
+    for (int32_t i = 0; i < count; ++i)
+    {
+        size_t pos = tableStart + i * entrySize;
+        int32_t field[7];
+
+        for (size_t j = 0; j < 7; ++j)
+        {
+            if (!readInt(pos + 0x14 + j * 4, field[j])) return false;
+        }
+
+        Section section{string(readName(pos).substr(0, 19)),
+                        static_cast<uint32_t>(field[0]),
+                        static_cast<uint32_t>(field[1]),
+                        static_cast<uint32_t>(field[2]),
+                        static_cast<uint32_t>(field[3]),
+                        static_cast<uint32_t>(field[4]),
+                        static_cast<uint32_t>(field[5]),
+                        static_cast<uint32_t>(field[6])};
+
+        if (size_t(section.start) + section.end > data.length() || section.virtualFixups > section.exports
+            || section.exports > section.end)
+        {
+            return false;
+        }
+
+        sections.push_back(move(section));
+    }
+
+    return true;
+}
+
+bool nemesis::HkxPackfile::readObjects()
+{
+    objects.resize(sections.size());
+
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        const Section& section = sections[i];
+        auto& list             = objects[i];
+
+        // each virtual fixup is the offset of an object and the location of its class name
+        for (size_t pos = section.start + section.virtualFixups; pos + 12 <= section.start + section.exports;
+             pos += 12)
+        {
+            int32_t offset;
+            int32_t nameSection;
+            int32_t nameOffset;
+            readInt(pos, offset);
+            readInt(pos + 4, nameSection);
+            readInt(pos + 8, nameOffset);
+
+            // padding at the end of the fixup table
+            if (offset == -1) continue;
+
+            if (nameSection < 0 || size_t(nameSection) >= sections.size() || nameOffset < 0) return false;
+
+            list.push_back(Object{static_cast<uint32_t>(offset),
+                                  readName(size_t(sections[nameSection].start) + nameOffset)});
+        }
+
+        sort(list.begin(), list.end(), [](const Object& lhs, const Object& rhs) {
+            return lhs.offset < rhs.offset;
+        });
+    }
+
+    int32_t contentsSection;
+    int32_t contentsOffset;
+    readInt(0x18, contentsSection);
+    readInt(0x1c, contentsOffset);
+
+    if (contentsSection < 0 || size_t(contentsSection) >= sections.size()) return false;
+
+    for (auto& object : objects[contentsSection])
+    {
+        if (object.offset == static_cast<uint32_t>(contentsOffset))
+        {
+            facts.rootClass = string(object.classname);
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool nemesis::HkxPackfile::readLocalFixups()
+{
+    localFixups.resize(sections.size());
+
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        const Section& section = sections[i];
+        auto& list             = localFixups[i];
+
+        if (section.localFixups > section.globalFixups) return false;
+
+        // each local fixup is the location of a pointer and the data it points to, both in this section
+        for (size_t pos = section.start + section.localFixups; pos + 8 <= section.start + section.globalFixups;
+             pos += 8)
+        {
+            int32_t source;
+            int32_t target;
+            readInt(pos, source);
+            readInt(pos + 4, target);
+
+            // padding at the end of the fixup table
+            if (source == -1) continue;
+
+            if (source < 0 || target < 0) return false;
+
+            list.push_back(Fixup{static_cast<uint32_t>(source), static_cast<uint32_t>(target)});
+        }
+
+        sort(list.begin(), list.end(), [](const Fixup& lhs, const Fixup& rhs) {
+            return lhs.source < rhs.source;
+        });
+    }
+
+    return true;
+}
+
+void nemesis::HkxPackfile::readSkeletons()
+{
+    // hkReferencedObject is a vtable pointer followed by two 16 bit fields, padded to pointer alignment.
+    // hkaSkeleton then starts with its name and the parentIndices array, whose size follows the pointer
+    size_t nameOffset = facts.pointerSize == 8 ? 16 : 8;
+    size_t sizeOffset = nameOffset + 2 * facts.pointerSize;
+
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        for (auto& object : objects[i])
+        {
+            int32_t bones;
+
+            if (object.classname != "hkaSkeleton") continue;
+
+            if (readInt(size_t(sections[i].start) + object.offset + sizeOffset, bones) && bones >= 0)
+            {
+                string name(readPointedName(i, object.offset + static_cast<uint32_t>(nameOffset)));
+                facts.skeletons.push_back(HkxSkeleton{move(name), bones});
+            }
+        }
+    }
+}
+
+shared_ptr<const nemesis::HkxFacts> nemesis::hkx_facts(const sf::path& hkxfile)
+{
+    error_code ec;
+    uintmax_t size          = sf::file_size(hkxfile, ec);
+    sf::file_time_type time = ec ? sf::file_time_type() : sf::last_write_time(hkxfile, ec);
+
+    if (ec) return make_shared<const HkxFacts>();
+
+    wstring key = nemesis::to_lower_copy(hkxfile.lexically_normal().wstring());
+
+    {
+        lock_guard<mutex> lock(factsMutex);
+        auto itr = factsCache.find(key);
+
+        if (itr != factsCache.end() && itr->second.size == size && itr->second.time == time)
+        {
+            return itr->second.facts;
+        }
+    }
+
+    MappedFile file(hkxfile);
+    auto facts = make_shared<const HkxFacts>(HkxPackfile(file.view()).getFacts());
+
+    lock_guard<mutex> lock(factsMutex);
+    factsCache[key] = CachedFacts{size, time, facts};
+    return facts;
+}
+
+void nemesis::clear_hkx_facts()
+{
+    lock_guard<mutex> lock(factsMutex);
+    factsCache.clear();
+}
@@ -0,0 +1,135 @@
+#include <cstring>
+
+#include "utilities/linearena.h"
+
+using namespace std;
+
+char* nemesis::LineArena::allocate(size_t length)
+{
+    used += length;
+
+    // oversized lines get a block of their own so the current one keeps its space
+    if (length > blockSize / 4)
+    {
+        large.push_back(unique_ptr<char[]>(new char[length]));
+        return large.back().get();
+    }
+
+    if (length > left)
+    {
+        blocks.push_back(unique_ptr<char[]>(new char[blockSize]));
+        cur  = blocks.back().get();
+        left = blockSize;
+    }
+
+    char* data = cur;
+    cur += length;
+    left -= length;
+    return data;
+}
+
+string_view nemesis::LineArena::store(string_view line)
+{
+    if (line.empty()) return string_view();
+
+    char* data = allocate(line.length());
+    memcpy(data, line.data(), line.length());
+    return string_view(data, line.length());
+}
+
+string_view nemesis::LineArena::concat(initializer_list<string_view> pieces)
+{
+    size_t length = 0;
+
+    for (auto& piece : pieces)
+    {
+        length += piece.length();
+    }
+
+    if (length == 0) return string_view();
+
+    char* data = allocate(length);
+    char* pos  = data;
+
+    for (auto& piece : pieces)
+    {
+        memcpy(pos, piece.data(), piece.length());
+        pos += piece.length();
+    }
+
+    return string_view(data, length);
+}
+
+size_t nemesis::LineArena::bytes() const
+{
+    return used;
+}
+
+size_t nemesis::LineArena::blockCount() const
+{
+    return blocks.size() + large.size();
+}
+
+void nemesis::LineArena::clear()
+{
+    blocks.clear();
+    large.clear();
+    cur  = nullptr;
+    left = 0;
+    used = 0;
+}
+
+nemesis::ArenaLines::ArenaLines(LineArena& _arena)
+    : arena(_arena)
+{
+}
+
+void nemesis::ArenaLines::push_back(string_view line)
+{
+    lines.push_back(arena.store(line));
+}
+
+void nemesis::ArenaLines::push_back(initializer_list<string_view> pieces)
+{
+    lines.push_back(arena.concat(pieces));
+}
+
+void nemesis::ArenaLines::append(const ArenaLines& other)
+{
+    lines.insert(lines.end(), other.lines.begin(), other.lines.end());
+}
+
+void nemesis::ArenaLines::reserve(size_t count)
+{
+    lines.reserve(count);
+}
+
+void nemesis::ArenaLines::clear()
+{
+    lines.clear();
+}
+
+string_view nemesis::ArenaLines::back() const
+{
+    return lines.back();
+}
+
+size_t nemesis::ArenaLines::size() const
+{
+    return lines.size();
+}
+
+bool nemesis::ArenaLines::empty() const
+{
+    return lines.empty();
+}
+
+nemesis::ArenaLines::const_iterator nemesis::ArenaLines::begin() const
+{
+    return lines.begin();
+}
+
+nemesis::ArenaLines::const_iterator nemesis::ArenaLines::end() const
+{
+    return lines.end();
+}
@@ -0,0 +1,240 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "utilities/mappedfile.h"
+
+using namespace std;
+
+nemesis::MappedFile::MappedFile(const filesystem::path& filepath)
+{
+    open(filepath);
+}
+
+nemesis::MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool nemesis::MappedFile::open(const filesystem::path& filepath)
+{
+    close();
+    opened = map(filepath) || read(filepath);
+    return opened;
+}
+
+#ifdef _WIN32
+
+bool nemesis::MappedFile::map(const filesystem::path& filepath)
+{
+    HANDLE file = CreateFileW(filepath.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // empty files cannot be mapped, an empty view is all there is to read
+    if (size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle    = file;
+    mappingHandle = mapping;
+    data          = static_cast<const char*>(view);
+    length        = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void nemesis::MappedFile::close()
+{
+    if (mappingHandle)
+    {
+        UnmapViewOfFile(data);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle    = nullptr;
+    }
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+    data   = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+bool nemesis::MappedFile::map(const filesystem::path& filepath)
+{
+    int file = ::open(filepath.c_str(), O_RDONLY);
+
+    if (file < 0) return false;
+
+    struct stat info;
+
+    if (fstat(file, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        ::close(file);
+        return false;
+    }
+
+    // empty files cannot be mapped, an empty view is all there is to read
+    if (info.st_size == 0)
+    {
+        ::close(file);
+        return true;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+
+    if (view == MAP_FAILED) return false;
+
+    madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    mapped = true;
+    data   = static_cast<const char*>(view);
+    length = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void nemesis::MappedFile::close()
+{
+    if (mapped)
+    {
+        munmap(const_cast<char*>(data), length);
+        mapped = false;
+    }
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+    data   = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
+
+bool nemesis::MappedFile::read(const filesystem::path& filepath)
+{
+    ifstream file(filepath, ios::binary);
+
+    if (!file.is_open()) return false;
+
+    buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+
+    if (file.bad()) return false;
+
+    data   = buffer.data();
+    length = buffer.length();
+    return true;
+}
+
+bool nemesis::MappedFile::is_open() const
+{
+    return opened;
+}
+
+string_view nemesis::MappedFile::view() const
+{
+    return string_view(data, length);
+}
+
+size_t nemesis::line_count(string_view buffer)
+{
+    if (buffer.empty()) return 0;
+
+    const char* cur = buffer.data();
+    const char* end = cur + buffer.length();
+    size_t count    = 0;
+
+    // eight bytes at a time: a byte equal to '\n' becomes zero after the xor, every zero byte leaves its
+    // high bit set in the mask and the multiplication adds the eight bits up in the top byte
+    constexpr uint64_t ones = 0x0101010101010101ull;
+    constexpr uint64_t high = 0x8080808080808080ull;
+    constexpr uint64_t low  = 0x7F7F7F7F7F7F7F7Full;
+
+    for (; end - cur >= 8; cur += 8)
+    {
+        uint64_t word;
+        memcpy(&word, cur, 8);
+        word ^= ones * '\n';
+        uint64_t zero = ~(((word & low) + low) | word | low) & high;
+        count += static_cast<size_t>(((zero >> 7) * ones) >> 56);
+    }
+
+    for (; cur < end; ++cur)
+    {
+        if (*cur == '\n') ++count;
+    }
+
+    // last line without line feed
+    if (buffer.back() != '\n') ++count;
+
+    return count;
+}
+
+bool nemesis::next_line(string_view& buffer, string_view& line)
+{
+    if (buffer.empty()) return false;
+
+    size_t pos = buffer.find('\n');
+
+    if (pos == string_view::npos)
+    {
+        line   = buffer;
+        buffer = string_view();
+    }
+    else
+    {
+        line = buffer.substr(0, pos);
+        buffer.remove_prefix(pos + 1);
+    }
+
+    while (line.length() > 0 && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+
+    return true;
+}
@@ -1,3 +1,5 @@
+#include <array>
+
 #include "debugmsg.h"
 
 #include "utilities/regex.h"
@@ -182,6 +184,59 @@ namespace nemesis
         return &currentVal_.value();
     }
 
+    const regex& precompiled(pattern name)
+    {
+        static const std::array<regex, static_cast<size_t>(pattern::count)> registry = {
+#define NEMESIS_PATTERN_REGEX(name, str) regex(str),
+            NEMESIS_PRECOMPILED_PATTERNS(NEMESIS_PATTERN_REGEX)
+#undef NEMESIS_PATTERN_REGEX
+        };
+
+        return registry[static_cast<size_t>(name)];
+    }
+
+    std::string first_number(const std::string& line)
+    {
+        size_t begin = line.find_first_of("0123456789");
+
+        if (begin == std::string::npos) return line;
+
+        size_t end = line.find_first_not_of("0123456789", begin);
+        return line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+    }
+
+    bool number_between(const std::string& line,
+                        std::string_view prefix,
+                        std::string_view suffix,
+                        std::string& number)
+    {
+        std::string_view view(line);
+        size_t pos = view.rfind(prefix);
+
+        while (pos != std::string_view::npos)
+        {
+            size_t begin = pos + prefix.length();
+            size_t end   = begin;
+
+            while (end < view.length() && view[end] >= '0' && view[end] <= '9')
+            {
+                ++end;
+            }
+
+            if (end > begin && view.substr(end, suffix.length()) == suffix)
+            {
+                number = line.substr(begin, end - begin);
+                return true;
+            }
+
+            if (pos == 0) break;
+
+            pos = view.rfind(prefix, pos - 1);
+        }
+
+        return false;
+    }
+
     
     // =====================================================//
     //                    WIDE CHARACTERS                   //
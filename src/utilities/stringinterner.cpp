@@ -0,0 +1,237 @@
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "utilities/algorithm.h"
+#include "utilities/stringinterner.h"
+
+using namespace std;
+
+namespace
+{
+    struct Entry
+    {
+        string text;
+        wstring wtext;
+    };
+
+    // entries and aliases are never removed, so the views in the indexes stay valid
+    shared_mutex internMutex;
+    deque<Entry> entries;
+    deque<string> narrowAlias; // folded spellings that do not convert back to the text of their entry
+    deque<wstring> wideAlias;
+    unordered_map<string_view, uint32_t> narrowIndex;
+    unordered_map<wstring_view, uint32_t> wideIndex;
+
+    template <class Char>
+    const basic_string<Char>& foldBuffer(basic_string_view<Char> name)
+    {
+        // reused by every lookup of the thread, so a hit does not allocate
+        thread_local basic_string<Char> buffer;
+        buffer.assign(name.data(), name.length());
+        nemesis::to_lower(buffer);
+        return buffer;
+    }
+
+    // internMutex must be held exclusively
+    uint32_t addEntry(const string& text, const wstring& wtext)
+    {
+        entries.push_back(Entry{text, wtext});
+        uint32_t id = uint32_t(entries.size() - 1);
+        narrowIndex.emplace(entries.back().text, id);
+        wideIndex.emplace(entries.back().wtext, id);
+        return id;
+    }
+}
+
+uint32_t nemesis::interner::intern(string_view name)
+{
+    const string& folded = foldBuffer(name);
+
+    {
+        shared_lock<shared_mutex> lock(internMutex);
+        auto itr = narrowIndex.find(folded);
+
+        if (itr != narrowIndex.end()) return itr->second;
+    }
+
+    wstring wide = nemesis::transform_to<wstring>(folded);
+    unique_lock<shared_mutex> lock(internMutex);
+
+    // another thread may have added it in between
+    auto itr = narrowIndex.find(folded);
+
+    if (itr != narrowIndex.end()) return itr->second;
+
+    auto witr = wideIndex.find(wide);
+
+    if (witr == wideIndex.end()) return addEntry(folded, wide);
+
+    narrowAlias.push_back(folded);
+    narrowIndex.emplace(narrowAlias.back(), witr->second);
+    return witr->second;
+}
+
+uint32_t nemesis::interner::intern(wstring_view name)
+{
+    const wstring& folded = foldBuffer(name);
+
+    {
+        shared_lock<shared_mutex> lock(internMutex);
+        auto itr = wideIndex.find(folded);
+
+        if (itr != wideIndex.end()) return itr->second;
+    }
+
+    string narrow = nemesis::transform_to<string>(folded);
+    unique_lock<shared_mutex> lock(internMutex);
+    auto itr = wideIndex.find(folded);
+
+    if (itr != wideIndex.end()) return itr->second;
+
+    auto nitr = narrowIndex.find(narrow);
+
+    if (nitr == narrowIndex.end()) return addEntry(narrow, folded);
+
+    wideAlias.push_back(folded);
+    wideIndex.emplace(wideAlias.back(), nitr->second);
+    return nitr->second;
+}
+
+bool nemesis::interner::find(string_view name, uint32_t& id)
+{
+    const string& folded = foldBuffer(name);
+    shared_lock<shared_mutex> lock(internMutex);
+    auto itr = narrowIndex.find(folded);
+
+    if (itr == narrowIndex.end())
+    {
+        // the name may only have been interned in its wide spelling
+        auto witr = wideIndex.find(nemesis::transform_to<wstring>(folded));
+
+        if (witr == wideIndex.end()) return false;
+
+        id = witr->second;
+        return true;
+    }
+
+    id = itr->second;
+    return true;
+}
+
+bool nemesis::interner::find(wstring_view name, uint32_t& id)
+{
+    const wstring& folded = foldBuffer(name);
+    shared_lock<shared_mutex> lock(internMutex);
+    auto itr = wideIndex.find(folded);
+
+    if (itr == wideIndex.end())
+    {
+        auto nitr = narrowIndex.find(nemesis::transform_to<string>(folded));
+
+        if (nitr == narrowIndex.end()) return false;
+
+        id = nitr->second;
+        return true;
+    }
+
+    id = itr->second;
+    return true;
+}
+
+const string& nemesis::interner::name(uint32_t id)
+{
+    shared_lock<shared_mutex> lock(internMutex);
+    return entries[id].text;
+}
+
+const wstring& nemesis::interner::wname(uint32_t id)
+{
+    shared_lock<shared_mutex> lock(internMutex);
+    return entries[id].wtext;
+}
+
+size_t nemesis::interner::size()
+{
+    shared_lock<shared_mutex> lock(internMutex);
+    return entries.size();
+}
+
+nemesis::InternedKey::InternedKey(const char* name)
+    : id(interner::intern(string_view(name)))
+{
+}
+
+nemesis::InternedKey::InternedKey(const wchar_t* name)
+    : id(interner::intern(wstring_view(name)))
+{
+}
+
+nemesis::InternedKey::InternedKey(const string& name)
+    : id(interner::intern(string_view(name)))
+{
+}
+
+nemesis::InternedKey::InternedKey(const wstring& name)
+    : id(interner::intern(wstring_view(name)))
+{
+}
+
+nemesis::InternedKey::InternedKey(string_view name)
+    : id(interner::intern(name))
+{
+}
+
+nemesis::InternedKey::InternedKey(wstring_view name)
+    : id(interner::intern(name))
+{
+}
+
+optional<nemesis::InternedKey> nemesis::InternedKey::lookup(string_view name)
+{
+    InternedKey key;
+
+    if (!interner::find(name, key.id)) return nullopt;
+
+    return key;
+}
+
+optional<nemesis::InternedKey> nemesis::InternedKey::lookup(wstring_view name)
+{
+    InternedKey key;
+
+    if (!interner::find(name, key.id)) return nullopt;
+
+    return key;
+}
+
+uint32_t nemesis::InternedKey::getID() const
+{
+    return id;
+}
+
+const string& nemesis::InternedKey::str() const
+{
+    return interner::name(id);
+}
+
+const wstring& nemesis::InternedKey::wstr() const
+{
+    return interner::wname(id);
+}
+
+bool nemesis::InternedKey::operator==(const InternedKey& other) const
+{
+    return id == other.id;
+}
+
+bool nemesis::InternedKey::operator!=(const InternedKey& other) const
+{
+    return id != other.id;
+}
+
+bool nemesis::InternedKey::operator<(const InternedKey& other) const
+{
+    return id != other.id && str() < other.str();
+}
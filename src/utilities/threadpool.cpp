@@ -1,21 +1,44 @@
+#include <algorithm>
+#include <cstdint>
+
 #include "utilities/threadpool.h"
 
 using namespace std;
 
-nemesis::ThreadPool::ThreadPool(uint threads)
+namespace
+{
+    // index of the worker queue owned by the current thread, the shared queue for any other thread
+    thread_local size_t workerIndex = SIZE_MAX;
+}
+
+nemesis::TaskScheduler::TaskScheduler(uint threads)
 {
+    if (threads == 0) threads = 1;
+
+    workerCount = threads;
+    queues.reserve(threads + 1);
+
+    for (uint i = 0; i <= threads; ++i)
+    {
+        queues.emplace_back(make_unique<WorkQueue>());
+    }
+
     workers.reserve(threads);
 
-    for (unsigned int i = 0; i < threads; ++i)
+    for (uint i = 0; i < threads; ++i)
     {
-        newWorker();
+        workers.emplace_back(&TaskScheduler::workerLoop, this, i);
     }
 }
 
-void nemesis::ThreadPool::join_all()
+nemesis::TaskScheduler::~TaskScheduler()
 {
-    sync = true;
-    condition.notify_all();
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
 
     for (auto& worker : workers)
     {
@@ -23,42 +46,184 @@ void nemesis::ThreadPool::join_all()
     }
 }
 
-void nemesis::ThreadPool::stop() 
+nemesis::TaskScheduler& nemesis::TaskScheduler::get()
+{
+    static TaskScheduler scheduler(thread::hardware_concurrency());
+    return scheduler;
+}
+
+size_t nemesis::TaskScheduler::size() const
+{
+    return workerCount;
+}
+
+void nemesis::TaskScheduler::spawn(TaskGroup& group, Task task)
+{
+    ++group.pending;
+
+    WorkQueue& queue = *queues[workerIndex < workerCount ? workerIndex : workerCount];
+
+    {
+        // counted under the queue lock, so a thread that takes the job right away cannot count it down first
+        // the group is not touched past this point, its owner may be done with it once the job has run
+        lock_guard<mutex> lock(queue.lock);
+        queue.jobs.push_back(Job{move(task), &group});
+        ++group.queued;
+        ++queued;
+    }
+
+    {
+        // pairs with the predicate check of a sleeping thread so the wake up cannot be missed
+        lock_guard<mutex> lock(sleepMutex);
+    }
+
+    wake.notify_one();
+
+    // a waiter of the group may be the only thread left to run it
+    done.notify_all();
+}
+
+void nemesis::TaskScheduler::wait_for(TaskGroup& group)
 {
+    while (group.pending > 0)
     {
-        lock_guard lock{queue_mutex};
-        abort = true;
+        if (runOne(workerIndex, &group)) continue;
+
+        // the rest of the group is running on other threads
+        unique_lock<mutex> lock(sleepMutex);
+        done.wait(lock, [&] { return group.pending == 0 || group.queued > 0; });
     }
 
-    condition.notify_all();
+    exception_ptr failure;
+
+    {
+        lock_guard<mutex> lock(group.failureMutex);
+        swap(failure, group.failure);
+    }
+
+    if (failure) rethrow_exception(failure);
 }
 
-nemesis::ThreadPool::~ThreadPool()
+bool nemesis::TaskScheduler::take(size_t index, bool back, const TaskGroup* only, Job& job)
 {
-    stop();
+    WorkQueue& queue = *queues[index];
+    lock_guard<mutex> lock(queue.lock);
+
+    if (queue.jobs.empty()) return false;
+
+    auto itr = back ? prev(queue.jobs.end()) : queue.jobs.begin();
+
+    if (only)
+    {
+        if (back)
+        {
+            auto ritr = find_if(queue.jobs.rbegin(), queue.jobs.rend(), [&](const Job& each) {
+                return each.group == only;
+            });
+
+            if (ritr == queue.jobs.rend()) return false;
+
+            itr = prev(ritr.base());
+        }
+        else
+        {
+            itr = find_if(queue.jobs.begin(), queue.jobs.end(), [&](const Job& each) {
+                return each.group == only;
+            });
+
+            if (itr == queue.jobs.end()) return false;
+        }
+    }
 
-    if (!sync) join_all();
+    job = move(*itr);
+    queue.jobs.erase(itr);
+    --job.group->queued;
+    --queued;
+    return true;
 }
 
-void nemesis::ThreadPool::newWorker()
+bool nemesis::TaskScheduler::runOne(size_t self, const TaskGroup* only)
 {
-    workers.emplace_back([&] {
-        for (;;)
+    Job job;
+    size_t count = queues.size();
+
+    // newest own task first, it is the most likely to still be in cache
+    if (self < workerCount && take(self, true, only, job))
+    {
+        execute(job);
+        return true;
+    }
+
+    // then the oldest task of everyone else, starting next to our own queue to spread the stealing
+    size_t start = self < workerCount ? self + 1 : 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t index = (start + i) % count;
+
+        if (index != self && take(index, false, only, job))
         {
-            function<void()> task;
+            execute(job);
+            return true;
+        }
+    }
+
+    return false;
+}
 
-            {
-                unique_lock<mutex> lock(queue_mutex);
-                condition.wait(lock, [&] { return error || abort || sync || !tasks.empty(); });
+void nemesis::TaskScheduler::execute(Job& job)
+{
+    try
+    {
+        job.task();
+    }
+    catch (...)
+    {
+        lock_guard<mutex> lock(job.group->failureMutex);
 
-                if (error || abort || tasks.empty()) return;
+        if (!job.group->failure) job.group->failure = current_exception();
+    }
 
-                task = tasks.front();
-                tasks.pop();
-            }
+    job.task.reset();
 
-            task();
+    if (--job.group->pending == 0)
+    {
+        {
+            lock_guard<mutex> lock(sleepMutex);
         }
-    });
+
+        done.notify_all();
+    }
 }
 
+void nemesis::TaskScheduler::workerLoop(size_t index)
+{
+    workerIndex = index;
+
+    while (true)
+    {
+        if (runOne(index, nullptr)) continue;
+
+        unique_lock<mutex> lock(sleepMutex);
+        wake.wait(lock, [&] { return stopping || queued > 0; });
+
+        if (stopping) return;
+    }
+}
+
+nemesis::TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (...)
+    {
+        // failure is only reported to an explicit wait
+    }
+}
+
+void nemesis::TaskGroup::wait()
+{
+    TaskScheduler::get().wait_for(*this);
+}
@@ -1,3 +1,4 @@
+#include "utilities/crc32.h"
 #include "utilities/algorithm.h"
 #include "utilities/writetextfile.h"
 
@@ -35,6 +36,15 @@ bool FileWriter::is_open() const
     return file;
 }
 
+void FileWriter::close()
+{
+    if (!file) return;
+
+    fflush(file);
+    fclose(file);
+    file = nullptr;
+}
+
 void FileWriter::LockFreeWrite(const char* line)
 {
     fwprintf(file, L"%S", nemesis::transform_to<wstring>(string(line)).c_str());
@@ -84,3 +94,44 @@ FileWriter& FileWriter::operator<<(const wstring& input)
     fwprintf(file, L"%S", input.c_str());
     return *this;
 }
+
+CRCWriter::CRCWriter(FileWriter& _writer, size_t _capacity)
+    : writer(_writer)
+    , capacity(_capacity)
+{
+    buffer.reserve(capacity);
+}
+
+CRCWriter::~CRCWriter()
+{
+    Flush();
+}
+
+CRCWriter& CRCWriter::operator<<(string_view input)
+{
+    Checksum(input);
+
+    if (buffer.length() + input.length() > capacity) Flush();
+
+    buffer.append(input);
+    return *this;
+}
+
+void CRCWriter::Checksum(string_view input)
+{
+    // initial value and final xor are both 0, the CRC of a concatenation can be continued piece by piece
+    nemesis::CRC32::instance().PartialCRC(&crc, input);
+}
+
+void CRCWriter::Flush()
+{
+    if (buffer.length() == 0) return;
+
+    writer << buffer;
+    buffer.clear();
+}
+
+unsigned int CRCWriter::GetCRC() const
+{
+    return crc;
+}